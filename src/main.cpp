@@ -4,11 +4,11 @@
 #include <atomic>
 #include <csignal>
 #include <memory>
-#include "memory_scanner.h"
 #include "http_server.h"
+#include "mcp_stdio_server.h"
 #include "types.h"
 #include "nlohmann/json.hpp"
-#include <fmt/base.h>
+#include <fmt/format.h>
 
 using json = nlohmann::json;
 using namespace MemoryMCP;
@@ -20,197 +20,8 @@ void signal_handler(int /*signal*/) {
 }
 
 void run_mcp_mode() {
-    auto scanner = std::make_unique<MemoryScanner>();
-    std::string line;
-
-    while (g_running && std::getline(std::cin, line)) {
-        try {
-            // Skip empty lines/blank messages
-            if (line.find_first_not_of(" \t\r\n") == std::string::npos) {
-                continue;
-            }
-
-            json request = json::parse(line);
-            
-            // Check, if it nofity (without id)
-            if (!request.contains("id") || request["id"].is_null()) {
-                // Notification - skip
-                continue;
-            }
-            
-            json response;
-            response["jsonrpc"] = "2.0";
-            response["id"] = request["id"];
-
-            if (request.contains("method")) {
-                std::string method = request["method"];
-
-                // MCP: 'initialized' is a notification normally (no id). If it ever comes with id, return empty result.
-                if (method == "initialized") {
-                    response["result"] = json::object();
-                } else
-                if (method == "initialize") {
-                    json capabilities;
-                    capabilities["tools"] = {{"listChanged", false}};
-
-                    json serverInfo;
-                    serverInfo["name"] = "memory-mcp-server";
-                    serverInfo["version"] = "1.0.0";
-
-                    response["result"] = {
-                        {"protocolVersion", "2024-11-05"},
-                        {"capabilities", capabilities},
-                        {"serverInfo", serverInfo}
-                    };
-
-                } else if (method == "tools/list") {
-                    response["result"] = {
-                        {"tools", json::array({
-                            {
-                                {"name", "scan_memory"},
-                                {"description", "Scans process memory for specified value"},
-                                {"inputSchema", {
-                                    {"type", "object"},
-                                    {"properties", {
-                                        {"process_name", {{"type", "string"}, {"description", "Process name"}}},
-                                        {"value", {{"type", "string"}, {"description", "Search value"}}},
-                                        {"value_type", {{"type", "string"}, {"description", "Data type"}}}
-                                    }},
-                                    {"required", json::array({"process_name", "value", "value_type"})}
-                                }}
-                            },
-                            {
-                                {"name", "get_addresses"},
-                                {"description", "Gets found memory addresses"},
-                                {"inputSchema", {
-                                    {"type", "object"},
-                                    {"properties", {
-                                        {"max_count", {{"type", "integer"}, {"description", "Maximum number of addresses"}}}
-                                    }}
-                                }}
-                            },
-                            {
-                                {"name", "filter_addresses"},
-                                {"description", "Filters addresses by new value"},
-                                {"inputSchema", {
-                                    {"type", "object"},
-                                    {"properties", {
-                                        {"addresses", {{"type", "array"}, {"description", "Address list"}}},
-                                        {"new_value", {{"type", "string"}, {"description", "New value"}}},
-                                        {"value_type", {{"type", "string"}, {"description", "Data type"}}}
-                                    }},
-                                    {"required", json::array({"addresses", "new_value", "value_type"})}
-                                }}
-                            },
-                            {
-                                {"name", "reset_memory_scanner"},
-                                {"description", "Resets all search data"},
-                                {"inputSchema", {
-                                    {"type", "object"},
-                                    {"properties", json::object()}
-                                }}
-                            }
-                        })}
-                    };
-
-                } else if (method == "tools/call") {
-                    json params = request["params"];
-                    std::string name = params["name"];
-                    json arguments = params["arguments"];
-
-                    if (name == "scan_memory") {
-                        std::string process_name = arguments["process_name"];
-                        std::string value = arguments["value"];
-                        std::string type_str = arguments["value_type"];
-
-                        ValueType value_type = string_to_value_type(type_str);
-                        ScanResponse scan_response = scanner->scan_memory(process_name, value, value_type);
-
-                        response["result"] = {
-                            {"content", json::array({
-                                {
-                                    {"type", "text"},
-                                    {"text", "Scan completed. Found " + std::to_string(scan_response.count) + " addresses."}
-                                }
-                            })},
-                            {"isError", !scan_response.success}
-                        };
-
-                    } else if (name == "get_addresses") {
-                        size_t max_count = arguments.value("max_count", 100);
-                        AddressesResponse addr_response = scanner->get_addresses(max_count);
-
-                        std::string addresses_text = "Found addresses:\n";
-                        for (const auto& addr : addr_response.addresses) {
-                            addresses_text += addr + "\n";
-                        }
-
-                        response["result"] = {
-                            {"content", json::array({
-                                {
-                                    {"type", "text"},
-                                    {"text", addresses_text}
-                                }
-                            })},
-                            {"isError", !addr_response.success}
-                        };
-
-                    } else if (name == "filter_addresses") {
-                        std::vector<std::string> addresses = arguments["addresses"];
-                        std::string new_value = arguments["new_value"];
-                        std::string type_str = arguments["value_type"];
-
-                        ValueType value_type = string_to_value_type(type_str);
-                        FilterResponse filter_response = scanner->filter_addresses(addresses, new_value, value_type);
-
-                        response["result"] = {
-                            {"content", json::array({
-                                {
-                                    {"type", "text"},
-                                    {"text", "Filtering completed. Remaining: " + std::to_string(filter_response.count) + " addresses."}
-                                }
-                            })},
-                            {"isError", !filter_response.success}
-                        };
-
-                    } else if (name == "reset_memory_scanner") {
-                        ResetResponse reset_response = scanner->reset();
-
-                        response["result"] = {
-                            {"content", json::array({
-                                {
-                                    {"type", "text"},
-                                    {"text", reset_response.message}
-                                }
-                            })},
-                            {"isError", !reset_response.success}
-                        };
-                    } else {
-                        response["error"] = {
-                            {"code", -32601},
-                            {"message", "Unknown tool: " + name}
-                        };
-                    }
-                } else {
-                    response["error"] = {
-                        {"code", -32601},
-                        {"message", "Unknown method: " + method}
-                    };
-                }
-            } else {
-                response["error"] = {
-                    {"code", -32600},
-                    {"message", "Invalid Request"}
-                };
-            }
-
-            fmt::print("{}\n", response.dump());
-
-        } catch (const std::exception& e) {
-            // Don't print anything to stdout, to not break MCP indicator
-            fmt::print(stderr, "[ERROR] MCP parse error: {}\n", e.what());
-        }
-    }
+    McpStdioServer server(std::cin, std::cout);
+    server.run(g_running);
 }
 
 int main(int argc, char* argv[]) {
@@ -0,0 +1,93 @@
+#include "candidate_reader.h"
+#include <algorithm>
+
+namespace MemoryMCP {
+
+CandidateReader::CandidateReader(MemorySource& source, size_t value_width, size_t max_width)
+    : source_(source), value_width_(value_width), read_width_((std::max)(value_width, max_width)) {
+}
+
+size_t CandidateReader::read(const ResultSet& candidates, const Visitor& visit) {
+    runs_.clear();
+    run_count_ = 0;
+    batch_count_ = 0;
+
+    size_t readable = 0;
+    size_t batch_bytes = 0;
+
+    candidates.for_each([&](size_t index, uint64_t address, const uint8_t*) {
+        // A gap of up to one page is cheaper to read than a separate iovec.
+        if (!runs_.empty()) {
+            Run& run = runs_.back();
+            uint64_t run_end = run.address + run.size;
+            uint64_t end = address + read_width_;
+            if (address <= run_end + CANDIDATE_RUN_GAP && end - run.address <= CANDIDATE_RUN_SIZE) {
+                batch_bytes += end - run_end;
+                run.size = end - run.address;
+                run.count++;
+                return;
+            }
+        }
+
+        if (batch_bytes + read_width_ > SCAN_CHUNK_SIZE) {
+            readable += flush(candidates, visit);
+            batch_bytes = 0;
+        }
+        runs_.push_back({address, read_width_, index, 1});
+        batch_bytes += read_width_;
+    });
+
+    readable += flush(candidates, visit);
+    return readable;
+}
+
+size_t CandidateReader::flush(const ResultSet& candidates, const Visitor& visit) {
+    if (runs_.empty()) {
+        return 0;
+    }
+
+    size_t total = 0;
+    for (const Run& run : runs_) {
+        total += run.size;
+    }
+    buffer_.resize((std::max)(buffer_.size(), total));
+
+    reads_.clear();
+    size_t offset = 0;
+    for (const Run& run : runs_) {
+        reads_.push_back({static_cast<uintptr_t>(run.address), buffer_.data() + offset, run.size, 0});
+        offset += run.size;
+    }
+    source_.read_batch(reads_);
+    batch_count_++;
+    run_count_ += runs_.size();
+
+    size_t readable = 0;
+    std::vector<uint8_t> single(read_width_);
+    for (size_t r = 0; r < runs_.size(); ++r) {
+        const Run& run = runs_[r];
+        const ReadRequest& request = reads_[r];
+        const uint8_t* data = static_cast<const uint8_t*>(request.buffer);
+
+        candidates.for_each(run.first, run.first + run.count, [&](size_t index, uint64_t address, const uint8_t*) {
+            size_t offset = static_cast<size_t>(address - run.address);
+            size_t length = request.bytes_read > offset ? (std::min)(request.bytes_read - offset, read_width_) : 0;
+            const uint8_t* value = nullptr;
+            if (length >= value_width_) {
+                value = data + offset;
+            } else if (request.bytes_read < request.size) {
+                // The run crossed a page that is gone now; later candidates may still be readable.
+                length = source_.read(static_cast<uintptr_t>(address), single.data(), read_width_);
+                value = length >= value_width_ ? single.data() : nullptr;
+            }
+
+            readable += value != nullptr;
+            visit(index, address, value, value != nullptr ? length : 0);
+        });
+    }
+
+    runs_.clear();
+    return readable;
+}
+
+} // namespace MemoryMCP
@@ -0,0 +1,50 @@
+#pragma once
+#include "memory_source.h"
+#include "result_set.h"
+#include <functional>
+#include <vector>
+
+namespace MemoryMCP {
+
+// Re-reads the current bytes behind a set of candidate addresses. Candidates
+// that lie close together are coalesced into one run and runs are read with
+// read_batch, so a million candidates cost a few thousand batched reads
+// instead of one read per value.
+class CandidateReader {
+public:
+    // value is null when the candidate could not be read; otherwise length
+    // bytes are readable at it, from value_width up to max_width.
+    using Visitor = std::function<void(size_t index, uint64_t address, const uint8_t* value, size_t length)>;
+
+    // Candidates are read max_width bytes wide (value_width when 0) and
+    // count as readable once value_width of those bytes are.
+    CandidateReader(MemorySource& source, size_t value_width, size_t max_width = 0);
+
+    // Visits every candidate in address order; returns how many were readable.
+    size_t read(const ResultSet& candidates, const Visitor& visit);
+
+    size_t run_count() const { return run_count_; }
+    size_t batch_count() const { return batch_count_; }
+
+private:
+    // Candidates [first, first + count) read as one span starting at address.
+    struct Run {
+        uint64_t address;
+        size_t size;
+        size_t first;
+        size_t count;
+    };
+
+    size_t flush(const ResultSet& candidates, const Visitor& visit);
+
+    MemorySource& source_;
+    size_t value_width_;
+    size_t read_width_;
+    std::vector<Run> runs_;
+    std::vector<ReadRequest> reads_;
+    std::vector<uint8_t> buffer_;
+    size_t run_count_ = 0;
+    size_t batch_count_ = 0;
+};
+
+} // namespace MemoryMCP
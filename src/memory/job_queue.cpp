@@ -0,0 +1,167 @@
+#include "job_queue.h"
+#include <algorithm>
+#include <fmt/base.h>
+
+namespace MemoryMCP {
+
+JobQueue::JobQueue() {
+    thread_ = std::thread(&JobQueue::run, this);
+}
+
+JobQueue::~JobQueue() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        for (auto& entry : jobs_) {
+            entry.second->progress.cancelled = true;
+        }
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+std::string JobQueue::submit(const std::string& kind, const ScanOptions& options, Work work) {
+    auto job = std::make_shared<Job>();
+    job->kind = kind;
+    job->options = options;
+    job->options.progress = &job->progress;
+    job->work = std::move(work);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job->id = std::to_string(next_id_++);
+        jobs_[job->id] = job;
+        queue_.push_back(job);
+    }
+    cv_.notify_one();
+
+    fmt::print(stderr, "[INFO] Job {} ({}) queued\n", job->id, kind);
+    return job->id;
+}
+
+bool JobQueue::status(const std::string& id, JobStatus& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = jobs_.find(id);
+    if (it == jobs_.end()) {
+        return false;
+    }
+    out = describe(*it->second);
+    out.result = it->second->result;
+    return true;
+}
+
+bool JobQueue::cancel(const std::string& id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = jobs_.find(id);
+    if (it == jobs_.end()) {
+        return false;
+    }
+
+    Job& job = *it->second;
+    if (job.state == JobState::QUEUED) {
+        queue_.erase(std::find(queue_.begin(), queue_.end(), it->second));
+        job.state = JobState::CANCELLED;
+        job.started = job.finished = Clock::now();
+        job.message = "Job cancelled before it started";
+        finish(job);
+    } else if (job.state == JobState::RUNNING) {
+        // The engine sees the flag at its next chunk; run() records the outcome.
+        job.progress.cancelled = true;
+    }
+    return true;
+}
+
+std::vector<JobStatus> JobQueue::list() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<JobStatus> statuses;
+    statuses.reserve(jobs_.size());
+    for (const auto& entry : jobs_) {
+        statuses.push_back(describe(*entry.second));
+    }
+    // Ids are decimal counters; order them numerically.
+    std::sort(statuses.begin(), statuses.end(), [](const JobStatus& a, const JobStatus& b) {
+        return a.id.size() != b.id.size() ? a.id.size() < b.id.size() : a.id < b.id;
+    });
+    return statuses;
+}
+
+void JobQueue::run() {
+    while (true) {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (stopping_) {
+                return;
+            }
+            job = queue_.front();
+            queue_.pop_front();
+            job->state = JobState::RUNNING;
+            job->started = Clock::now();
+        }
+
+        json result;
+        std::string error;
+        try {
+            result = job->work(job->options);
+        } catch (const std::exception& e) {
+            error = e.what();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        job->finished = Clock::now();
+        job->result = std::move(result);
+        if (!error.empty()) {
+            job->state = JobState::FAILED;
+            job->message = "Job failed: " + error;
+        } else if (job->progress.cancelled) {
+            job->state = JobState::CANCELLED;
+            job->message = "Job cancelled";
+        } else {
+            job->success = job->result.is_object() && job->result.value("success", false);
+            job->state = job->success ? JobState::COMPLETED : JobState::FAILED;
+            job->message = job->result.is_object() ? job->result.value("message", std::string()) : std::string();
+        }
+        finish(*job);
+    }
+}
+
+void JobQueue::finish(Job& job) {
+    fmt::print(stderr, "[INFO] Job {} ({}) {}\n", job.id, job.kind, job_state_to_string(job.state));
+    job.work = nullptr;
+
+    finished_.push_back(job.id);
+    while (finished_.size() > MAX_FINISHED_JOBS) {
+        jobs_.erase(finished_.front());
+        finished_.pop_front();
+    }
+}
+
+JobStatus JobQueue::describe(const Job& job) const {
+    JobStatus status;
+    status.id = job.id;
+    status.kind = job.kind;
+    status.state = job.state;
+    status.bytes_scanned = job.progress.bytes_scanned;
+    status.bytes_total = job.progress.bytes_total;
+    status.regions_done = job.progress.regions_done;
+    status.regions_total = job.progress.regions_total;
+    status.hits = job.progress.hits;
+    status.message = job.message;
+    status.success = job.success;
+
+    if (job.state == JobState::RUNNING) {
+        status.elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - job.started).count();
+        if (status.bytes_scanned > 0 && status.bytes_total > status.bytes_scanned) {
+            status.eta_ms = status.elapsed_ms * static_cast<double>(status.bytes_total - status.bytes_scanned) /
+                            static_cast<double>(status.bytes_scanned);
+        }
+    } else if (job.state != JobState::QUEUED) {
+        status.elapsed_ms = std::chrono::duration<double, std::milli>(job.finished - job.started).count();
+    }
+    return status;
+}
+
+} // namespace MemoryMCP
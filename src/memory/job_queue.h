@@ -0,0 +1,76 @@
+#pragma once
+#include "types.h"
+#include "scan_engine.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace MemoryMCP {
+
+// Runs scans as jobs on one background thread, so a request can return a job
+// id right away instead of holding its connection for the whole scan. The
+// scans themselves still fan out over the scan engine's pool; queued jobs wait
+// their turn. Every job gets its own ScanProgress, which status() turns into
+// live counters and an ETA, and which cancel() flags so the engine stops at
+// the next chunk. Finished jobs are kept until MAX_FINISHED_JOBS newer ones
+// have finished.
+class JobQueue {
+public:
+    // Runs the scan with options (progress attached) and returns its response.
+    using Work = std::function<json(const ScanOptions& options)>;
+
+    JobQueue();
+    // Cancels the running and queued jobs and waits for the running one.
+    ~JobQueue();
+
+    JobQueue(const JobQueue&) = delete;
+    JobQueue& operator=(const JobQueue&) = delete;
+
+    std::string submit(const std::string& kind, const ScanOptions& options, Work work);
+
+    // False if there is no job with that id.
+    bool status(const std::string& id, JobStatus& out) const;
+    bool cancel(const std::string& id);
+    std::vector<JobStatus> list() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Job {
+        std::string id;
+        std::string kind;
+        JobState state = JobState::QUEUED;
+        ScanOptions options;
+        Work work;
+        ScanProgress progress;
+        Clock::time_point started;
+        Clock::time_point finished;
+        json result;
+        std::string message;
+        bool success = false;
+    };
+
+    void run();
+    void finish(Job& job);
+    JobStatus describe(const Job& job) const;
+
+    static constexpr size_t MAX_FINISHED_JOBS = 64;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::map<std::string, std::shared_ptr<Job>> jobs_;
+    std::deque<std::shared_ptr<Job>> queue_;
+    std::deque<std::string> finished_;
+    uint64_t next_id_ = 1;
+    bool stopping_ = false;
+    std::thread thread_;
+};
+
+} // namespace MemoryMCP
@@ -0,0 +1,385 @@
+#ifdef __linux__
+#include "linux_memory_source.h"
+#include <sys/uio.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <cerrno>
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <fmt/base.h>
+
+namespace MemoryMCP {
+
+// Kernel limit for the comm field (TASK_COMM_LEN - 1).
+static constexpr size_t COMM_MAX_LENGTH = 15;
+
+// Fields of /proc/<pid>/stat between the state (field 3) and starttime (field 22).
+static constexpr int STAT_FIELDS_BEFORE_START_TIME = 18;
+
+LinuxMemorySource::LinuxMemorySource() : pid_(0), proc_fd_(-1), start_time_(0), iov_max_(IOV_MAX) {
+    long iov_max = sysconf(_SC_IOV_MAX);
+    if (iov_max > 0) {
+        iov_max_ = static_cast<size_t>(iov_max);
+    }
+}
+
+LinuxMemorySource::~LinuxMemorySource() {
+    close();
+}
+
+std::string LinuxMemorySource::read_comm(pid_t pid) {
+    std::ifstream comm("/proc/" + std::to_string(pid) + "/comm");
+    std::string name;
+    std::getline(comm, name);
+    return name;
+}
+
+std::string LinuxMemorySource::read_exe_name(pid_t pid) {
+    char path[PATH_MAX];
+    std::string link = "/proc/" + std::to_string(pid) + "/exe";
+    ssize_t length = readlink(link.c_str(), path, sizeof(path) - 1);
+    if (length <= 0) {
+        return {};
+    }
+    path[length] = '\0';
+
+    std::string exe(path);
+    size_t slash = exe.find_last_of('/');
+    return slash == std::string::npos ? exe : exe.substr(slash + 1);
+}
+
+bool LinuxMemorySource::read_start_time(int proc_fd, uint64_t& start_time) {
+    int fd = openat(proc_fd, "stat", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    char buffer[1024];
+    ssize_t length = ::read(fd, buffer, sizeof(buffer) - 1);
+    ::close(fd);
+    if (length <= 0) {
+        return false;
+    }
+    buffer[length] = '\0';
+
+    // comm may hold spaces and parentheses, so fields are counted from its closing one.
+    char* field = std::strrchr(buffer, ')');
+    if (field == nullptr || field[1] != ' ') {
+        return false;
+    }
+    char state = field[2];
+    if (state == 'Z' || state == 'X') {
+        return false;
+    }
+
+    field += 3;
+    for (int i = 0; i < STAT_FIELDS_BEFORE_START_TIME; ++i) {
+        field = std::strchr(field + 1, ' ');
+        if (field == nullptr) {
+            return false;
+        }
+    }
+    char* end = nullptr;
+    start_time = std::strtoull(field + 1, &end, 10);
+    return end != field + 1;
+}
+
+DWORD LinuxMemorySource::find_process_by_name(const std::string& process_name) {
+    DIR* proc = opendir("/proc");
+    if (proc == nullptr) {
+        fmt::print(stderr, "[ERROR] Failed to open /proc\n");
+        return 0;
+    }
+
+    DWORD found = 0;
+    while (dirent* entry = readdir(proc)) {
+        char* end = nullptr;
+        long pid = std::strtol(entry->d_name, &end, 10);
+        if (pid <= 0 || *end != '\0') {
+            continue;
+        }
+
+        if (!process_matches(static_cast<DWORD>(pid), process_name)) {
+            continue;
+        }
+
+        found = static_cast<DWORD>(pid);
+        fmt::print(stderr, "[SUCCESS] Process found: {} (PID: {})\n", process_name, found);
+        break;
+    }
+
+    closedir(proc);
+
+    if (found == 0) {
+        fmt::print(stderr, "[ERROR] Process not found: {}\n", process_name);
+    }
+    return found;
+}
+
+bool LinuxMemorySource::process_matches(DWORD process_id, const std::string& process_name) {
+    // comm is truncated by the kernel, so longer names are confirmed against /proc/<pid>/exe
+    bool truncated = process_name.length() > COMM_MAX_LENGTH;
+    pid_t pid = static_cast<pid_t>(process_id);
+
+    if (read_comm(pid) != (truncated ? process_name.substr(0, COMM_MAX_LENGTH) : process_name)) {
+        return false;
+    }
+    return !truncated || read_exe_name(pid) == process_name;
+}
+
+bool LinuxMemorySource::update_process_index(std::map<DWORD, std::string>& index) {
+    DIR* proc = opendir("/proc");
+    if (proc == nullptr) {
+        fmt::print(stderr, "[ERROR] Failed to open /proc\n");
+        return false;
+    }
+
+    std::map<DWORD, std::string> running;
+    while (dirent* entry = readdir(proc)) {
+        char* end = nullptr;
+        long pid = std::strtol(entry->d_name, &end, 10);
+        if (pid <= 0 || *end != '\0') {
+            continue;
+        }
+
+        DWORD process_id = static_cast<DWORD>(pid);
+        auto known = index.find(process_id);
+        if (known != index.end()) {
+            running.emplace(process_id, std::move(known->second));
+            continue;
+        }
+
+        std::string name = read_comm(static_cast<pid_t>(pid));
+        if (name.empty()) {
+            continue;  // exited meanwhile
+        }
+        // A comm at the length limit may be cut short; prefer the executable name it starts.
+        if (name.length() == COMM_MAX_LENGTH) {
+            std::string exe = read_exe_name(static_cast<pid_t>(pid));
+            if (exe.length() > COMM_MAX_LENGTH && exe.compare(0, COMM_MAX_LENGTH, name) == 0) {
+                name = exe;
+            }
+        }
+        running.emplace(process_id, std::move(name));
+    }
+
+    closedir(proc);
+    index.swap(running);
+    return true;
+}
+
+bool LinuxMemorySource::open(DWORD process_id) {
+    close();
+
+    std::string path = "/proc/" + std::to_string(process_id);
+    int fd = ::open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    uint64_t start_time = 0;
+    if (fd < 0 || faccessat(fd, "maps", R_OK, 0) != 0 || !read_start_time(fd, start_time)) {
+        int error = errno;
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        fmt::print(stderr, "[ERROR] Failed to open process PID {}\n", process_id);
+        fmt::print(stderr, "[INFO] Error code: {}\n", error);
+        return false;
+    }
+
+    pid_ = static_cast<pid_t>(process_id);
+    proc_fd_ = fd;
+    start_time_ = start_time;
+    return true;
+}
+
+void LinuxMemorySource::close() {
+    if (proc_fd_ >= 0) {
+        ::close(proc_fd_);
+        proc_fd_ = -1;
+    }
+    pid_ = 0;
+    start_time_ = 0;
+    maps_.clear();
+}
+
+bool LinuxMemorySource::is_alive() const {
+    uint64_t start_time = 0;
+    return proc_fd_ >= 0 && read_start_time(proc_fd_, start_time) && start_time == start_time_;
+}
+
+bool LinuxMemorySource::read_maps(std::string& text) const {
+    int fd = openat(proc_fd_, "maps", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    text.clear();
+    char buffer[65536];
+    ssize_t length = 0;
+    while ((length = ::read(fd, buffer, sizeof(buffer))) > 0) {
+        text.append(buffer, static_cast<size_t>(length));
+    }
+    ::close(fd);
+    return length == 0;
+}
+
+std::vector<MemoryRegion> LinuxMemorySource::parse_maps(const std::string& text) {
+    std::vector<MemoryRegion> regions;
+    // Files mapped executable anywhere are loaded images; their data sections count too.
+    std::set<std::string> images;
+    std::vector<std::string> paths;
+
+    size_t begin = 0;
+    while (begin < text.size()) {
+        size_t end = text.find('\n', begin);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        std::string line = text.substr(begin, end - begin);
+        begin = end + 1;
+
+        unsigned long long start = 0;
+        unsigned long long stop = 0;
+        unsigned long long inode = 0;
+        char perms[5] = {};
+        int path_offset = 0;
+
+        if (std::sscanf(line.c_str(), "%llx-%llx %4s %*s %*s %llu %n", &start, &stop, perms, &inode, &path_offset) != 4 ||
+            stop <= start) {
+            continue;
+        }
+
+        MemoryRegion region;
+        region.base = static_cast<uintptr_t>(start);
+        region.size = static_cast<size_t>(stop - start);
+        region.protection = PROTECTION_NONE;
+        if (perms[0] == 'r') region.protection |= PROTECTION_READ;
+        if (perms[1] == 'w') region.protection |= PROTECTION_WRITE;
+        if (perms[2] == 'x') region.protection |= PROTECTION_EXECUTE;
+
+        // Pseudo paths such as [heap] and [stack] are anonymous memory.
+        std::string path = path_offset > 0 ? line.substr(static_cast<size_t>(path_offset)) : std::string();
+        if (inode != 0 && !path.empty() && path[0] == '/') {
+            size_t slash = path.find_last_of('/');
+            region.type = RegionType::MAPPED;
+            region.module = path.substr(slash + 1);
+            if (region.protection & PROTECTION_EXECUTE) {
+                images.insert(path);
+            }
+        } else {
+            path.clear();
+        }
+
+        regions.push_back(std::move(region));
+        paths.push_back(std::move(path));
+    }
+
+    for (size_t i = 0; i < regions.size(); ++i) {
+        if (!paths[i].empty() && images.count(paths[i])) {
+            regions[i].type = RegionType::IMAGE;
+        }
+    }
+    return regions;
+}
+
+std::vector<MemoryRegion> LinuxMemorySource::enumerate_regions() {
+    std::string text;
+    if (!is_open() || !read_maps(text)) {
+        return {};
+    }
+    return parse_maps(text);
+}
+
+bool LinuxMemorySource::update_regions(std::vector<MemoryRegion>& regions) {
+    std::string text;
+    if (!is_open() || !read_maps(text)) {
+        maps_.clear();
+        bool changed = !regions.empty();
+        regions.clear();
+        return changed;
+    }
+
+    // An unchanged maps file means an unchanged layout; skip parsing it.
+    if (text == maps_) {
+        return false;
+    }
+    std::vector<MemoryRegion> current = parse_maps(text);
+    maps_.swap(text);
+    if (current == regions) {
+        return false;
+    }
+    regions.swap(current);
+    return true;
+}
+
+size_t LinuxMemorySource::read(uintptr_t address, void* buffer, size_t size) {
+    if (!is_open() || size == 0) {
+        return 0;
+    }
+
+    iovec local{buffer, size};
+    iovec remote{reinterpret_cast<void*>(address), size};
+
+    ssize_t result = process_vm_readv(pid_, &local, 1, &remote, 1, 0);
+    return result > 0 ? static_cast<size_t>(result) : 0;
+}
+
+size_t LinuxMemorySource::read_batch(std::vector<ReadRequest>& requests) {
+    for (auto& request : requests) {
+        request.bytes_read = 0;
+    }
+
+    if (!is_open()) {
+        return 0;
+    }
+
+    std::vector<iovec> local(iov_max_);
+    std::vector<iovec> remote(iov_max_);
+    size_t total = 0;
+    size_t next = 0;
+
+    while (next < requests.size()) {
+        size_t count = (std::min)(requests.size() - next, iov_max_);
+        for (size_t i = 0; i < count; ++i) {
+            const ReadRequest& request = requests[next + i];
+            local[i] = {request.buffer, request.size};
+            remote[i] = {reinterpret_cast<void*>(request.address), request.size};
+        }
+
+        ssize_t result = process_vm_readv(pid_, local.data(), count, remote.data(), count, 0);
+        if (result < 0) {
+            if (errno == EPERM || errno == ESRCH) {
+                fmt::print(stderr, "[ERROR] process_vm_readv failed for PID {}: {}\n", pid_, errno);
+                break;
+            }
+            // The first element is unreadable; skip it and retry the rest.
+            ++next;
+            continue;
+        }
+
+        // The kernel stops at the first remote element it cannot read, so
+        // hand out the transferred bytes in order and resume after that element.
+        size_t remaining = static_cast<size_t>(result);
+        total += remaining;
+
+        size_t consumed = 0;
+        while (consumed < count) {
+            ReadRequest& request = requests[next + consumed];
+            request.bytes_read = (std::min)(remaining, request.size);
+            remaining -= request.bytes_read;
+            ++consumed;
+            if (request.bytes_read < request.size) {
+                break;
+            }
+        }
+
+        next += consumed;
+    }
+
+    return total;
+}
+
+} // namespace MemoryMCP
+#endif
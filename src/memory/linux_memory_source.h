@@ -0,0 +1,51 @@
+#pragma once
+#ifdef __linux__
+#include "memory_source.h"
+#include <sys/types.h>
+
+namespace MemoryMCP {
+
+// Reads process memory through process_vm_readv and discovers regions and
+// processes through procfs. An open source holds a descriptor on the
+// process's /proc directory and remembers its start time, so is_alive()
+// notices when the process is gone even if the PID has been reused. Reads
+// go by PID and would then reach the new process; callers check is_alive().
+class LinuxMemorySource : public MemorySource {
+public:
+    LinuxMemorySource();
+    ~LinuxMemorySource() override;
+
+    const char* name() const override { return "linux"; }
+
+    DWORD find_process_by_name(const std::string& process_name) override;
+    bool open(DWORD process_id) override;
+    void close() override;
+    bool is_open() const override { return pid_ > 0; }
+    DWORD process_id() const override { return static_cast<DWORD>(pid_); }
+    bool is_alive() const override;
+
+    bool update_process_index(std::map<DWORD, std::string>& index) override;
+    bool process_matches(DWORD process_id, const std::string& process_name) override;
+
+    std::vector<MemoryRegion> enumerate_regions() override;
+    bool update_regions(std::vector<MemoryRegion>& regions) override;
+    size_t read(uintptr_t address, void* buffer, size_t size) override;
+    size_t read_batch(std::vector<ReadRequest>& requests) override;
+
+private:
+    std::string read_comm(pid_t pid);
+    std::string read_exe_name(pid_t pid);
+    // Start time in clock ticks since boot; false if the process is gone or a zombie.
+    static bool read_start_time(int proc_fd, uint64_t& start_time);
+    bool read_maps(std::string& text) const;
+    static std::vector<MemoryRegion> parse_maps(const std::string& text);
+
+    pid_t pid_;
+    int proc_fd_;
+    uint64_t start_time_;
+    std::string maps_;  // maps as of the last update_regions()
+    size_t iov_max_;
+};
+
+} // namespace MemoryMCP
+#endif
@@ -0,0 +1,149 @@
+#include "mapped_file.h"
+#include <atomic>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#include <winioctl.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace MemoryMCP {
+
+static std::string temporary_path() {
+    static std::atomic<unsigned> counter{0};
+#ifdef _WIN32
+    unsigned long pid = GetCurrentProcessId();
+#else
+    unsigned long pid = static_cast<unsigned long>(getpid());
+#endif
+    std::string name = "memory-mcp-snapshot-" + std::to_string(pid) + "-" + std::to_string(counter++) + ".bin";
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+#ifdef _WIN32
+        file_ = std::exchange(other.file_, INVALID_HANDLE_VALUE);
+        mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+    }
+    return *this;
+}
+
+#ifdef _WIN32
+
+MappedFile MappedFile::create_temporary(size_t size) {
+    MappedFile file;
+    std::string path = temporary_path();
+
+    file.file_ = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                             FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+    if (file.file_ == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Failed to create snapshot file " + path);
+    }
+
+    // Sparse, so regions that are never written do not take disk space.
+    DWORD returned = 0;
+    DeviceIoControl(file.file_, FSCTL_SET_SPARSE, nullptr, 0, nullptr, 0, &returned, nullptr);
+
+    if (size == 0) {
+        return file;
+    }
+
+    ULARGE_INTEGER length;
+    length.QuadPart = size;
+    file.mapping_ = CreateFileMappingA(file.file_, nullptr, PAGE_READWRITE, length.HighPart, length.LowPart, nullptr);
+    if (file.mapping_ == nullptr) {
+        throw std::runtime_error("Failed to map snapshot file (error " + std::to_string(GetLastError()) + ")");
+    }
+
+    file.data_ = static_cast<uint8_t*>(MapViewOfFile(file.mapping_, FILE_MAP_ALL_ACCESS, 0, 0, size));
+    if (file.data_ == nullptr) {
+        throw std::runtime_error("Failed to map snapshot view (error " + std::to_string(GetLastError()) + ")");
+    }
+    file.size_ = size;
+    return file;
+}
+
+void MappedFile::unmap() {
+    if (data_ != nullptr) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_ != nullptr) {
+        CloseHandle(mapping_);
+    }
+    if (file_ != INVALID_HANDLE_VALUE) {
+        CloseHandle(file_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    mapping_ = nullptr;
+    file_ = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+MappedFile MappedFile::create_temporary(size_t size) {
+    MappedFile file;
+    std::string path = temporary_path();
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to create snapshot file " + path + ": " + std::strerror(errno));
+    }
+    // The mapping keeps the data alive; nothing is left behind if the server dies.
+    ::unlink(path.c_str());
+
+    if (size == 0) {
+        ::close(fd);
+        return file;
+    }
+
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        int error = errno;
+        ::close(fd);
+        throw std::runtime_error("Failed to size snapshot file: " + std::string(std::strerror(error)));
+    }
+
+    void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    int error = errno;
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        throw std::runtime_error("Failed to map snapshot file: " + std::string(std::strerror(error)));
+    }
+
+    file.data_ = static_cast<uint8_t*>(data);
+    file.size_ = size;
+    return file;
+}
+
+void MappedFile::unmap() {
+    if (data_ != nullptr) {
+        ::munmap(data_, size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+}
+
+#endif
+
+} // namespace MemoryMCP
@@ -0,0 +1,41 @@
+#pragma once
+#include "types.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace MemoryMCP {
+
+// Anonymous temporary file mapped read/write. The file is deleted as soon as
+// the mapping goes away (on Linux it is unlinked right after creation), so the
+// data lives in the page cache and on disk rather than in the server heap, and
+// the kernel can page it in and out as a scan walks over it.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Creates a zero-filled (sparse where supported) file of size bytes.
+    // Throws std::runtime_error when the file cannot be created or mapped.
+    static MappedFile create_temporary(size_t size);
+
+    uint8_t* data() { return data_; }
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    void unmap();
+
+    uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#endif
+};
+
+} // namespace MemoryMCP
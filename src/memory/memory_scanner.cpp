@@ -1,28 +1,61 @@
 #include "memory_scanner.h"
-#include <psapi.h>
-#include <tlhelp32.h>
+#include "candidate_reader.h"
+#include "pattern_kernel.h"
+#include "process_cache.h"
+#include "scan_engine.h"
+#include "scan_kernel.h"
+#include "snapshot_store.h"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
 #include <fmt/base.h>
 
-#pragma comment(lib, "psapi.lib")
-
 using namespace MemoryMCP;
 
-MemoryScanner::MemoryScanner() {
+namespace {
+
+// Cursors read "<generation>:<offset>"; the generation ties them to one result set.
+std::string make_cursor(uint64_t generation, size_t offset) {
+    return std::to_string(generation) + ":" + std::to_string(offset);
+}
+
+bool parse_cursor(const std::string& cursor, uint64_t& generation, size_t& offset) {
+    size_t colon = cursor.find(':');
+    if (colon == 0 || colon == std::string::npos || colon + 1 == cursor.size() ||
+        cursor.find_first_not_of("0123456789:") != std::string::npos || cursor.find(':', colon + 1) != std::string::npos) {
+        return false;
+    }
+    try {
+        generation = std::stoull(cursor.substr(0, colon));
+        offset = static_cast<size_t>(std::stoull(cursor.substr(colon + 1)));
+    } catch (const std::out_of_range&) {
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+MemoryScanner::MemoryScanner() : state_(std::make_shared<State>()) {
     fmt::print(stderr, "[INFO] Memory Scanner initialized\n");
+    fmt::print(stderr, "[INFO] Scan kernels: {}\n", simd::isa_name(simd::active_kernels().level));
 }
 
 MemoryScanner::~MemoryScanner() {
     fmt::print(stderr, "[INFO] Memory Scanner shutting down\n");
 }
 
-ScanResponse MemoryScanner::scan_memory(const std::string& process_name, const std::string& value, ValueType value_type) {
+ScanResponse MemoryScanner::scan_memory(const std::string& process_name, const std::string& value, ValueType value_type,
+                                        const ScanOptions& options, const ScanCondition& condition) {
     fmt::print(stderr, "[INFO] Starting memory scan...\n");
     fmt::print(stderr, "[INFO] Process: {}\n", process_name);
-    fmt::print(stderr, "[INFO] Searching for: {} (type: {})\n", value, value_type_to_string(value_type));
+    fmt::print(stderr, "[INFO] Searching for: {} {}{} (type: {})\n", scan_predicate_to_string(condition.predicate), value,
+               condition.predicate == ScanPredicate::BETWEEN ? " " + condition.upper : std::string(),
+               value_type_to_string(value_type));
 
     
     ScanResponse response;
@@ -30,59 +63,222 @@ ScanResponse MemoryScanner::scan_memory(const std::string& process_name, const s
     response.count = 0;
     
     try {
-        DWORD process_id = find_process_by_name(process_name);
-        if (process_id == 0) {
-            response.message = "Process not found: " + process_name;
-            fmt::print(stderr, "[ERROR] {}\n", response.message);
+        CompiledKernel kernel = compile_kernel(value, value_type, condition);
+        
+        DWORD process_id = 0;
+        std::shared_ptr<MemorySource> source = open_process(process_name, process_id, response.message);
+        if (!source) {
             return response;
         }
         
-        fmt::print(stderr, "[SUCCESS] Process found, PID: {}\n", process_id);
+        std::vector<MemoryRegion> memory_regions = get_memory_regions(*source, options.regions);
         
-        HANDLE process_handle = open_process(process_id);
-        if (process_handle == NULL) {
-            response.message = "Failed to open process";
-            fmt::print(stderr, "[ERROR] {}\n", response.message);
+        // Range hits each hold their own value; the engine keeps the bytes the kernel matched.
+        bool capture = condition.predicate != ScanPredicate::EQUAL;
+        ScanEngine engine(*source, options);
+        std::vector<uintptr_t> hits = engine.run(memory_regions, kernel.pattern_length - 1, kernel.scanner,
+                                                 capture ? kernel.pattern_length : 0);
+        response.stats = engine.stats();
+        if (scan_cancelled(options)) {
+            response.message = "Scan cancelled; previous results kept";
+            fmt::print(stderr, "[INFO] {}\n", response.message);
             return response;
         }
         
-        fmt::print(stderr, "[SUCCESS] Process opened, handle: {}\n", process_handle);
-        
-        std::vector<uintptr_t> memory_regions = get_memory_regions(process_handle);
-        fmt::print(stderr, "[INFO] Found {} memory regions\n", memory_regions.size());
-        
-        std::vector<MemoryAddress> all_found;
-        size_t scanned_regions = 0;
+        response.alignment = kernel.alignment;
+        ResultSet found(value_type, value_type == ValueType::STRING ? 0 : kernel.pattern_length);
+        found.reserve(hits.size());
         
-        for (uintptr_t region : memory_regions) {
-            if (scanned_regions >= MAX_REGIONS) {
-                fmt::print(stderr, "[WARNING] Reached region limit ({})\n", MAX_REGIONS);
-                break;
+        if (capture) {
+            const uint8_t* values = engine.values().data();
+            for (size_t i = 0; i < hits.size(); ++i) {
+                found.append(hits[i], values + i * kernel.pattern_length);
             }
-            
-            std::vector<MemoryAddress> region_results = scan_memory_region(process_handle, region, value, value_type);
-            if (!region_results.empty()) {
-                all_found.insert(all_found.end(), region_results.begin(), region_results.end());
-                fmt::print(stderr, "[INFO] In region 0x{:x} found {} matches\n", region, region_results.size());
+        } else {
+            // Every hit matched the same pattern, so numeric values share one encoding.
+            for (uintptr_t hit : hits) {
+                found.append(hit, kernel.value_bytes.data());
             }
-            
-            scanned_regions++;
         }
+        std::vector<uintptr_t>().swap(hits);
+        
+        fmt::print(stderr, "[INFO] Result set: {} entries, {} bytes{}\n", found.size(), found.memory_usage(),
+                   found.delta_encoded() ? " (delta encoded)" : "");
         
+        // Hits are paged out through get_addresses rather than copied into the response.
+        response.count = found.size();
         {
-            std::lock_guard<std::mutex> lock(addresses_mutex_);
-            found_addresses_ = all_found;
+            std::lock_guard<std::mutex> lock(writer_mutex_);
+            response.cursor = make_cursor(publish(std::move(found), nullptr, source), 0);
         }
         
-        response.addresses = all_found;
-        response.count = all_found.size();
         response.success = true;
-        response.message = "Scan completed. Found " + std::to_string(all_found.size()) + " matches";
+        response.message = "Scan completed. Found " + std::to_string(response.count) + " matches";
         
         fmt::print(stderr, "[SUCCESS] Scan completed!\n");
-        fmt::print(stderr, "[INFO] Result: {} matches\n", all_found.size());
+        fmt::print(stderr, "[INFO] Result: {} matches (alignment {})\n", response.count, response.alignment);
+        
+    } catch (const std::exception& e) {
+        response.message = "Scan error: " + std::string(e.what());
+        fmt::print(stderr, "[ERROR] {}\n", response.message);
+    }
+    
+    return response;
+}
+
+PatternScanResponse MemoryScanner::scan_pattern(const std::string& process_name, const std::vector<std::string>& signatures,
+                                                const ScanOptions& options) {
+    fmt::print(stderr, "[INFO] Starting pattern scan...\n");
+    fmt::print(stderr, "[INFO] Process: {} ({} signatures)\n", process_name, signatures.size());
+    
+    PatternScanResponse response;
+    response.success = false;
+    response.count = 0;
+    
+    try {
+        std::vector<BytePattern> patterns;
+        patterns.reserve(signatures.size());
+        for (const std::string& signature : signatures) {
+            patterns.push_back(parse_pattern(signature));
+        }
+        PatternKernel kernel(std::move(patterns));
+        
+        DWORD process_id = 0;
+        std::shared_ptr<MemorySource> source = open_process(process_name, process_id, response.message);
+        if (!source) {
+            return response;
+        }
         
-        CloseHandle(process_handle);
+        // The engine only carries addresses. Matches are counted per signature,
+        // and each signature keeps the raw bytes of its lowest-addressed
+        // matches; a chunk whose hits all lie above a full list's last entry
+        // never takes its lock.
+        struct KeptMatches {
+            std::mutex mutex;
+            std::vector<std::pair<uintptr_t, std::vector<uint8_t>>> matches;  // by address
+            std::atomic<uintptr_t> bound{UINTPTR_MAX};                        // last address once full
+        };
+        std::vector<KeptMatches> kept(signatures.size());
+        std::vector<std::atomic<size_t>> counts(signatures.size());
+        
+        ScanEngine engine(*source, options);
+        std::vector<uintptr_t> hits = engine.run(get_memory_regions(*source, options.regions), kernel.max_length() - 1,
+            [&](uintptr_t base, const uint8_t* data, size_t bytes_read, size_t scan_limit, std::vector<uintptr_t>& out) {
+                thread_local std::vector<PatternHit> found;
+                thread_local std::vector<size_t> tally;
+                found.clear();
+                kernel.scan(data, bytes_read, scan_limit, found);
+                if (found.empty()) {
+                    return;
+                }
+                
+                tally.assign(kept.size(), 0);
+                for (const PatternHit& hit : found) {
+                    uintptr_t address = base + hit.offset;
+                    tally[hit.signature]++;
+                    if (out.empty() || out.back() != address) {
+                        out.push_back(address);
+                    }
+                    
+                    KeptMatches& list = kept[hit.signature];
+                    if (address >= list.bound.load(std::memory_order_relaxed)) {
+                        continue;
+                    }
+                    const BytePattern& pattern = kernel.patterns()[hit.signature];
+                    std::lock_guard<std::mutex> lock(list.mutex);
+                    auto at = std::lower_bound(list.matches.begin(), list.matches.end(), address,
+                                               [](const auto& match, uintptr_t a) { return match.first < a; });
+                    list.matches.emplace(at, address, std::vector<uint8_t>(data + hit.offset, data + hit.offset + pattern.value.size()));
+                    if (list.matches.size() > PATTERN_MATCHES_KEPT) {
+                        list.matches.pop_back();
+                    }
+                    if (list.matches.size() == PATTERN_MATCHES_KEPT) {
+                        list.bound.store(list.matches.back().first, std::memory_order_relaxed);
+                    }
+                }
+                for (size_t n = 0; n < tally.size(); ++n) {
+                    if (tally[n] > 0) {
+                        counts[n].fetch_add(tally[n], std::memory_order_relaxed);
+                    }
+                }
+            });
+        response.stats = engine.stats();
+        if (scan_cancelled(options)) {
+            response.message = "Scan cancelled; previous results kept";
+            fmt::print(stderr, "[INFO] {}\n", response.message);
+            return response;
+        }
+        
+        // Only the kept matches are formatted.
+        response.count = 0;
+        response.counts.resize(signatures.size());
+        for (size_t n = 0; n < signatures.size(); ++n) {
+            response.counts[n] = counts[n].load();
+            response.count += response.counts[n];
+            for (const auto& match : kept[n].matches) {
+                response.matches.push_back({match.first, n, format_bytes(match.second.data(), match.second.size())});
+            }
+        }
+        std::sort(response.matches.begin(), response.matches.end(), [](const PatternMatch& a, const PatternMatch& b) {
+            return a.address != b.address ? a.address < b.address : a.signature < b.signature;
+        });
+        
+        ResultSet found(ValueType::STRING, 0);
+        found.reserve(hits.size());
+        for (uintptr_t hit : hits) {
+            found.append(hit, nullptr);
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(writer_mutex_);
+            response.cursor = make_cursor(publish(std::move(found), nullptr, source), 0);
+        }
+        
+        response.success = true;
+        response.message = "Pattern scan completed. Found " + std::to_string(response.count) + " matches at " +
+                           std::to_string(hits.size()) + " addresses";
+        fmt::print(stderr, "[SUCCESS] {}\n", response.message);
+        
+    } catch (const std::exception& e) {
+        response.message = "Pattern scan error: " + std::string(e.what());
+        fmt::print(stderr, "[ERROR] {}\n", response.message);
+    }
+    
+    return response;
+}
+
+ScanResponse MemoryScanner::scan_unknown(const std::string& process_name, ValueType value_type, const ScanOptions& options) {
+    fmt::print(stderr, "[INFO] Starting unknown initial value scan...\n");
+    fmt::print(stderr, "[INFO] Process: {} (type: {})\n", process_name, value_type_to_string(value_type));
+    
+    ScanResponse response;
+    response.success = false;
+    response.count = 0;
+    
+    try {
+        DWORD process_id = 0;
+        std::shared_ptr<MemorySource> source = open_process(process_name, process_id, response.message);
+        if (!source) {
+            return response;
+        }
+        
+        auto snapshot = std::make_shared<SnapshotStore>(value_type, get_memory_regions(*source, options.regions));
+        response.stats = snapshot->capture(*source, options);
+        if (scan_cancelled(options)) {
+            response.message = "Scan cancelled; previous results kept";
+            fmt::print(stderr, "[INFO] {}\n", response.message);
+            return response;
+        }
+        response.count = snapshot->candidate_count();
+        
+        {
+            std::lock_guard<std::mutex> lock(writer_mutex_);
+            response.cursor = make_cursor(publish(ResultSet(), std::move(snapshot), source), 0);
+        }
+        
+        response.success = true;
+        response.message = "Snapshot taken. Tracking " + std::to_string(response.count) + " candidates";
+        fmt::print(stderr, "[SUCCESS] {}\n", response.message);
         
     } catch (const std::exception& e) {
         response.message = "Scan error: " + std::string(e.what());
@@ -92,24 +288,154 @@ ScanResponse MemoryScanner::scan_memory(const std::string& process_name, const s
     return response;
 }
 
-AddressesResponse MemoryScanner::get_addresses(size_t max_count) {
-    AddressesResponse response;
+ScanResponse MemoryScanner::compare_scan(CompareOp op, const std::string& operand, const ScanOptions& options) {
+    fmt::print(stderr, "[INFO] Compare scan: {} {}\n", compare_op_to_string(op), operand);
+    
+    ScanResponse response;
     response.success = false;
+    response.count = 0;
     
     try {
-        std::lock_guard<std::mutex> lock(addresses_mutex_);
+        // Compares build on the current results, so no other writer may
+        // replace them meanwhile; readers keep paging the current state.
+        std::lock_guard<std::mutex> writer(writer_mutex_);
+        std::shared_ptr<const State> state = current();
+        const ResultSet& results = state->results;
+        
+        if (!state->snapshot && results.empty()) {
+            response.message = "No previous scan to compare against";
+            fmt::print(stderr, "[ERROR] {}\n", response.message);
+            return response;
+        }
+        
+        std::shared_ptr<MemorySource> source = scanned_process(*state, response.message);
+        if (!source) {
+            return response;
+        }
+        
+        uint64_t generation = 0;
+        if (state->snapshot) {
+            {
+                // The pass rewrites the snapshot in place, so readers of it wait.
+                std::unique_lock<std::shared_mutex> lock(snapshot_mutex_);
+                response.stats = state->snapshot->compare(*source, options, op, operand);
+            }
+            response.count = state->snapshot->candidate_count();
+            
+            // Once few candidates are left, per-address reads beat re-reading every region.
+            if (response.count <= SNAPSHOT_MATERIALIZE_LIMIT) {
+                ResultSet materialized = state->snapshot->materialize();
+                fmt::print(stderr, "[INFO] Snapshot released; {} candidates kept as results\n", materialized.size());
+                generation = publish(std::move(materialized), nullptr, state->source);
+            } else {
+                generation = publish(ResultSet(), state->snapshot, state->source);
+            }
+        } else {
+            if (results.value_width() == 0) {
+                response.message = "Compare scans need numeric results";
+                fmt::print(stderr, "[ERROR] {}\n", response.message);
+                return response;
+            }
+            
+            ValueComparator comparator = compile_comparator(op, operand, results.value_type());
+            ResultSet next(results.value_type(), results.value_width());
+            CandidateReader reader(*source, results.value_width());
+            reader.read(results, [&](size_t index, uint64_t address, const uint8_t* value, size_t) {
+                if (value != nullptr && comparator(results.value(index), value)) {
+                    next.append(address, value);
+                }
+            });
+            response.count = next.size();
+            generation = publish(std::move(next), nullptr, state->source);
+        }
+        response.cursor = make_cursor(generation, 0);
         
-        size_t count = (std::min)(found_addresses_.size(), max_count);
-        response.count = count;
         response.success = true;
+        response.message = "Compare completed. " + std::to_string(response.count) + " candidates left";
+        if (response.stats.pages_compared + response.stats.pages_unchanged > 0) {
+            response.message += " (pages compared: " + std::to_string(response.stats.pages_compared) +
+                                ", unchanged: " + std::to_string(response.stats.pages_unchanged) +
+                                ", skipped: " + std::to_string(response.stats.pages_skipped) + ")";
+        }
+        if (scan_cancelled(options)) {
+            response.message += "; cancelled, so chunks not yet compared kept their candidates";
+        }
+        fmt::print(stderr, "[SUCCESS] {}\n", response.message);
+        
+    } catch (const std::exception& e) {
+        response.message = "Compare error: " + std::string(e.what());
+        fmt::print(stderr, "[ERROR] {}\n", response.message);
+    }
+    
+    return response;
+}
+
+AddressesResponse MemoryScanner::get_addresses(size_t max_count, size_t offset, const std::string& cursor, bool numeric) {
+    AddressesResponse response;
+    response.success = false;
+    response.count = 0;
+    
+    try {
+        // The state is never changed once published, so paging it needs no
+        // lock; only a snapshot's compare pass writes in place.
+        std::shared_ptr<const State> state = current();
+        const ResultSet& results = state->results;
+        std::shared_lock<std::shared_mutex> snapshot_lock(snapshot_mutex_, std::defer_lock);
+        if (state->snapshot) {
+            snapshot_lock.lock();
+        }
         
-        for (size_t i = 0; i < count; ++i) {
-            std::stringstream ss;
-            ss << "0x" << std::hex << std::uppercase << found_addresses_[i].address;
-            response.addresses.push_back(ss.str());
+        if (!cursor.empty()) {
+            uint64_t generation = 0;
+            if (!parse_cursor(cursor, generation, offset)) {
+                response.message = "Invalid cursor: " + cursor;
+                return response;
+            }
+            if (generation != state->generation) {
+                response.message = "Stale cursor: the results changed since it was issued";
+                return response;
+            }
         }
         
-        response.message = "Retrieved " + std::to_string(count) + " addresses";
+        size_t total = state->snapshot ? state->snapshot->candidate_count() : results.size();
+        size_t begin = (std::min)(offset, total);
+        size_t count = (std::min)(total - begin, max_count);
+        ValueType value_type = state->snapshot ? state->snapshot->value_type() : results.value_type();
+        bool has_values = state->snapshot || results.value_width() > 0;
+        
+        if (numeric) {
+            response.raw_addresses.reserve(count);
+        } else {
+            response.addresses.reserve(count);
+        }
+        if (has_values) {
+            response.values.reserve(count);
+        }
+        auto add = [&](uint64_t address, const uint8_t* value) {
+            if (numeric) {
+                response.raw_addresses.push_back(address);
+            } else {
+                response.addresses.push_back(format_address(address));
+            }
+            if (has_values) {
+                response.values.push_back(format_value(value, value_type));
+            }
+        };
+        
+        if (state->snapshot) {
+            state->snapshot->for_each_candidate(begin, count, add);
+        } else {
+            results.for_each(begin, begin + count, [&](size_t, uint64_t address, const uint8_t* value) { add(address, value); });
+        }
+        response.count = count;
+        response.total = total;
+        response.offset = begin;
+        if (begin + count < total) {
+            response.next_cursor = make_cursor(state->generation, begin + count);
+        }
+        response.success = true;
+        
+        response.message = "Retrieved " + std::to_string(count) + " of " + std::to_string(total) + " addresses";
         
     } catch (const std::exception& e) {
         response.message = "Error getting addresses: " + std::string(e.what());
@@ -118,40 +444,105 @@ AddressesResponse MemoryScanner::get_addresses(size_t max_count) {
     return response;
 }
 
-FilterResponse MemoryScanner::filter_addresses(const std::vector<std::string>& addresses, const std::string& new_value, ValueType value_type) {
-    fmt::print(stderr, "[INFO] Filtering {} addresses...\n", addresses.size());
+FilterResponse MemoryScanner::filter_addresses(const std::vector<std::string>& addresses, const std::string& new_value, ValueType value_type,
+                                               bool all_results) {
+    std::vector<uint64_t> wanted;
+    wanted.reserve(addresses.size());
+    size_t invalid = 0;
+    for (const auto& addr_str : addresses) {
+        uint64_t address;
+        if (parse_address(addr_str, address)) {
+            wanted.push_back(address);
+        } else {
+            invalid++;
+        }
+    }
+    if (invalid > 0) {
+        fmt::print(stderr, "[WARNING] Ignored {} invalid addresses\n", invalid);
+    }
+    return filter_addresses(std::move(wanted), new_value, value_type, all_results);
+}
+
+FilterResponse MemoryScanner::filter_addresses(std::vector<uint64_t> addresses, const std::string& new_value, ValueType value_type,
+                                               bool all_results) {
+    if (all_results) {
+        fmt::print(stderr, "[INFO] Filtering all results...\n");
+    } else {
+        fmt::print(stderr, "[INFO] Filtering {} addresses...\n", addresses.size());
+    }
     fmt::print(stderr, "[INFO] New value: {}\n", new_value);
     
     FilterResponse response;
     response.success = false;
+    response.count = 0;
 
     try {
-        std::lock_guard<std::mutex> lock(addresses_mutex_);
+        // Candidates are tested where they are, whatever stride found them.
+        ScanCondition exact;
+        exact.alignment = 1;
+        CompiledKernel kernel = compile_kernel(new_value, value_type, exact);
+        
+        // Sort the input before taking the lock.
+        std::sort(addresses.begin(), addresses.end());
+        addresses.erase(std::unique(addresses.begin(), addresses.end()), addresses.end());
         
-        std::vector<MemoryAddress> filtered;
+        // Filters build on the current results, so no other writer may
+        // replace them meanwhile; readers keep paging the current state.
+        std::lock_guard<std::mutex> writer(writer_mutex_);
+        std::shared_ptr<const State> state = current();
+        if (state->snapshot) {
+            // The candidates live in the snapshot, not in results; republishing would only invalidate cursors.
+            response.message = "Filtering error: the session tracks an unknown value; narrow it with compare_scan";
+            fmt::print(stderr, "[ERROR] {}\n", response.message);
+            return response;
+        }
         
-        for (const auto& addr_str : addresses) {
-            uintptr_t address;
-            std::stringstream ss(addr_str);
-            ss >> std::hex >> address;
+        // Candidates are the listed addresses that are still in the results,
+        // or every result when asked for all.
+        ResultSet listed;
+        const ResultSet* candidates = &state->results;
+        if (!all_results) {
+            listed = state->results.select(addresses);
+            candidates = &listed;
+        }
+        
+        // Re-read every candidate and keep those that now hold new_value. A
+        // string hit needs only its shortest encoding readable; the kernel
+        // skips the encodings that run past what could be read.
+        size_t width = kernel.pattern_length;
+        size_t min_width = kernel.min_length != 0 ? kernel.min_length : width;
+        ResultSet next(value_type, value_type == ValueType::STRING ? 0 : width);
+        
+        if (!candidates->empty()) {
+            std::shared_ptr<MemorySource> source = scanned_process(*state, response.message);
+            if (!source) {
+                return response;
+            }
             
-            for (const auto& found : found_addresses_) {
-                if (found.address == address) {
-                    MemoryAddress new_addr = found;
-                    new_addr.value = new_value;
-                    new_addr.type = value_type;
-                    filtered.push_back(new_addr);
-                    break;
+            std::vector<uintptr_t> match;
+            CandidateReader reader(*source, min_width, width);
+            size_t readable = reader.read(*candidates, [&](size_t, uint64_t address, const uint8_t* value, size_t length) {
+                if (value == nullptr) {
+                    return;
                 }
-            }
+                match.clear();
+                kernel.scanner(static_cast<uintptr_t>(address), value, length, 1, match);
+                if (!match.empty()) {
+                    next.append(address, value);
+                }
+            });
+            
+            fmt::print(stderr, "[INFO] Re-read {} of {} candidates in {} runs and {} batched reads\n",
+                       readable, candidates->size(), reader.run_count(), reader.batch_count());
         }
         
-        response.addresses = filtered;
-        response.count = filtered.size();
+        // Survivors are paged out through get_addresses, like scan results.
+        response.count = next.size();
+        response.cursor = make_cursor(publish(std::move(next), nullptr, state->source), 0);
         response.success = true;
-        response.message = "Filtering completed. Found " + std::to_string(filtered.size()) + " addresses";
+        response.message = "Filtering completed. Found " + std::to_string(response.count) + " addresses";
         
-        fmt::print(stderr, "[SUCCESS] Filtering completed: {} addresses\n", filtered.size());
+        fmt::print(stderr, "[SUCCESS] Filtering completed: {} addresses\n", response.count);
         
     } catch (const std::exception& e) {
         response.message = "Filtering error: " + std::string(e.what());
@@ -165,8 +556,8 @@ ResetResponse MemoryScanner::reset() {
     ResetResponse response;
     
     try {
-        std::lock_guard<std::mutex> lock(addresses_mutex_);
-        found_addresses_.clear();
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        publish(ResultSet(), nullptr, nullptr);
         
         response.success = true;
         response.message = "Scanner reset";
@@ -182,160 +573,89 @@ ResetResponse MemoryScanner::reset() {
     return response;
 }
 
-DWORD MemoryScanner::find_process_by_name(const std::string& process_name) {
-    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
-    if (snapshot == INVALID_HANDLE_VALUE) {
-        fmt::print(stderr, "[ERROR] Failed to create process snapshot\n");
-        return 0;
-    }
-    
-    PROCESSENTRY32W pe32;
-    pe32.dwSize = sizeof(PROCESSENTRY32W);
-    
-    if (!Process32FirstW(snapshot, &pe32)) {
-        fmt::print(stderr, "[ERROR] Failed to get first process\n");
-        CloseHandle(snapshot);
-        return 0;
-    }
-    
-    do {
-        std::wstring wname(pe32.szExeFile);
-        std::string name = wstring_to_string(wname);
-        
-        if (name == process_name) {
-            fmt::print(stderr, "[SUCCESS] Process found: {} (PID: {})\n", name, pe32.th32ProcessID);
-            CloseHandle(snapshot);
-            return pe32.th32ProcessID;
-        }
-    } while (Process32NextW(snapshot, &pe32));
-    
-    fmt::print(stderr, "[ERROR] Process not found: {}\n", process_name);
-    CloseHandle(snapshot);
-    return 0;
+SessionInfo MemoryScanner::info() const {
+    std::shared_ptr<const State> state = current();
+    std::shared_lock<std::shared_mutex> snapshot_lock(snapshot_mutex_);
+    SessionInfo info;
+    info.process_id = state->process_id;
+    info.snapshot = state->snapshot != nullptr;
+    info.value_type = state->snapshot ? state->snapshot->value_type() : state->results.value_type();
+    info.count = state->snapshot ? state->snapshot->candidate_count() : state->results.size();
+    info.generation = state->generation;
+    return info;
 }
 
-HANDLE MemoryScanner::open_process(DWORD process_id) {
-    HANDLE handle = OpenProcess(
-        PROCESS_QUERY_INFORMATION | PROCESS_VM_READ,
-        FALSE,
-        process_id
-    );
-    
-    if (handle == NULL) {
-        fmt::print(stderr, "[ERROR] Failed to open process PID {}\n", process_id);
-        fmt::print(stderr, "[INFO] Error code: {}\n", GetLastError());
-        return NULL;
-    }
-    
-    return handle;
+std::shared_ptr<const MemoryScanner::State> MemoryScanner::current() const {
+    std::shared_lock<std::shared_mutex> lock(state_mutex_);
+    return state_;
 }
 
-std::vector<uintptr_t> MemoryScanner::get_memory_regions(HANDLE process_handle) {
-    std::vector<uintptr_t> regions;
-    MEMORY_BASIC_INFORMATION mbi;
-    uintptr_t address = 0;
-    
-    while (VirtualQueryEx(process_handle, (LPCVOID)address, &mbi, sizeof(mbi))) {
-        if (mbi.State == MEM_COMMIT && 
-            (mbi.Protect == PAGE_READWRITE || 
-             mbi.Protect == PAGE_READONLY || 
-             mbi.Protect == PAGE_EXECUTE_READ || 
-             mbi.Protect == PAGE_EXECUTE_READWRITE)) {
-            regions.push_back((uintptr_t)mbi.BaseAddress);
-        }
-        
-        address = (uintptr_t)mbi.BaseAddress + mbi.RegionSize;
-        
-        if (address == 0) break;
-    }
-    
-    return regions;
+uint64_t MemoryScanner::publish(ResultSet results, std::shared_ptr<SnapshotStore> snapshot, std::shared_ptr<MemorySource> source) {
+    auto state = std::make_shared<State>();
+    state->results = std::move(results);
+    state->snapshot = std::move(snapshot);
+    state->process_id = source ? source->process_id() : 0;
+    state->source = std::move(source);
+    state->generation = ++last_generation_;
+
+    std::unique_lock<std::shared_mutex> lock(state_mutex_);
+    state_ = std::move(state);
+    return last_generation_;
 }
 
-std::vector<MemoryAddress> MemoryScanner::scan_memory_region(HANDLE process_handle, uintptr_t region_address, const std::string& value, ValueType value_type) {
-    std::vector<MemoryAddress> found;
-    MEMORY_BASIC_INFORMATION mbi;
-    
-    if (VirtualQueryEx(process_handle, (LPCVOID)region_address, &mbi, sizeof(mbi)) == 0) {
-        return found;
+std::shared_ptr<MemorySource> MemoryScanner::scanned_process(const State& state, std::string& error) {
+    // The results belong to the process that was scanned; re-attaching by
+    // PID could read whatever process reused it.
+    if (!state.source || !state.source->is_alive()) {
+        error = "Process exited; scan it again";
+        fmt::print(stderr, "[ERROR] {}\n", error);
+        return nullptr;
     }
-    
-    if (mbi.State != MEM_COMMIT) {
-        return found;
+    return state.source;
+}
+
+std::shared_ptr<MemorySource> MemoryScanner::open_process(const std::string& process_name, DWORD& process_id, std::string& error) {
+    ProcessCache& cache = ProcessCache::shared();
+    if (!cache.available()) {
+        error = "No memory source available on this platform";
+        fmt::print(stderr, "[ERROR] {}\n", error);
+        return nullptr;
     }
-    
-    size_t region_size = mbi.RegionSize;
-    if (region_size > MAX_REGION_SIZE) {
-        region_size = MAX_REGION_SIZE;
+
+    process_id = cache.resolve(process_name);
+    if (process_id == 0) {
+        error = "Process not found: " + process_name;
+        fmt::print(stderr, "[ERROR] {}\n", error);
+        return nullptr;
     }
     
-    std::vector<BYTE> buffer(region_size);
-    SIZE_T bytes_read;
+    fmt::print(stderr, "[SUCCESS] Process found, PID: {}\n", process_id);
     
-    if (!ReadProcessMemory(process_handle, (LPCVOID)region_address, buffer.data(), region_size, &bytes_read)) {
-        return found;
+    std::shared_ptr<MemorySource> source = cache.attach(process_id);
+    if (!source) {
+        error = "Failed to open process";
+        fmt::print(stderr, "[ERROR] {}\n", error);
+        return nullptr;
     }
     
-    if (value_type == ValueType::STRING) {
-        for (size_t i = 0; i <= bytes_read - value.length(); ++i) {
-            if (memcmp(buffer.data() + i, value.c_str(), value.length()) == 0) {
-                MemoryAddress addr;
-                addr.address = region_address + i;
-                addr.value = value;
-                addr.type = value_type;
-                found.push_back(addr);
-            }
-        }
-        
-        std::wstring wide_target;
-        for (char c : value) {
-            wide_target += static_cast<wchar_t>(c);
-        }
-        
-        size_t wide_size = wide_target.length() * sizeof(wchar_t);
-        if (bytes_read >= wide_size) {
-            for (size_t i = 0; i <= bytes_read - wide_size; ++i) {
-                if (memcmp(buffer.data() + i, wide_target.c_str(), wide_size) == 0) {
-                    MemoryAddress addr;
-                    addr.address = region_address + i;
-                    addr.value = value;
-                    addr.type = value_type;
-                    found.push_back(addr);
-                }
-            }
-        }
-    } else {
-        for (size_t i = 0; i <= bytes_read - value.length(); ++i) {
-            bool match = true;
-            for (size_t j = 0; j < value.length(); ++j) {
-                if (buffer[i + j] != static_cast<BYTE>(value[j])) {
-                    match = false;
-                    break;
-                }
-            }
-            
-            if (match) {
-                MemoryAddress addr;
-                addr.address = region_address + i;
-                addr.value = value;
-                addr.type = value_type;
-                found.push_back(addr);
-            }
-        }
-    }
-    
-    return found;
+    fmt::print(stderr, "[SUCCESS] Process opened via {} memory source\n", source->name());
+    return source;
 }
 
-std::string MemoryScanner::value_type_to_string(ValueType type) {
-    switch (type) {
-        case ValueType::INT: return "int";
-        case ValueType::INT32: return "int32";
-        case ValueType::INT64: return "int64";
-        case ValueType::FLOAT: return "float";
-        case ValueType::FLOAT32: return "float32";
-        case ValueType::FLOAT64: return "float64";
-        case ValueType::STRING: return "string";
-        default: return "unknown";
+std::vector<MemoryRegion> MemoryScanner::get_memory_regions(MemorySource& source, const RegionFilter& filter) {
+    std::shared_ptr<RegionMap> map = ProcessCache::shared().region_map(source.process_id());
+    if (!map) {
+        return {};
     }
-} // blyadskie types
\ No newline at end of file
+    
+    // An unchanged layout reuses the list the last scan of this process published.
+    std::shared_ptr<const RegionMap::Regions> all = map->refresh();
+    std::vector<MemoryRegion> regions = select_regions(*all, filter);
+    
+    size_t bytes = 0;
+    for (const MemoryRegion& region : regions) {
+        bytes += region.size;
+    }
+    fmt::print(stderr, "[INFO] Selected {} of {} memory regions ({} bytes)\n", regions.size(), all->size(), bytes);
+    return regions;
+}
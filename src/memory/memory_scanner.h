@@ -1,42 +1,80 @@
 #pragma once
 #include "types.h"
-#include <windows.h>
+#include "memory_source.h"
+#include "result_set.h"
 #include <vector>
 #include <string>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 
 namespace MemoryMCP {
 
+class SnapshotStore;
+
+// One scan session: the PID, value type and results of the latest scan.
+// Every scan, compare, filter or reset publishes a new immutable state and
+// swaps it in, so get_addresses pages whatever state was current when it
+// started and never waits for a scan. Only a snapshot's compare pass, which
+// rewrites the snapshot file in place, holds off readers of that snapshot.
 class MemoryScanner {
 public:
     MemoryScanner();
     ~MemoryScanner();
 
-    ScanResponse scan_memory(const std::string& process_name, const std::string& value, ValueType value_type);
-    AddressesResponse get_addresses(size_t max_count = 100);
-    FilterResponse filter_addresses(const std::vector<std::string>& addresses, const std::string& new_value, ValueType value_type);
+    ScanResponse scan_memory(const std::string& process_name, const std::string& value, ValueType value_type,
+                             const ScanOptions& options = ScanOptions(),
+                             const ScanCondition& condition = ScanCondition());
+    // Unknown initial value: snapshot every readable region, then narrow with compare_scan.
+    ScanResponse scan_unknown(const std::string& process_name, ValueType value_type,
+                              const ScanOptions& options = ScanOptions());
+    ScanResponse compare_scan(CompareOp op, const std::string& operand = std::string(),
+                              const ScanOptions& options = ScanOptions());
+    // Array-of-bytes scan for any number of signatures in one pass.
+    PatternScanResponse scan_pattern(const std::string& process_name, const std::vector<std::string>& signatures,
+                                     const ScanOptions& options = ScanOptions());
+    // One page of up to max_count results starting at offset, or at cursor
+    // when one from a previous page or scan is given. A cursor goes stale
+    // once the results change. numeric fills raw_addresses instead of the
+    // hex strings, for binary encodings.
+    AddressesResponse get_addresses(size_t max_count = 100, size_t offset = 0,
+                                    const std::string& cursor = std::string(), bool numeric = false);
+    // all_results re-checks every stored result instead of the listed addresses.
+    FilterResponse filter_addresses(const std::vector<std::string>& addresses, const std::string& new_value, ValueType value_type,
+                                    bool all_results = false);
+    // As above with the addresses already decoded, in any order.
+    FilterResponse filter_addresses(std::vector<uint64_t> addresses, const std::string& new_value, ValueType value_type,
+                                    bool all_results);
     ResetResponse reset();
+    // The current state; name is left for the caller.
+    SessionInfo info() const;
 
 private:
-    DWORD find_process_by_name(const std::string& process_name);
-    HANDLE open_process(DWORD process_id);
-    std::string get_process_name(DWORD process_id);
-    std::vector<MemoryAddress> scan_memory_region(HANDLE process_handle, uintptr_t base_address, 
-                                                 const std::string& search_value, ValueType value_type);
-    std::vector<uintptr_t> get_memory_regions(HANDLE process_handle);
-    bool is_readable_memory(const MEMORY_BASIC_INFORMATION& mbi);
-    
-    std::string value_type_to_string(ValueType type);
-    ValueType string_to_value_type(const std::string& type_str);
-    std::vector<uint8_t> value_to_bytes(const std::string& value, ValueType type);
-    bool compare_memory(const uint8_t* buffer, const std::vector<uint8_t>& target, ValueType type);
-
-    std::vector<MemoryAddress> found_addresses_;
-    std::mutex addresses_mutex_;
-    
-    static constexpr size_t BUFFER_SIZE = 4096;
-    static constexpr size_t MAX_REGIONS = 1000;
+    struct State {
+        ResultSet results;
+        std::shared_ptr<SnapshotStore> snapshot;  // set instead of results while tracking an unknown value
+        std::shared_ptr<MemorySource> source;     // the scanned process; a reused PID is never re-attached
+        DWORD process_id = 0;
+        uint64_t generation = 0;  // ties cursors to this state
+    };
+
+    std::shared_ptr<const State> current() const;
+    // Swaps in a new state and returns its generation. Callers hold writer_mutex_.
+    uint64_t publish(ResultSet results, std::shared_ptr<SnapshotStore> snapshot, std::shared_ptr<MemorySource> source);
+    // The state's source, or nullptr with error set once its process has exited.
+    static std::shared_ptr<MemorySource> scanned_process(const State& state, std::string& error);
+
+    // Resolves and attaches through ProcessCache::shared(), so the source is
+    // shared with other sessions scanning the same process.
+    std::shared_ptr<MemorySource> open_process(const std::string& process_name, DWORD& process_id, std::string& error);
+    // The regions of source's RegionMap in ProcessCache::shared() that filter selects.
+    std::vector<MemoryRegion> get_memory_regions(MemorySource& source, const RegionFilter& filter);
+
+    std::shared_ptr<const State> state_;
+    mutable std::shared_mutex state_mutex_;     // held only to copy or swap state_
+    std::mutex writer_mutex_;                   // compares, filters and resets build on state_; one at a time
+    mutable std::shared_mutex snapshot_mutex_;  // compare passes rewrite a snapshot in place
+    uint64_t last_generation_ = 0;
 };
 
 } // namespace MemoryMCP rot'ebal de pari
\ No newline at end of file
@@ -0,0 +1,21 @@
+#include "memory_source.h"
+
+#ifdef _WIN32
+#include "windows_memory_source.h"
+#elif defined(__linux__)
+#include "linux_memory_source.h"
+#endif
+
+namespace MemoryMCP {
+
+std::unique_ptr<MemorySource> create_memory_source() {
+#ifdef _WIN32
+    return std::make_unique<WindowsMemorySource>();
+#elif defined(__linux__)
+    return std::make_unique<LinuxMemorySource>();
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace MemoryMCP
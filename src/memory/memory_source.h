@@ -0,0 +1,87 @@
+#pragma once
+#include "types.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace MemoryMCP {
+
+enum MemoryProtection : uint32_t {
+    PROTECTION_NONE = 0,
+    PROTECTION_READ = 1 << 0,
+    PROTECTION_WRITE = 1 << 1,
+    PROTECTION_EXECUTE = 1 << 2
+};
+
+enum class RegionType : uint8_t {
+    PRIVATE,  // heap, stack and other anonymous memory
+    IMAGE,    // an executable or library mapped as code
+    MAPPED    // a mapped data file
+};
+
+struct MemoryRegion {
+    uintptr_t base;
+    size_t size;
+    uint32_t protection;
+    RegionType type = RegionType::PRIVATE;
+    std::string module = {};  // file name behind IMAGE and MAPPED regions
+
+    bool operator==(const MemoryRegion& other) const {
+        return base == other.base && size == other.size && protection == other.protection &&
+               type == other.type && module == other.module;
+    }
+    bool operator!=(const MemoryRegion& other) const { return !(*this == other); }
+};
+
+// One entry of a batched read. bytes_read is filled in by read_batch().
+struct ReadRequest {
+    uintptr_t address;
+    void* buffer;
+    size_t size;
+    size_t bytes_read;
+};
+
+// Platform backend used by MemoryScanner to locate a process, enumerate its
+// address space and read from it. One instance is attached to one process.
+class MemorySource {
+public:
+    virtual ~MemorySource() = default;
+
+    virtual const char* name() const = 0;
+
+    virtual DWORD find_process_by_name(const std::string& process_name) = 0;
+    virtual bool open(DWORD process_id) = 0;
+    virtual void close() = 0;
+    virtual bool is_open() const = 0;
+    virtual DWORD process_id() const = 0;
+    // False once the attached process has exited, even if its PID was reused.
+    virtual bool is_alive() const = 0;
+
+    // Brings index (PID -> executable name) up to date with the running
+    // processes: exited PIDs are dropped and only new ones are named.
+    virtual bool update_process_index(std::map<DWORD, std::string>& index) = 0;
+    // Whether process_id is running under process_name right now.
+    virtual bool process_matches(DWORD process_id, const std::string& process_name) = 0;
+
+    // Committed regions of the attached process, ordered by address.
+    virtual std::vector<MemoryRegion> enumerate_regions() = 0;
+    // Brings regions, a previous enumeration, up to date and returns false if
+    // the address space has not changed since. Work is only spent on what
+    // changed. Keeps state between calls, which enumerate_regions() may also
+    // use, so calls to either must not overlap.
+    virtual bool update_regions(std::vector<MemoryRegion>& regions) = 0;
+
+    // Returns the number of bytes copied into buffer (0 on failure).
+    virtual size_t read(uintptr_t address, void* buffer, size_t size) = 0;
+
+    // Reads every request, coalescing them into as few system calls as the
+    // platform allows. A failing request does not stop the rest of the batch.
+    // Returns the total number of bytes read.
+    virtual size_t read_batch(std::vector<ReadRequest>& requests) = 0;
+};
+
+// Creates the backend for the current platform, or nullptr if there is none.
+std::unique_ptr<MemorySource> create_memory_source();
+
+} // namespace MemoryMCP
@@ -0,0 +1,79 @@
+#include "page_hash.h"
+#include <cstring>
+
+namespace MemoryMCP {
+
+namespace {
+
+constexpr uint64_t PRIME_1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4Full;
+constexpr uint64_t PRIME_3 = 0x165667B19E3779F9ull;
+constexpr uint64_t PRIME_4 = 0x85EBCA77C2B2AE63ull;
+constexpr uint64_t PRIME_5 = 0x27D4EB2F165667C5ull;
+
+inline uint64_t rotl(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64_t load64(const uint8_t* data) {
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline uint64_t mix_round(uint64_t acc, uint64_t input) {
+    acc += input * PRIME_2;
+    return rotl(acc, 31) * PRIME_1;
+}
+
+inline uint64_t merge(uint64_t acc, uint64_t lane) {
+    acc ^= mix_round(0, lane);
+    return acc * PRIME_1 + PRIME_4;
+}
+
+} // namespace
+
+uint64_t hash_page(const uint8_t* data, size_t size) {
+    const uint8_t* p = data;
+    const uint8_t* end = data + size;
+    uint64_t hash;
+
+    if (size >= 32) {
+        uint64_t v1 = PRIME_1 + PRIME_2;
+        uint64_t v2 = PRIME_2;
+        uint64_t v3 = 0;
+        uint64_t v4 = 0 - PRIME_1;
+        for (; p + 32 <= end; p += 32) {
+            v1 = mix_round(v1, load64(p));
+            v2 = mix_round(v2, load64(p + 8));
+            v3 = mix_round(v3, load64(p + 16));
+            v4 = mix_round(v4, load64(p + 24));
+        }
+        hash = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+        hash = merge(hash, v1);
+        hash = merge(hash, v2);
+        hash = merge(hash, v3);
+        hash = merge(hash, v4);
+    } else {
+        hash = PRIME_5;
+    }
+
+    hash += static_cast<uint64_t>(size);
+    for (; p + 8 <= end; p += 8) {
+        hash ^= mix_round(0, load64(p));
+        hash = rotl(hash, 27) * PRIME_1 + PRIME_4;
+    }
+    for (; p < end; ++p) {
+        hash ^= *p * PRIME_5;
+        hash = rotl(hash, 11) * PRIME_1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIME_2;
+    hash ^= hash >> 29;
+    hash *= PRIME_3;
+    hash ^= hash >> 32;
+    return hash == 0 ? 1 : hash;
+}
+
+} // namespace MemoryMCP
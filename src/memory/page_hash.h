@@ -0,0 +1,12 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace MemoryMCP {
+
+// Fast 64-bit content hash in the style of xxHash64: four independent
+// multiply-rotate lanes over 32-byte stripes, merged and avalanched at the end.
+// Never returns 0, which marks a page that has no hash yet.
+uint64_t hash_page(const uint8_t* data, size_t size);
+
+} // namespace MemoryMCP
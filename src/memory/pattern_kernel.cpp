@@ -0,0 +1,210 @@
+#include "pattern_kernel.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+
+namespace MemoryMCP {
+
+namespace {
+
+// Rough commonness of byte values in x86-64 code and data; higher is more
+// common. The anchor is the fixed byte with the lowest score.
+int byte_commonness(uint8_t b) {
+    switch (b) {
+        case 0x00: return 100;
+        case 0xFF: return 80;
+        case 0xCC: return 60;
+        case 0x48: return 55;
+        case 0x8B: return 50;
+        case 0x89: return 45;
+        case 0x0F: return 40;
+        case 0xE8: return 35;
+        case 0x4C: case 0x44: case 0x24: case 0x8D: case 0x83: case 0x85: return 30;
+        case 0x01: case 0x02: case 0x04: case 0x08: case 0x10: case 0x20: case 0x40: case 0x80: return 25;
+        case 0x41: case 0x45: case 0x49: case 0x74: case 0x75: case 0xC0: case 0xC3: case 0x90: return 20;
+        default: return 10;
+    }
+}
+
+int hex_digit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+void append_byte(BytePattern& pattern, char high, char low) {
+    uint8_t value = 0;
+    uint8_t mask = 0;
+    for (char c : {high, low}) {
+        value <<= 4;
+        mask <<= 4;
+        if (c == '?') {
+            continue;
+        }
+        int digit = hex_digit(c);
+        if (digit < 0) {
+            throw std::invalid_argument("Invalid pattern byte in: " + pattern.text);
+        }
+        value |= static_cast<uint8_t>(digit);
+        mask |= 0x0F;
+    }
+    pattern.value.push_back(value);
+    pattern.mask.push_back(mask);
+}
+
+} // namespace
+
+BytePattern parse_pattern(const std::string& text) {
+    BytePattern pattern;
+    pattern.text = text;
+
+    size_t i = 0;
+    while (i < text.size()) {
+        if (std::isspace(static_cast<unsigned char>(text[i]))) {
+            ++i;
+            continue;
+        }
+        size_t end = i;
+        while (end < text.size() && !std::isspace(static_cast<unsigned char>(text[end]))) {
+            ++end;
+        }
+
+        if (end - i == 1 && text[i] == '?') {
+            append_byte(pattern, '?', '?');
+        } else if ((end - i) % 2 == 0) {
+            for (size_t k = i; k < end; k += 2) {
+                append_byte(pattern, text[k], text[k + 1]);
+            }
+        } else {
+            throw std::invalid_argument("Invalid pattern token in: " + text);
+        }
+        i = end;
+    }
+
+    if (pattern.value.empty()) {
+        throw std::invalid_argument("Pattern is empty");
+    }
+    if (pattern.value.size() > MAX_PATTERN_LENGTH) {
+        throw std::invalid_argument("Pattern is longer than " + std::to_string(MAX_PATTERN_LENGTH) + " bytes");
+    }
+
+    int best = -1;
+    for (size_t k = 0; k < pattern.value.size(); ++k) {
+        if (pattern.mask[k] == 0xFF && (best < 0 || byte_commonness(pattern.value[k]) < best)) {
+            best = byte_commonness(pattern.value[k]);
+            pattern.anchor = k;
+        }
+    }
+    if (best < 0) {
+        throw std::invalid_argument("Pattern needs at least one fixed byte: " + text);
+    }
+    return pattern;
+}
+
+std::string format_bytes(const uint8_t* data, size_t size) {
+    static const char digits[] = "0123456789ABCDEF";
+    std::string text;
+    text.reserve(size * 3);
+    for (size_t i = 0; i < size; ++i) {
+        if (i > 0) {
+            text.push_back(' ');
+        }
+        text.push_back(digits[data[i] >> 4]);
+        text.push_back(digits[data[i] & 15]);
+    }
+    return text;
+}
+
+PatternKernel::PatternKernel(std::vector<BytePattern> patterns)
+    : patterns_(std::move(patterns)), classes_{}, bucket_begin_(257, 0) {
+    if (patterns_.empty()) {
+        throw std::invalid_argument("No signatures to scan for");
+    }
+
+    for (const BytePattern& pattern : patterns_) {
+        max_length_ = (std::max)(max_length_, pattern.value.size());
+        max_anchor_ = (std::max)(max_anchor_, pattern.anchor);
+        bucket_begin_[pattern.value[pattern.anchor] + 1]++;
+    }
+    for (size_t b = 0; b < 256; ++b) {
+        bucket_begin_[b + 1] += bucket_begin_[b];
+    }
+    bucket_patterns_.resize(patterns_.size());
+    std::vector<size_t> next(bucket_begin_.begin(), bucket_begin_.end() - 1);
+    for (size_t n = 0; n < patterns_.size(); ++n) {
+        bucket_patterns_[next[patterns_[n].value[patterns_[n].anchor]]++] = n;
+    }
+
+    // One classifier bucket per distinct high nibble keeps the set exact for
+    // up to 8 of them; beyond that buckets are shared and the extra members
+    // are candidates that no pattern claims.
+    int bucket_of_high[16];
+    std::fill(std::begin(bucket_of_high), std::end(bucket_of_high), -1);
+    int buckets = 0;
+    for (size_t b = 0; b < 256; ++b) {
+        if (bucket_begin_[b] == bucket_begin_[b + 1]) {
+            continue;
+        }
+        size_t high = b >> 4;
+        if (bucket_of_high[high] < 0) {
+            bucket_of_high[high] = buckets++ % 8;
+        }
+        uint8_t bit = static_cast<uint8_t>(1u << bucket_of_high[high]);
+        classes_.high[high] |= bit;
+        classes_.low[b & 15] |= bit;
+    }
+}
+
+bool PatternKernel::matches(const BytePattern& pattern, const uint8_t* data) const {
+    size_t size = pattern.value.size();
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t bytes, mask, value;
+        std::memcpy(&bytes, data + i, 8);
+        std::memcpy(&mask, pattern.mask.data() + i, 8);
+        std::memcpy(&value, pattern.value.data() + i, 8);
+        if ((bytes & mask) != value) {
+            return false;
+        }
+    }
+    for (; i < size; ++i) {
+        if ((data[i] & pattern.mask[i]) != pattern.value[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void PatternKernel::scan(const uint8_t* data, size_t bytes_read, size_t scan_limit, std::vector<PatternHit>& out) const {
+    // An anchor may sit up to max_anchor_ bytes past the start of its match.
+    size_t limit = (std::min)(bytes_read, scan_limit + max_anchor_);
+
+    thread_local std::vector<uintptr_t> anchors;
+    anchors.clear();
+    simd::active_kernels().find_classified(data, limit, 0, classes_, anchors);
+
+    size_t first = out.size();
+    for (uintptr_t position : anchors) {
+        uint8_t b = data[position];
+        for (size_t k = bucket_begin_[b]; k < bucket_begin_[b + 1]; ++k) {
+            size_t n = bucket_patterns_[k];
+            const BytePattern& pattern = patterns_[n];
+            if (position < pattern.anchor) {
+                continue;
+            }
+            size_t start = position - pattern.anchor;
+            if (start < scan_limit && start + pattern.value.size() <= bytes_read && matches(pattern, data + start)) {
+                out.push_back({start, n});
+            }
+        }
+    }
+
+    // Anchors sit at different offsets within their patterns.
+    std::sort(out.begin() + first, out.end(), [](const PatternHit& a, const PatternHit& b) {
+        return a.offset != b.offset ? a.offset < b.offset : a.signature < b.signature;
+    });
+}
+
+} // namespace MemoryMCP
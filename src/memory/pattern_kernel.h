@@ -0,0 +1,61 @@
+#pragma once
+#include "types.h"
+#include "simd_kernels.h"
+#include <string>
+#include <vector>
+
+namespace MemoryMCP {
+
+constexpr size_t MAX_PATTERN_LENGTH = 4096;
+
+// An array-of-bytes signature such as "48 8B 05 ?? ?? ?? ?? 48 85 C0".
+// A byte matches when (byte & mask) == value; "??" (or "?") masks a whole
+// byte, "4?" and "?5" mask one nibble.
+struct BytePattern {
+    std::string text;
+    std::vector<uint8_t> value;  // already masked
+    std::vector<uint8_t> mask;
+    size_t anchor = 0;           // offset of the rarest fixed byte
+};
+
+// Parses a signature; tokens are whitespace separated, or a run of hex digits
+// and '?' is split into pairs. Throws std::invalid_argument for bad syntax,
+// patterns over MAX_PATTERN_LENGTH bytes and patterns without a fixed byte.
+BytePattern parse_pattern(const std::string& text);
+
+// Formats bytes as space separated upper-case hex pairs.
+std::string format_bytes(const uint8_t* data, size_t size);
+
+struct PatternHit {
+    size_t offset;
+    size_t signature;
+};
+
+// Matches many signatures in one pass. Every pattern is anchored on its
+// rarest fixed byte; a SIMD byte classifier finds all anchor bytes of all
+// patterns at once and only the patterns anchored on the byte found are
+// verified, so the cost grows with the number of candidates, not patterns.
+class PatternKernel {
+public:
+    explicit PatternKernel(std::vector<BytePattern> patterns);
+
+    const std::vector<BytePattern>& patterns() const { return patterns_; }
+    size_t max_length() const { return max_length_; }
+
+    // Appends every match in data[0, bytes_read) that starts before
+    // scan_limit, ordered by offset and then signature.
+    void scan(const uint8_t* data, size_t bytes_read, size_t scan_limit, std::vector<PatternHit>& out) const;
+
+private:
+    bool matches(const BytePattern& pattern, const uint8_t* data) const;
+
+    std::vector<BytePattern> patterns_;
+    size_t max_length_ = 0;
+    size_t max_anchor_ = 0;
+    simd::ByteClasses classes_;
+    // Patterns anchored on byte b are bucket_patterns_[bucket_begin_[b], bucket_begin_[b + 1]).
+    std::vector<size_t> bucket_begin_;
+    std::vector<size_t> bucket_patterns_;
+};
+
+} // namespace MemoryMCP
@@ -0,0 +1,121 @@
+#include "process_cache.h"
+#include <fmt/base.h>
+
+namespace MemoryMCP {
+
+ProcessCache::ProcessCache(Factory factory) : factory_(std::move(factory)), indexer_(factory_()) {
+}
+
+ProcessCache& ProcessCache::shared() {
+    static ProcessCache cache;
+    return cache;
+}
+
+DWORD ProcessCache::resolve(const std::string& process_name) {
+    if (!indexer_) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    DWORD process_id = lookup(process_name);
+    if (process_id == 0) {
+        indexer_->update_process_index(index_);
+        process_id = lookup(process_name);
+    }
+    if (process_id == 0) {
+        // A PID reused since it was indexed keeps its old name; rebuild before giving up.
+        index_.clear();
+        indexer_->update_process_index(index_);
+        process_id = lookup(process_name);
+    }
+
+    if (process_id != 0) {
+        fmt::print(stderr, "[SUCCESS] Process found: {} (PID: {})\n", process_name, process_id);
+    } else {
+        fmt::print(stderr, "[ERROR] Process not found: {}\n", process_name);
+    }
+    return process_id;
+}
+
+DWORD ProcessCache::lookup(const std::string& process_name) {
+    for (auto it = index_.begin(); it != index_.end();) {
+        if (it->second != process_name) {
+            ++it;
+        } else if (indexer_->process_matches(it->first, process_name)) {
+            return it->first;
+        } else {
+            it = index_.erase(it);  // exited or reused since it was indexed
+        }
+    }
+    return 0;
+}
+
+std::shared_ptr<MemorySource> ProcessCache::attach(DWORD process_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Attached* attached = attach_locked(process_id);
+    return attached ? attached->source : nullptr;
+}
+
+std::shared_ptr<RegionMap> ProcessCache::region_map(DWORD process_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Attached* attached = attach_locked(process_id);
+    return attached ? attached->regions : nullptr;
+}
+
+ProcessCache::Attached* ProcessCache::attach_locked(DWORD process_id) {
+    if (Attached* attached = find_alive(process_id)) {
+        return attached;
+    }
+
+    std::shared_ptr<MemorySource> source = factory_ ? factory_() : nullptr;
+    if (!source || !source->open(process_id)) {
+        return nullptr;
+    }
+
+    Attached& attached = attached_[process_id];
+    attached = {source, std::make_shared<RegionMap>(source), ++uses_};
+    evict(process_id);
+    fmt::print(stderr, "[INFO] Attached to PID {} ({} cached)\n", process_id, attached_.size());
+    return &attached;
+}
+
+ProcessCache::Attached* ProcessCache::find_alive(DWORD process_id) {
+    auto it = attached_.find(process_id);
+    if (it == attached_.end()) {
+        return nullptr;
+    }
+    if (!it->second.source->is_alive()) {
+        fmt::print(stderr, "[INFO] PID {} exited; detaching\n", process_id);
+        attached_.erase(it);
+        return nullptr;
+    }
+    it->second.last_used = ++uses_;
+    return &it->second;
+}
+
+void ProcessCache::evict(DWORD keep) {
+    while (attached_.size() > MAX_ATTACHED) {
+        auto oldest = attached_.end();
+        for (auto it = attached_.begin(); it != attached_.end(); ++it) {
+            if (it->first == keep) {
+                continue;
+            }
+            if (!it->second.source->is_alive()) {
+                oldest = it;
+                break;
+            }
+            if (oldest == attached_.end() || it->second.last_used < oldest->second.last_used) {
+                oldest = it;
+            }
+        }
+        // Scans still holding the source keep it open until they finish.
+        attached_.erase(oldest);
+    }
+}
+
+size_t ProcessCache::attached_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return attached_.size();
+}
+
+} // namespace MemoryMCP
@@ -0,0 +1,70 @@
+#pragma once
+#include "types.h"
+#include "memory_source.h"
+#include "region_map.h"
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace MemoryMCP {
+
+// Keeps processes attached between scans, so repeated scans of one target
+// neither walk the process list nor reopen it. Sources are kept by PID and
+// handed out shared; one is reused only while its process is alive, which
+// the source checks without enumerating anything. Names resolve through a
+// PID -> name index that is updated incrementally, and only when a lookup
+// misses or its entry turns out to be stale. Each attached process keeps its
+// RegionMap for as long as it stays attached.
+class ProcessCache {
+public:
+    using Factory = std::function<std::unique_ptr<MemorySource>()>;
+
+    explicit ProcessCache(Factory factory = create_memory_source);
+
+    ProcessCache(const ProcessCache&) = delete;
+    ProcessCache& operator=(const ProcessCache&) = delete;
+
+    // The cache every scan session shares.
+    static ProcessCache& shared();
+
+    // False when the platform has no memory source.
+    bool available() const { return indexer_ != nullptr; }
+
+    // PID of a running process called process_name, or 0.
+    DWORD resolve(const std::string& process_name);
+    // A source attached to process_id, or nullptr if it cannot be opened.
+    // Callers share it, so they must not close it.
+    std::shared_ptr<MemorySource> attach(DWORD process_id);
+    // The region map of process_id, attaching it if needed; nullptr if it
+    // cannot be opened.
+    std::shared_ptr<RegionMap> region_map(DWORD process_id);
+
+    size_t attached_count() const;
+
+private:
+    struct Attached {
+        std::shared_ptr<MemorySource> source;
+        std::shared_ptr<RegionMap> regions;
+        uint64_t last_used;
+    };
+
+    // Callers hold mutex_.
+    Attached* find_alive(DWORD process_id);
+    Attached* attach_locked(DWORD process_id);
+    DWORD lookup(const std::string& process_name);
+    // Drops exited processes, then the least recently used, down to MAX_ATTACHED.
+    void evict(DWORD keep);
+
+    static constexpr size_t MAX_ATTACHED = 16;
+
+    Factory factory_;
+    std::unique_ptr<MemorySource> indexer_;  // never opened; walks the process list
+    mutable std::mutex mutex_;
+    std::map<DWORD, Attached> attached_;
+    std::map<DWORD, std::string> index_;
+    uint64_t uses_ = 0;
+};
+
+} // namespace MemoryMCP
@@ -0,0 +1,73 @@
+#include "region_map.h"
+#include <algorithm>
+#include <cctype>
+#include <fmt/base.h>
+
+namespace MemoryMCP {
+
+namespace {
+
+bool same_name(const std::string& a, const std::string& b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+        return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+    });
+}
+
+bool admits(const RegionFilter& filter, const MemoryRegion& region) {
+    if (!(region.protection & PROTECTION_READ) ||
+        (filter.writable && !(region.protection & PROTECTION_WRITE)) ||
+        (filter.executable && !(region.protection & PROTECTION_EXECUTE)) ||
+        (filter.skip_image && region.type == RegionType::IMAGE) ||
+        (filter.skip_mapped && region.type == RegionType::MAPPED) ||
+        region.size < filter.min_size || (filter.max_size != 0 && region.size > filter.max_size)) {
+        return false;
+    }
+    if (filter.modules.empty()) {
+        return true;
+    }
+    return std::any_of(filter.modules.begin(), filter.modules.end(),
+                       [&](const std::string& module) { return same_name(module, region.module); });
+}
+
+} // namespace
+
+RegionMap::RegionMap(std::shared_ptr<MemorySource> source)
+    : source_(std::move(source)), regions_(std::make_shared<const Regions>()) {
+}
+
+std::shared_ptr<const RegionMap::Regions> RegionMap::refresh() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (source_->update_regions(working_) || version_ == 0) {
+        regions_ = std::make_shared<const Regions>(working_);
+        ++version_;
+        fmt::print(stderr, "[INFO] Region map of PID {} updated: {} regions\n", source_->process_id(), working_.size());
+    }
+    return regions_;
+}
+
+std::shared_ptr<const RegionMap::Regions> RegionMap::current() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return regions_;
+}
+
+uint64_t RegionMap::version() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return version_;
+}
+
+std::vector<MemoryRegion> select_regions(const std::vector<MemoryRegion>& regions, const RegionFilter& filter) {
+    std::vector<MemoryRegion> selected;
+    for (const MemoryRegion& region : regions) {
+        uint64_t begin = (std::max)(static_cast<uint64_t>(region.base), filter.start);
+        uint64_t end = (std::min)(static_cast<uint64_t>(region.base) + region.size, filter.end);
+        if (begin >= end || !admits(filter, region)) {
+            continue;
+        }
+        selected.push_back(region);
+        selected.back().base = static_cast<uintptr_t>(begin);
+        selected.back().size = static_cast<size_t>(end - begin);
+    }
+    return selected;
+}
+
+} // namespace MemoryMCP
@@ -0,0 +1,43 @@
+#pragma once
+#include "types.h"
+#include "memory_source.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace MemoryMCP {
+
+// The address space of one attached process: base, size, protection, type
+// and backing module of every committed region. refresh() asks the source
+// for what changed and publishes a new immutable list only when the layout
+// did, so scans of an unchanged process reuse one list and its workers share
+// it read-only.
+class RegionMap {
+public:
+    using Regions = std::vector<MemoryRegion>;
+
+    explicit RegionMap(std::shared_ptr<MemorySource> source);
+
+    RegionMap(const RegionMap&) = delete;
+    RegionMap& operator=(const RegionMap&) = delete;
+
+    // Brings the map up to date and returns it.
+    std::shared_ptr<const Regions> refresh();
+    // The list as of the last refresh, empty before the first.
+    std::shared_ptr<const Regions> current() const;
+    // Number of distinct layouts published so far.
+    uint64_t version() const;
+
+private:
+    std::shared_ptr<MemorySource> source_;
+    mutable std::mutex mutex_;
+    Regions working_;  // updated in place by the source, copied out on change
+    std::shared_ptr<const Regions> regions_;
+    uint64_t version_ = 0;
+};
+
+// The readable regions of regions that filter admits, clipped to its address
+// window, in address order.
+std::vector<MemoryRegion> select_regions(const std::vector<MemoryRegion>& regions, const RegionFilter& filter);
+
+} // namespace MemoryMCP
@@ -0,0 +1,205 @@
+#include "result_set.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <limits>
+
+namespace MemoryMCP {
+
+namespace {
+
+// "00" to "FF", so formatting takes one lookup per byte instead of a
+// division per digit.
+struct HexPairs {
+    char digits[512];
+
+    constexpr HexPairs() : digits() {
+        const char hex[] = "0123456789ABCDEF";
+        for (int i = 0; i < 256; ++i) {
+            digits[2 * i] = hex[i >> 4];
+            digits[2 * i + 1] = hex[i & 15];
+        }
+    }
+};
+
+constexpr HexPairs HEX_PAIRS;
+
+} // namespace
+
+ResultSet::ResultSet(ValueType value_type, size_t value_width, size_t delta_threshold)
+    : value_type_(value_type), value_width_(value_width), delta_threshold_(delta_threshold) {
+}
+
+void ResultSet::reserve(size_t count) {
+    if (!delta_encoded_) {
+        addresses_.reserve((std::min)(count, delta_threshold_ + 1));
+    }
+    if (delta_encoded_ || count > delta_threshold_) {
+        offsets_.reserve(count);
+    }
+    values_.reserve(count * value_width_);
+}
+
+void ResultSet::clear() {
+    size_ = 0;
+    delta_encoded_ = false;
+    addresses_.clear();
+    segments_.clear();
+    offsets_.clear();
+    values_.clear();
+}
+
+void ResultSet::append(uint64_t address, const uint8_t* value) {
+    if (delta_encoded_) {
+        append_delta(address);
+    } else {
+        addresses_.push_back(address);
+    }
+
+    if (value_width_ > 0) {
+        values_.insert(values_.end(), value, value + value_width_);
+    }
+    size_++;
+
+    if (!delta_encoded_ && size_ > delta_threshold_) {
+        encode_deltas();
+    }
+}
+
+void ResultSet::append_delta(uint64_t address) {
+    if (segments_.empty() || address - segments_.back().base > std::numeric_limits<uint32_t>::max()) {
+        segments_.push_back({address, offsets_.size()});
+    }
+    offsets_.push_back(static_cast<uint32_t>(address - segments_.back().base));
+}
+
+void ResultSet::encode_deltas() {
+    offsets_.reserve((std::max)(addresses_.capacity(), addresses_.size()));
+    delta_encoded_ = true;
+    for (uint64_t address : addresses_) {
+        append_delta(address);
+    }
+    std::vector<uint64_t>().swap(addresses_);
+}
+
+size_t ResultSet::segment_of(size_t index) const {
+    auto it = std::upper_bound(segments_.begin(), segments_.end(), index,
+                               [](size_t i, const Segment& segment) { return i < segment.first; });
+    return static_cast<size_t>(it - segments_.begin()) - 1;
+}
+
+uint64_t ResultSet::address(size_t index) const {
+    if (!delta_encoded_) {
+        return addresses_[index];
+    }
+    return segments_[segment_of(index)].base + offsets_[index];
+}
+
+size_t ResultSet::find(uint64_t address) const {
+    if (!delta_encoded_) {
+        auto it = std::lower_bound(addresses_.begin(), addresses_.end(), address);
+        return it != addresses_.end() && *it == address ? static_cast<size_t>(it - addresses_.begin()) : npos;
+    }
+
+    auto segment = std::upper_bound(segments_.begin(), segments_.end(), address,
+                                    [](uint64_t a, const Segment& s) { return a < s.base; });
+    if (segment == segments_.begin()) {
+        return npos;
+    }
+    --segment;
+
+    uint64_t delta = address - segment->base;
+    if (delta > std::numeric_limits<uint32_t>::max()) {
+        return npos;
+    }
+
+    size_t last = segment + 1 == segments_.end() ? offsets_.size() : (segment + 1)->first;
+    auto first = offsets_.begin() + segment->first;
+    auto end = offsets_.begin() + last;
+    auto it = std::lower_bound(first, end, static_cast<uint32_t>(delta));
+    return it != end && *it == delta ? static_cast<size_t>(it - offsets_.begin()) : npos;
+}
+
+size_t ResultSet::gallop(size_t from, uint64_t address) const {
+    // Exponential probe from the cursor, then binary search inside the last step.
+    size_t low = from;
+    size_t step = 1;
+    size_t high = from;
+    while (high < size_ && this->address(high) < address) {
+        low = high + 1;
+        high = from + step;
+        step *= 2;
+    }
+    high = (std::min)(high, size_);
+
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (this->address(mid) < address) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+ResultSet ResultSet::select(const std::vector<uint64_t>& sorted_addresses) const {
+    ResultSet selected(value_type_, value_width_, delta_threshold_);
+    selected.reserve((std::min)(sorted_addresses.size(), size_));
+
+    size_t cursor = 0;
+    for (uint64_t address : sorted_addresses) {
+        cursor = gallop(cursor, address);
+        if (cursor == size_) {
+            break;
+        }
+        if (this->address(cursor) == address) {
+            selected.append(address, value(cursor));
+            ++cursor;
+        }
+    }
+
+    return selected;
+}
+
+size_t ResultSet::memory_usage() const {
+    return addresses_.capacity() * sizeof(uint64_t) + segments_.capacity() * sizeof(Segment) +
+           offsets_.capacity() * sizeof(uint32_t) + values_.capacity();
+}
+
+bool parse_address(const std::string& text, uint64_t& out) {
+    const char* first = text.data();
+    const char* last = text.data() + text.size();
+    if (last - first > 2 && first[0] == '0' && (first[1] == 'x' || first[1] == 'X')) {
+        first += 2;
+    }
+
+    auto result = std::from_chars(first, last, out, 16);
+    return result.ec == std::errc() && result.ptr == last && first != last;
+}
+
+size_t format_address(uint64_t address, char* out) {
+    char buffer[16];
+    char* end = buffer + sizeof(buffer);
+    char* digits = end;
+    do {
+        digits -= 2;
+        std::memcpy(digits, &HEX_PAIRS.digits[(address & 0xFF) * 2], 2);
+        address >>= 8;
+    } while (address != 0);
+    if (*digits == '0' && end - digits > 1) {
+        digits++;
+    }
+
+    out[0] = '0';
+    out[1] = 'x';
+    std::memcpy(out + 2, digits, static_cast<size_t>(end - digits));
+    return 2 + static_cast<size_t>(end - digits);
+}
+
+std::string format_address(uint64_t address) {
+    char text[ADDRESS_TEXT_MAX];
+    return std::string(text, format_address(address, text));
+}
+
+} // namespace MemoryMCP
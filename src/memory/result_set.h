@@ -0,0 +1,118 @@
+#pragma once
+#include "types.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace MemoryMCP {
+
+// Scan results in struct-of-arrays form: sorted addresses, the last-seen raw
+// value of each address in a parallel fixed-width byte array, and the value
+// type stored once for the whole set.
+//
+// Once a set grows past delta_threshold entries its addresses are re-encoded as
+// 32-bit offsets from segment bases (one segment per 4 GiB span, which in
+// practice means one per region cluster), halving the address storage.
+class ResultSet {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    ResultSet() = default;
+    ResultSet(ValueType value_type, size_t value_width, size_t delta_threshold = RESULT_DELTA_THRESHOLD);
+
+    ValueType value_type() const { return value_type_; }
+    size_t value_width() const { return value_width_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    bool delta_encoded() const { return delta_encoded_; }
+
+    void reserve(size_t count);
+    void clear();
+
+    // Addresses must be appended in ascending order. value points at
+    // value_width() bytes and may be null when the width is 0.
+    void append(uint64_t address, const uint8_t* value);
+
+    uint64_t address(size_t index) const;
+    const uint8_t* value(size_t index) const { return values_.data() + index * value_width_; }
+
+    // Index of address, or npos when it is not in the set.
+    size_t find(uint64_t address) const;
+
+    // Entries whose address is in sorted_addresses (ascending, no duplicates),
+    // found in one merge pass that gallops over runs of the set it can skip.
+    ResultSet select(const std::vector<uint64_t>& sorted_addresses) const;
+
+    // Calls f(index, address, value) for every entry in [begin, end), decoding
+    // addresses sequentially instead of per lookup.
+    template <typename F>
+    void for_each(size_t begin, size_t end, F&& f) const {
+        end = end < size_ ? end : size_;
+        if (begin >= end) {
+            return;
+        }
+
+        if (!delta_encoded_) {
+            for (size_t i = begin; i < end; ++i) {
+                f(i, addresses_[i], value(i));
+            }
+            return;
+        }
+
+        size_t segment = segment_of(begin);
+        for (size_t i = begin; i < end; ++i) {
+            while (segment + 1 < segments_.size() && segments_[segment + 1].first <= i) {
+                ++segment;
+            }
+            f(i, segments_[segment].base + offsets_[i], value(i));
+        }
+    }
+
+    template <typename F>
+    void for_each(F&& f) const {
+        for_each(0, size_, std::forward<F>(f));
+    }
+
+    // Bytes held by the set, for logging.
+    size_t memory_usage() const;
+
+private:
+    // Entries [first, next segment's first) are stored relative to base.
+    struct Segment {
+        uint64_t base;
+        size_t first;
+    };
+
+    // First index in [from, size_) whose address is >= address.
+    size_t gallop(size_t from, uint64_t address) const;
+
+    void encode_deltas();
+    void append_delta(uint64_t address);
+    size_t segment_of(size_t index) const;
+
+    ValueType value_type_ = ValueType::INT32;
+    size_t value_width_ = 0;
+    size_t delta_threshold_ = RESULT_DELTA_THRESHOLD;
+    size_t size_ = 0;
+    bool delta_encoded_ = false;
+
+    std::vector<uint64_t> addresses_;
+    std::vector<Segment> segments_;
+    std::vector<uint32_t> offsets_;
+    std::vector<uint8_t> values_;
+};
+
+// Parses a hexadecimal address with an optional 0x prefix.
+bool parse_address(const std::string& text, uint64_t& out);
+
+// Longest text format_address writes: 0x and 16 digits.
+constexpr size_t ADDRESS_TEXT_MAX = 18;
+
+// Formats address as 0x and uppercase hex digits without leading zeros,
+// the form parse_address reads. The second overload writes into out, which
+// must hold ADDRESS_TEXT_MAX chars, and returns the length.
+std::string format_address(uint64_t address);
+size_t format_address(uint64_t address, char* out);
+
+} // namespace MemoryMCP
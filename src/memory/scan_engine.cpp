@@ -0,0 +1,251 @@
+#include "scan_engine.h"
+#include "streaming_reader.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <fmt/base.h>
+
+namespace MemoryMCP {
+
+namespace {
+
+// Consecutive chunks read together with one read_batch call, or a single
+// stripe that is too large for one buffer and is streamed instead.
+struct ScanTask {
+    size_t first_chunk;
+    size_t chunk_count;
+    size_t bytes;
+    bool streamed;
+};
+
+// Range of a worker's hit buffer produced by one task.
+struct TaskSpan {
+    size_t task;
+    size_t worker;
+    size_t begin;
+    size_t end;
+};
+
+struct alignas(64) WorkerState {
+    std::vector<ReadRequest> reads;
+    std::vector<uintptr_t> hits;
+    std::vector<uint8_t> values;  // value_width bytes per hit
+    std::vector<TaskSpan> spans;
+    size_t bytes_scanned = 0;
+    double busy_ms = 0.0;
+};
+
+using Clock = std::chrono::steady_clock;
+
+double elapsed_ms(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// One pool for the lifetime of the process, so the per-thread buffer pools and
+// prefetch threads of its workers are reused from one scan to the next. Runs
+// asking for fewer threads are limited by parallel_for instead.
+ThreadPool& shared_pool() {
+    static ThreadPool pool((std::min)(ThreadPool::default_thread_count(), MAX_SCAN_THREADS));
+    return pool;
+}
+
+} // namespace
+
+ScanEngine::ScanEngine(MemorySource& source, const ScanOptions& options)
+    : source_(source), options_(options) {
+    if (options_.chunk_size == 0) {
+        options_.chunk_size = SCAN_CHUNK_SIZE;
+    }
+}
+
+std::vector<ScanChunk> ScanEngine::split_regions(const std::vector<MemoryRegion>& regions, size_t chunk_size, size_t overlap) {
+    std::vector<ScanChunk> chunks;
+
+    for (const MemoryRegion& region : regions) {
+        for (size_t offset = 0; offset < region.size; offset += chunk_size) {
+            ScanChunk chunk;
+            chunk.address = region.base + offset;
+            chunk.size = (std::min)(chunk_size, region.size - offset);
+            chunk.overlap = (std::min)(overlap, region.size - offset - chunk.size);
+            chunks.push_back(chunk);
+        }
+    }
+
+    return chunks;
+}
+
+std::vector<uintptr_t> ScanEngine::run(const std::vector<MemoryRegion>& regions, size_t overlap, const ChunkScanner& scanner,
+                                       size_t value_width) {
+    auto start = Clock::now();
+
+    // Regions are cut into stripes for parallelism; a stripe larger than one
+    // chunk is streamed chunk by chunk instead of being read in one piece.
+    const size_t stripe_size = options_.chunk_size * SCAN_STRIPE_CHUNKS;
+    std::vector<ScanChunk> chunks = split_regions(regions, stripe_size, overlap);
+
+    // Small regions are packed into one task so a single read covers all of them.
+    std::vector<ScanTask> tasks;
+    size_t chunk_count = 0;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        size_t bytes = chunks[i].size + chunks[i].overlap;
+        if (bytes > options_.chunk_size) {
+            tasks.push_back({i, 1, bytes, true});
+            chunk_count += (chunks[i].size + options_.chunk_size - 1) / options_.chunk_size;
+            continue;
+        }
+        if (tasks.empty() || tasks.back().streamed || tasks.back().bytes + bytes > options_.chunk_size) {
+            tasks.push_back({i, 0, 0, false});
+        }
+        tasks.back().chunk_count++;
+        tasks.back().bytes += bytes;
+        chunk_count++;
+    }
+
+    // Stripes left per region, so finished regions can be counted.
+    ScanProgress* progress = options_.progress;
+    std::vector<size_t> chunk_region;
+    std::unique_ptr<std::atomic<size_t>[]> stripes_left;
+    if (progress != nullptr) {
+        chunk_region.reserve(chunks.size());
+        stripes_left.reset(new std::atomic<size_t>[regions.size()]);
+        size_t empty_regions = 0;
+        uint64_t bytes_total = 0;
+        for (size_t r = 0; r < regions.size(); ++r) {
+            size_t stripes = (regions[r].size + stripe_size - 1) / stripe_size;
+            stripes_left[r] = stripes;
+            chunk_region.insert(chunk_region.end(), stripes, r);
+            empty_regions += stripes == 0;
+            bytes_total += regions[r].size;
+        }
+        progress->bytes_total += bytes_total;
+        progress->regions_total += regions.size();
+        progress->regions_done += empty_regions;
+    }
+    auto finish_chunk = [&](size_t chunk_index, size_t bytes, size_t hits) {
+        progress->bytes_scanned += bytes;
+        progress->hits += hits;
+        if (--stripes_left[chunk_region[chunk_index]] == 0) {
+            progress->regions_done++;
+        }
+    };
+
+    size_t thread_count = options_.thread_count == 0 ? ThreadPool::default_thread_count() : options_.thread_count;
+    // Copies the values of the hits a scanner call just appended, while their chunk is still in memory.
+    auto capture = [value_width](WorkerState& worker, size_t hits_before, uintptr_t address, const uint8_t* data) {
+        for (size_t h = hits_before; h < worker.hits.size(); ++h) {
+            const uint8_t* value = data + (worker.hits[h] - address);
+            worker.values.insert(worker.values.end(), value, value + value_width);
+        }
+    };
+
+    ThreadPool& pool = shared_pool();
+    thread_count = (std::max)(size_t(1), (std::min)({thread_count, tasks.size(), pool.size()}));
+    std::vector<WorkerState> workers(pool.size());
+
+    pool.parallel_for(tasks.size(), [&](size_t index, size_t worker_index) {
+        if (scan_cancelled(options_)) {
+            return;
+        }
+        auto task_start = Clock::now();
+        const ScanTask& task = tasks[index];
+        WorkerState& worker = workers[worker_index];
+        size_t begin = worker.hits.size();
+
+        if (task.streamed) {
+            const ScanChunk& chunk = chunks[task.first_chunk];
+            StreamingReader reader(source_, options_.chunk_size, overlap);
+            size_t reported = 0;
+            worker.bytes_scanned += reader.stream(chunk.address, chunk.size, chunk.address + chunk.size + chunk.overlap,
+                [&](uintptr_t address, const uint8_t* data, size_t bytes_read, size_t scan_limit) {
+                    size_t hits_before = worker.hits.size();
+                    scanner(address, data, bytes_read, scan_limit, worker.hits);
+                    if (value_width > 0) {
+                        capture(worker, hits_before, address, data);
+                    }
+                    if (progress != nullptr) {
+                        progress->bytes_scanned += scan_limit;
+                        progress->hits += worker.hits.size() - hits_before;
+                        reported += scan_limit;
+                    }
+                }, progress != nullptr ? &progress->cancelled : nullptr);
+            if (progress != nullptr && !scan_cancelled(options_)) {
+                finish_chunk(task.first_chunk, chunk.size - (std::min)(reported, chunk.size), 0);
+            }
+        } else {
+            PooledBuffer buffer = BufferPool::local().acquire(task.bytes);
+            worker.reads.clear();
+
+            size_t offset = 0;
+            for (size_t i = 0; i < task.chunk_count; ++i) {
+                const ScanChunk& chunk = chunks[task.first_chunk + i];
+                size_t bytes = chunk.size + chunk.overlap;
+                worker.reads.push_back({chunk.address, buffer.data() + offset, bytes, 0});
+                offset += bytes;
+            }
+
+            source_.read_batch(worker.reads);
+
+            for (size_t i = 0; i < task.chunk_count; ++i) {
+                const ScanChunk& chunk = chunks[task.first_chunk + i];
+                const ReadRequest& read = worker.reads[i];
+                size_t hits_before = worker.hits.size();
+                if (read.bytes_read > 0) {
+                    scanner(chunk.address, static_cast<const uint8_t*>(read.buffer), read.bytes_read,
+                            (std::min)(chunk.size, read.bytes_read), worker.hits);
+                    if (value_width > 0) {
+                        capture(worker, hits_before, chunk.address, static_cast<const uint8_t*>(read.buffer));
+                    }
+                    worker.bytes_scanned += (std::min)(chunk.size, read.bytes_read);
+                }
+                if (progress != nullptr) {
+                    finish_chunk(task.first_chunk + i, chunk.size, worker.hits.size() - hits_before);
+                }
+            }
+        }
+
+        if (worker.hits.size() > begin) {
+            worker.spans.push_back({index, worker_index, begin, worker.hits.size()});
+        }
+        worker.busy_ms += elapsed_ms(task_start);
+    }, thread_count);
+
+    // Deterministic merge: tasks are in address order, whichever worker ran them.
+    std::vector<TaskSpan> spans;
+    size_t total_hits = 0;
+    for (const WorkerState& worker : workers) {
+        spans.insert(spans.end(), worker.spans.begin(), worker.spans.end());
+        total_hits += worker.hits.size();
+    }
+    std::sort(spans.begin(), spans.end(), [](const TaskSpan& a, const TaskSpan& b) { return a.task < b.task; });
+
+    std::vector<uintptr_t> results;
+    results.reserve(total_hits);
+    values_.clear();
+    values_.reserve(total_hits * value_width);
+    for (const TaskSpan& span : spans) {
+        const WorkerState& worker = workers[span.worker];
+        results.insert(results.end(), worker.hits.begin() + span.begin, worker.hits.begin() + span.end);
+        values_.insert(values_.end(), worker.values.begin() + span.begin * value_width,
+                       worker.values.begin() + span.end * value_width);
+    }
+
+    stats_ = ScanStats();
+    stats_.thread_count = thread_count;
+    stats_.chunk_count = chunk_count;
+    for (const WorkerState& worker : workers) {
+        stats_.bytes_scanned += worker.bytes_scanned;
+        stats_.busy_ms += worker.busy_ms;
+    }
+    stats_.elapsed_ms = elapsed_ms(start);
+    stats_.speedup = stats_.elapsed_ms > 0.0 ? stats_.busy_ms / stats_.elapsed_ms : 0.0;
+
+    fmt::print(stderr, "[INFO] Scanned {} bytes in {} chunks on {} threads ({:.1f} ms, speedup {:.2f}x){}\n",
+               stats_.bytes_scanned, stats_.chunk_count, stats_.thread_count, stats_.elapsed_ms, stats_.speedup,
+               scan_cancelled(options_) ? " - cancelled" : "");
+
+    return results;
+}
+
+} // namespace MemoryMCP
@@ -0,0 +1,64 @@
+#pragma once
+#include "types.h"
+#include "memory_source.h"
+#include <atomic>
+#include <functional>
+#include <vector>
+
+namespace MemoryMCP {
+
+// Live counters of running scans, updated by the engine as chunks finish;
+// totals grow as each engine run starts. Setting cancelled makes the engine
+// skip the chunks it has not started and stop streamed stripes after the
+// current chunk.
+struct ScanProgress {
+    std::atomic<uint64_t> bytes_total{0};
+    std::atomic<uint64_t> bytes_scanned{0};  // of finished chunks, readable or not
+    std::atomic<size_t> regions_total{0};
+    std::atomic<size_t> regions_done{0};
+    std::atomic<size_t> hits{0};
+    std::atomic<bool> cancelled{false};
+};
+
+inline bool scan_cancelled(const ScanOptions& options) {
+    return options.progress != nullptr && options.progress->cancelled.load(std::memory_order_relaxed);
+}
+
+// A slice of one region. size bytes are scanned for match starts; overlap more
+// bytes are read past the end so matches straddling the next slice are found.
+struct ScanChunk {
+    uintptr_t address;
+    size_t size;
+    size_t overlap;
+};
+
+// Splits regions into chunks and scans them in parallel on a work-stealing pool.
+// Each worker collects hits in its own buffer; the buffers are merged in address
+// order at the end, so results do not depend on the thread count.
+class ScanEngine {
+public:
+    // Scans data[0, bytes_read) for matches starting before scan_limit and appends them to out.
+    using ChunkScanner = std::function<void(uintptr_t address, const uint8_t* data, size_t bytes_read,
+                                            size_t scan_limit, std::vector<uintptr_t>& out)>;
+
+    ScanEngine(MemorySource& source, const ScanOptions& options);
+
+    // With a value_width, the value_width bytes at every hit are copied out of
+    // the chunk that found it, so values() holds what the scanner matched.
+    std::vector<uintptr_t> run(const std::vector<MemoryRegion>& regions, size_t overlap, const ChunkScanner& scanner,
+                               size_t value_width = 0);
+
+    const ScanStats& stats() const { return stats_; }
+    // value_width bytes per hit of the last run, in hit order.
+    const std::vector<uint8_t>& values() const { return values_; }
+
+    static std::vector<ScanChunk> split_regions(const std::vector<MemoryRegion>& regions, size_t chunk_size, size_t overlap);
+
+private:
+    MemorySource& source_;
+    ScanOptions options_;
+    ScanStats stats_;
+    std::vector<uint8_t> values_;
+};
+
+} // namespace MemoryMCP
@@ -0,0 +1,340 @@
+#include "scan_kernel.h"
+#include <cmath>
+#include <limits>
+#include <fmt/format.h>
+
+namespace MemoryMCP {
+
+namespace {
+
+std::u32string decode_utf8(const std::string& text) {
+    std::u32string code_points;
+    size_t i = 0;
+    while (i < text.size()) {
+        uint8_t lead = static_cast<uint8_t>(text[i]);
+        size_t length = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+        if (length == 0 || i + length > text.size()) {
+            throw std::invalid_argument("Search string is not valid UTF-8");
+        }
+        char32_t code_point = length == 1 ? lead : lead & (0x7F >> length);
+        for (size_t k = 1; k < length; ++k) {
+            uint8_t continuation = static_cast<uint8_t>(text[i + k]);
+            if ((continuation & 0xC0) != 0x80) {
+                throw std::invalid_argument("Search string is not valid UTF-8");
+            }
+            code_point = (code_point << 6) | (continuation & 0x3F);
+        }
+        static const char32_t minimum[] = {0, 0, 0x80, 0x800, 0x10000};
+        if (code_point < minimum[length] || code_point > 0x10FFFF || (code_point >= 0xD800 && code_point <= 0xDFFF)) {
+            throw std::invalid_argument("Search string is not valid UTF-8");
+        }
+        code_points.push_back(code_point);
+        i += length;
+    }
+    return code_points;
+}
+
+bool is_ascii_letter(char32_t c) {
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+}
+
+} // namespace
+
+StringKernel::StringKernel(const std::string& value, const std::vector<StringEncoding>& encodings, bool ignore_case)
+    : ignore_case_(ignore_case) {
+    if (value.empty()) {
+        throw std::invalid_argument("Search string is empty");
+    }
+    if (encodings.empty()) {
+        throw std::invalid_argument("No string encoding selected");
+    }
+    std::u32string code_points = decode_utf8(value);
+
+    std::vector<StringEncoding> unique = encodings;
+    std::sort(unique.begin(), unique.end());
+    unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+
+    for (StringEncoding encoding : unique) {
+        Needle needle;
+        // Appends one code unit of the given width little-endian; ASCII
+        // letters only ever live in the low byte.
+        auto put = [&](uint32_t unit, size_t width, bool letter) {
+            for (size_t k = 0; k < width; ++k) {
+                uint8_t fold = (k == 0 && letter && ignore_case) ? 0x20 : 0;
+                needle.bytes.push_back(static_cast<uint8_t>(unit >> (8 * k)) | fold);
+                needle.fold.push_back(fold);
+            }
+        };
+
+        for (char32_t c : code_points) {
+            bool letter = is_ascii_letter(c);
+            if (encoding == StringEncoding::UTF8) {
+                if (c < 0x80) {
+                    put(c, 1, letter);
+                } else if (c < 0x800) {
+                    put(0xC0 | (c >> 6), 1, false);
+                    put(0x80 | (c & 0x3F), 1, false);
+                } else if (c < 0x10000) {
+                    put(0xE0 | (c >> 12), 1, false);
+                    put(0x80 | ((c >> 6) & 0x3F), 1, false);
+                    put(0x80 | (c & 0x3F), 1, false);
+                } else {
+                    put(0xF0 | (c >> 18), 1, false);
+                    put(0x80 | ((c >> 12) & 0x3F), 1, false);
+                    put(0x80 | ((c >> 6) & 0x3F), 1, false);
+                    put(0x80 | (c & 0x3F), 1, false);
+                }
+            } else if (encoding == StringEncoding::UTF16LE) {
+                if (c < 0x10000) {
+                    put(c, 2, letter);
+                } else {
+                    put(0xD800 + ((c - 0x10000) >> 10), 2, false);
+                    put(0xDC00 + ((c - 0x10000) & 0x3FF), 2, false);
+                }
+            } else {
+                put(c, 4, letter);
+            }
+        }
+
+        needle.last_offset = needle.bytes.size() - 1;
+        while (needle.last_offset > 0 && needle.bytes[needle.last_offset] == 0) {
+            needle.last_offset--;
+        }
+        needles_.push_back(std::move(needle));
+    }
+}
+
+size_t StringKernel::width() const {
+    size_t width = 0;
+    for (const Needle& needle : needles_) {
+        width = (std::max)(width, needle.bytes.size());
+    }
+    return width;
+}
+
+size_t StringKernel::min_width() const {
+    size_t width = SIZE_MAX;
+    for (const Needle& needle : needles_) {
+        width = (std::min)(width, needle.bytes.size());
+    }
+    return width;
+}
+
+bool StringKernel::matches(const Needle& needle, const uint8_t* data) const {
+    size_t size = needle.bytes.size();
+    if (!ignore_case_) {
+        return std::memcmp(data, needle.bytes.data(), size) == 0;
+    }
+
+    // Eight bytes at a time: (memory | fold) must equal the folded needle.
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t bytes, fold, expected;
+        std::memcpy(&bytes, data + i, 8);
+        std::memcpy(&fold, needle.fold.data() + i, 8);
+        std::memcpy(&expected, needle.bytes.data() + i, 8);
+        if ((bytes | fold) != expected) {
+            return false;
+        }
+    }
+    for (; i < size; ++i) {
+        if ((data[i] | needle.fold[i]) != needle.bytes[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void StringKernel::operator()(uintptr_t base, const uint8_t* data, size_t bytes_read, size_t scan_limit,
+                              std::vector<uintptr_t>& out) const {
+    simd::NeedleAnchors anchors[simd::MAX_ANCHOR_NEEDLES];
+    for (size_t n = 0; n < needles_.size(); ++n) {
+        const Needle& needle = needles_[n];
+        size_t size = needle.bytes.size();
+        size_t limit = bytes_read < size ? 0 : (std::min)(scan_limit, bytes_read - size + 1);
+        anchors[n] = {needle.bytes[0], needle.fold[0], needle.bytes[needle.last_offset], needle.fold[needle.last_offset],
+                      needle.last_offset, limit};
+    }
+
+    thread_local std::vector<uint64_t> candidates;
+    candidates.clear();
+    simd::active_kernels().find_anchors(data, anchors, needles_.size(), candidates);
+
+    // Candidates come in offset order; an offset that matches several
+    // encodings (a one-letter needle followed by zeros) is reported once.
+    size_t last_hit = SIZE_MAX;
+    for (uint64_t candidate : candidates) {
+        size_t offset = static_cast<size_t>(candidate >> 2);
+        if (offset != last_hit && matches(needles_[candidate & 3], data + offset)) {
+            out.push_back(base + offset);
+            last_hit = offset;
+        }
+    }
+}
+
+namespace {
+
+template <typename T>
+T parse_bound(const std::string& text, ValueType value_type, const char* what) {
+    T bound;
+    if (!parse_value(text, bound)) {
+        throw std::invalid_argument("Invalid " + value_type_to_string(value_type) + " " + what + ": " + text);
+    }
+    if constexpr (std::is_floating_point_v<T>) {
+        if (std::isnan(bound)) {
+            throw std::invalid_argument(std::string("NaN is not a valid ") + what);
+        }
+    }
+    return bound;
+}
+
+template <typename T>
+constexpr InRange<T> empty_range() {
+    return {T(1), T(0), false};
+}
+
+} // namespace
+
+template <typename T>
+InRange<T> condition_range(const std::string& value, ValueType value_type, const ScanCondition& condition) {
+    using limits = std::numeric_limits<T>;
+    const std::string name = scan_predicate_to_string(condition.predicate);
+    T target = parse_bound<T>(value, value_type, "value");
+
+    switch (condition.predicate) {
+        case ScanPredicate::EQUAL:
+            return {target, target, false};
+
+        case ScanPredicate::NOT_EQUAL:
+            return {target, target, true};
+
+        case ScanPredicate::LESS:
+            if constexpr (std::is_integral_v<T>) {
+                return target == limits::min() ? empty_range<T>() : InRange<T>{limits::min(), T(target - 1), false};
+            } else {
+                T below = std::nextafter(target, -limits::infinity());
+                return target == -limits::infinity() ? empty_range<T>() : InRange<T>{-limits::infinity(), below, false};
+            }
+
+        case ScanPredicate::GREATER:
+            if constexpr (std::is_integral_v<T>) {
+                return target == limits::max() ? empty_range<T>() : InRange<T>{T(target + 1), limits::max(), false};
+            } else {
+                T above = std::nextafter(target, limits::infinity());
+                return target == limits::infinity() ? empty_range<T>() : InRange<T>{above, limits::infinity(), false};
+            }
+
+        case ScanPredicate::BETWEEN: {
+            if (condition.upper.empty()) {
+                throw std::invalid_argument("between needs an upper bound");
+            }
+            T upper = parse_bound<T>(condition.upper, value_type, "upper bound");
+            if (upper < target) {
+                throw std::invalid_argument("between: upper bound " + condition.upper + " is below " + value);
+            }
+            return {target, upper, false};
+        }
+
+        case ScanPredicate::EPSILON:
+        case ScanPredicate::ROUNDED:
+            if constexpr (std::is_integral_v<T>) {
+                throw std::invalid_argument(name + " applies to float types; use between for " +
+                                            value_type_to_string(value_type));
+            } else if (condition.predicate == ScanPredicate::EPSILON) {
+                if (!(condition.epsilon >= 0.0) || std::isinf(condition.epsilon)) {
+                    throw std::invalid_argument("epsilon must be a finite non-negative number");
+                }
+                T epsilon = static_cast<T>(condition.epsilon);
+                return {target - epsilon, target + epsilon, false};
+            } else {
+                if (condition.digits < 0 || condition.digits > limits::max_digits10) {
+                    throw std::invalid_argument("rounded: digits must be between 0 and " +
+                                                std::to_string(limits::max_digits10));
+                }
+                // round() takes halves away from zero, so the half-way point on
+                // the far side of zero already rounds to the next value.
+                double center = static_cast<double>(target);
+                double half = 0.5 * std::pow(10.0, -condition.digits);
+                double lo = center - half;
+                double hi = center + half;
+                if (center >= 0.0) {
+                    hi = std::nextafter(hi, -std::numeric_limits<double>::infinity());
+                }
+                if (center <= 0.0) {
+                    lo = std::nextafter(lo, std::numeric_limits<double>::infinity());
+                }
+                return {static_cast<T>(lo), static_cast<T>(hi), false};
+            }
+
+        default:
+            throw std::invalid_argument("Unknown scan predicate");
+    }
+}
+
+template InRange<int32_t> condition_range<int32_t>(const std::string&, ValueType, const ScanCondition&);
+template InRange<int64_t> condition_range<int64_t>(const std::string&, ValueType, const ScanCondition&);
+template InRange<float> condition_range<float>(const std::string&, ValueType, const ScanCondition&);
+template InRange<double> condition_range<double>(const std::string&, ValueType, const ScanCondition&);
+
+CompiledKernel compile_kernel(const std::string& value, ValueType value_type, const ScanCondition& condition) {
+    if (value_type == ValueType::STRING) {
+        if (condition.predicate != ScanPredicate::EQUAL) {
+            throw std::invalid_argument("Predicate " + scan_predicate_to_string(condition.predicate) +
+                                        " needs a numeric value type");
+        }
+        if (condition.alignment > 1) {
+            throw std::invalid_argument("alignment applies to numeric value types");
+        }
+        StringKernel kernel(value, condition.encodings, condition.ignore_case);
+        return {kernel, kernel.width(), 1, {}, kernel.min_width()};
+    }
+
+    return dispatch_numeric_type(value_type, [&](auto tag) -> CompiledKernel {
+        using T = decltype(tag);
+        size_t alignment = condition.alignment == 0 ? sizeof(T) : condition.alignment;
+        return dispatch_alignment(alignment, [&](auto align_tag) -> CompiledKernel {
+            constexpr size_t Alignment = decltype(align_tag)::value;
+            if (condition.predicate != ScanPredicate::EQUAL) {
+                ScanKernel<T, InRange<T>, Alignment> kernel(condition_range<T>(value, value_type, condition));
+                return {kernel, kernel.width(), kernel.alignment()};
+            }
+
+            T target;
+            if (!parse_value(value, target)) {
+                throw std::invalid_argument("Invalid " + value_type_to_string(value_type) + " value: " + value);
+            }
+            ScanKernel<T, BitwiseEqual<T>, Alignment> kernel(BitwiseEqual<T>{target});
+            std::vector<uint8_t> value_bytes(sizeof(T));
+            std::memcpy(value_bytes.data(), &target, sizeof(T));
+            return {kernel, kernel.width(), kernel.alignment(), std::move(value_bytes)};
+        });
+    });
+}
+
+std::string format_value(const uint8_t* bytes, ValueType value_type) {
+    return dispatch_numeric_type(value_type, [&](auto tag) {
+        using T = decltype(tag);
+        T value;
+        std::memcpy(&value, bytes, sizeof(T));
+        return fmt::format("{}", value);
+    });
+}
+
+ValueComparator compile_comparator(CompareOp op, const std::string& operand, ValueType value_type) {
+    return dispatch_numeric_type(value_type, [&](auto tag) -> ValueComparator {
+        using T = decltype(tag);
+        T step = parse_compare_operand<T>(op, operand, value_type);
+        return dispatch_compare_op(op, [&](auto op_tag) -> ValueComparator {
+            constexpr CompareOp Op = decltype(op_tag)::value;
+            return [step](const uint8_t* previous, const uint8_t* current) {
+                T old_value;
+                T new_value;
+                std::memcpy(&old_value, previous, sizeof(T));
+                std::memcpy(&new_value, current, sizeof(T));
+                return compare_values<Op, T>(old_value, new_value, step);
+            };
+        });
+    });
+}
+
+} // namespace MemoryMCP
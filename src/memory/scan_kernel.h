@@ -0,0 +1,279 @@
+#pragma once
+#include "types.h"
+#include "scan_engine.h"
+#include "simd_kernels.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace MemoryMCP {
+
+// Parses text into the native representation of T with std::from_chars.
+// Integers accept an optional 0x prefix for hexadecimal input.
+template <typename T>
+bool parse_value(const std::string& text, T& out) {
+    const char* first = text.data();
+    const char* last = text.data() + text.size();
+    std::from_chars_result result;
+
+    if constexpr (std::is_integral_v<T>) {
+        bool negative = first != last && *first == '-';
+        const char* digits = negative ? first + 1 : first;
+        if (last - digits > 2 && digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X')) {
+            std::make_unsigned_t<T> magnitude = 0;
+            result = std::from_chars(digits + 2, last, magnitude, 16);
+            out = static_cast<T>(negative ? 0 - magnitude : magnitude);
+        } else {
+            result = std::from_chars(first, last, out);
+        }
+    } else {
+        if (first != last && *first == '+') {
+            ++first;
+        }
+        result = std::from_chars(first, last, out);
+    }
+
+    return result.ec == std::errc() && result.ptr == last;
+}
+
+// Calls f with a value of the native type behind a numeric ValueType, so the
+// type switch happens once per scan instead of once per candidate.
+template <typename F>
+decltype(auto) dispatch_numeric_type(ValueType type, F&& f) {
+    switch (type) {
+        case ValueType::INT:
+        case ValueType::INT32: return f(int32_t{});
+        case ValueType::INT64: return f(int64_t{});
+        case ValueType::FLOAT:
+        case ValueType::FLOAT32: return f(float{});
+        case ValueType::FLOAT64: return f(double{});
+        default: throw std::invalid_argument("Not a numeric value type: " + value_type_to_string(type));
+    }
+}
+
+// Matches the exact in-memory representation of target (bitwise for floats).
+template <typename T>
+struct BitwiseEqual {
+    T target;
+
+    bool operator()(const uint8_t* candidate) const {
+        return std::memcmp(candidate, &target, sizeof(T)) == 0;
+    }
+};
+
+template <typename Predicate>
+struct is_bitwise_equal : std::false_type {};
+
+template <typename T>
+struct is_bitwise_equal<BitwiseEqual<T>> : std::true_type {};
+
+// Matches values in [lo, hi], or outside it when negate is set. Every
+// relational, tolerance and rounding predicate lowers to this form; NaN is
+// never inside a range.
+template <typename T>
+struct InRange {
+    T lo;
+    T hi;
+    bool negate;
+
+    bool operator()(const uint8_t* candidate) const {
+        T current;
+        std::memcpy(&current, candidate, sizeof(T));
+        bool inside = current >= lo && current <= hi;
+        return inside != negate;
+    }
+};
+
+template <typename Predicate>
+struct is_in_range : std::false_type {};
+
+template <typename T>
+struct is_in_range<InRange<T>> : std::true_type {};
+
+// Scans a buffer for elements of type T that satisfy Predicate, testing every
+// Alignment-th address. Equality and ranges on 4- and 8-byte types run on the
+// SIMD kernels: the element-aligned ones when Alignment is at least sizeof(T),
+// the byte-granular ones otherwise, with hits off the stride dropped after.
+// Everything else is a scalar loop the compiler specializes.
+template <typename T, typename Predicate, size_t Alignment = 1>
+class ScanKernel {
+    static_assert(Alignment > 0 && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+
+public:
+    explicit ScanKernel(Predicate predicate) : predicate_(predicate) {}
+
+    static constexpr size_t width() { return sizeof(T); }
+    static constexpr size_t alignment() { return Alignment; }
+
+    // Appends the address of every match starting before scan_limit to out.
+    void operator()(uintptr_t base, const uint8_t* data, size_t bytes_read, size_t scan_limit,
+                    std::vector<uintptr_t>& out) const {
+        if (bytes_read < sizeof(T)) {
+            return;
+        }
+        size_t limit = (std::min)(scan_limit, bytes_read - sizeof(T) + 1);
+
+        constexpr bool simd_type = sizeof(T) == 4 || sizeof(T) == 8;
+        constexpr bool aligned = Alignment >= sizeof(T);
+        if constexpr (simd_type && (is_bitwise_equal<Predicate>::value || is_in_range<Predicate>::value)) {
+            const simd::KernelTable& kernels = simd::active_kernels();
+            size_t first = out.size();
+            if constexpr (is_in_range<Predicate>::value) {
+                simd::range_kernel<T>(kernels, aligned)(data, limit, base, predicate_.lo, predicate_.hi,
+                                                        predicate_.negate, out);
+            } else if constexpr (sizeof(T) == 4) {
+                uint32_t bits;
+                std::memcpy(&bits, &predicate_.target, sizeof(bits));
+                (aligned ? kernels.find_equal_32_aligned : kernels.find_equal_32)(data, limit, base, bits, out);
+            } else {
+                uint64_t bits;
+                std::memcpy(&bits, &predicate_.target, sizeof(bits));
+                (aligned ? kernels.find_equal_64_aligned : kernels.find_equal_64)(data, limit, base, bits, out);
+            }
+            if constexpr (Alignment != 1 && Alignment != sizeof(T)) {
+                out.erase(std::remove_if(out.begin() + static_cast<std::ptrdiff_t>(first), out.end(),
+                                         [](uintptr_t address) { return address % Alignment != 0; }),
+                          out.end());
+            }
+        } else {
+            size_t i = (Alignment - base % Alignment) % Alignment;
+            for (; i < limit; i += Alignment) {
+                if (predicate_(data + i)) {
+                    out.push_back(base + i);
+                }
+            }
+        }
+    }
+
+private:
+    Predicate predicate_;
+};
+
+// Calls f with std::integral_constant<size_t, alignment> for the supported
+// scan strides, so each stride gets its own kernel instantiation.
+template <typename F>
+decltype(auto) dispatch_alignment(size_t alignment, F&& f) {
+    switch (alignment) {
+        case 1: return f(std::integral_constant<size_t, 1>{});
+        case 2: return f(std::integral_constant<size_t, 2>{});
+        case 4: return f(std::integral_constant<size_t, 4>{});
+        case 8: return f(std::integral_constant<size_t, 8>{});
+        default: throw std::invalid_argument("alignment must be 1, 2, 4, 8 or natural");
+    }
+}
+
+// Calls f with std::integral_constant<CompareOp, op>, so comparison loops are
+// instantiated per op instead of switching per candidate.
+template <typename F>
+decltype(auto) dispatch_compare_op(CompareOp op, F&& f) {
+    switch (op) {
+        case CompareOp::CHANGED: return f(std::integral_constant<CompareOp, CompareOp::CHANGED>{});
+        case CompareOp::UNCHANGED: return f(std::integral_constant<CompareOp, CompareOp::UNCHANGED>{});
+        case CompareOp::INCREASED: return f(std::integral_constant<CompareOp, CompareOp::INCREASED>{});
+        case CompareOp::DECREASED: return f(std::integral_constant<CompareOp, CompareOp::DECREASED>{});
+        case CompareOp::INCREASED_BY: return f(std::integral_constant<CompareOp, CompareOp::INCREASED_BY>{});
+        case CompareOp::DECREASED_BY: return f(std::integral_constant<CompareOp, CompareOp::DECREASED_BY>{});
+        default: throw std::invalid_argument("Unknown compare op");
+    }
+}
+
+// Tests the current value of a candidate against its previous value. Changed
+// and unchanged compare representations; integer steps wrap like the target's
+// own arithmetic would.
+template <CompareOp Op, typename T>
+bool compare_values(T previous, T current, T operand) {
+    if constexpr (Op == CompareOp::CHANGED) {
+        return std::memcmp(&previous, &current, sizeof(T)) != 0;
+    } else if constexpr (Op == CompareOp::UNCHANGED) {
+        return std::memcmp(&previous, &current, sizeof(T)) == 0;
+    } else if constexpr (Op == CompareOp::INCREASED) {
+        return current > previous;
+    } else if constexpr (Op == CompareOp::DECREASED) {
+        return current < previous;
+    } else if constexpr (std::is_integral_v<T>) {
+        using U = std::make_unsigned_t<T>;
+        U step = static_cast<U>(operand);
+        U expected = Op == CompareOp::INCREASED_BY ? static_cast<U>(static_cast<U>(previous) + step)
+                                                   : static_cast<U>(static_cast<U>(previous) - step);
+        return static_cast<U>(current) == expected;
+    } else {
+        return current == (Op == CompareOp::INCREASED_BY ? previous + operand : previous - operand);
+    }
+}
+
+// Substring search for the STRING type. The needle is encoded once per
+// requested encoding; a SIMD prefilter tests the first and last significant
+// byte of every encoding in one pass over the buffer and only the surviving
+// offsets are compared in full. With ignore_case, ASCII letters are folded by
+// OR-ing 0x20 on both sides.
+class StringKernel {
+public:
+    // Throws std::invalid_argument if value is empty or not valid UTF-8.
+    StringKernel(const std::string& value,
+                 const std::vector<StringEncoding>& encodings = {StringEncoding::UTF8, StringEncoding::UTF16LE},
+                 bool ignore_case = false);
+
+    // Length of the longest and of the shortest encoded needle.
+    size_t width() const;
+    size_t min_width() const;
+
+    void operator()(uintptr_t base, const uint8_t* data, size_t bytes_read, size_t scan_limit,
+                    std::vector<uintptr_t>& out) const;
+
+private:
+    struct Needle {
+        std::vector<uint8_t> bytes;  // encoded needle, letters already folded
+        std::vector<uint8_t> fold;   // 0x20 where the byte is a folded ASCII letter
+        size_t last_offset;          // last non-zero byte, the second prefilter anchor
+    };
+
+    bool matches(const Needle& needle, const uint8_t* data) const;
+
+    std::vector<Needle> needles_;
+    bool ignore_case_;
+};
+
+// A kernel selected for one scan: the ValueType switch and value parsing happen
+// when it is built, the chunk scanner only runs the specialized loop.
+struct CompiledKernel {
+    ScanEngine::ChunkScanner scanner;
+    size_t pattern_length;
+    size_t alignment = 1;  // stride between tested addresses
+    std::vector<uint8_t> value_bytes = {};  // numeric eq: the encoding every hit holds
+    size_t min_length = 0;  // strings: the shortest needle, all a hit needs readable; 0 = pattern_length
+};
+
+CompiledKernel compile_kernel(const std::string& value, ValueType value_type,
+                              const ScanCondition& condition = ScanCondition());
+
+// Lowers a non-equality condition on value to the range the kernels test.
+// Throws std::invalid_argument for bounds that do not parse, NaN bounds and
+// predicates that do not apply to T.
+template <typename T>
+InRange<T> condition_range(const std::string& value, ValueType value_type, const ScanCondition& condition);
+
+// Text form of a raw numeric value, as returned in scan responses.
+std::string format_value(const uint8_t* bytes, ValueType value_type);
+
+// Tests one candidate given pointers to its previous and current raw value.
+using ValueComparator = std::function<bool(const uint8_t* previous, const uint8_t* current)>;
+
+// operand is only parsed for ops that take one.
+ValueComparator compile_comparator(CompareOp op, const std::string& operand, ValueType value_type);
+
+// Parses the operand of op for type T; zero for ops without one.
+template <typename T>
+T parse_compare_operand(CompareOp op, const std::string& operand, ValueType value_type) {
+    T value{};
+    if (compare_op_has_operand(op) && !parse_value(operand, value)) {
+        throw std::invalid_argument("Invalid " + value_type_to_string(value_type) + " operand for " +
+                                    compare_op_to_string(op) + ": " + operand);
+    }
+    return value;
+}
+
+} // namespace MemoryMCP
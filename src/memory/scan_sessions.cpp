@@ -0,0 +1,73 @@
+#include "scan_sessions.h"
+#include <cctype>
+#include <mutex>
+#include <stdexcept>
+#include <fmt/base.h>
+
+namespace MemoryMCP {
+
+namespace {
+
+bool valid_name(const std::string& name) {
+    if (name.empty() || name.size() > ScanSessions::MAX_NAME_LENGTH) {
+        return false;
+    }
+    for (char c : name) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_' && c != '.') {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+std::shared_ptr<MemoryScanner> ScanSessions::get(const std::string& name) {
+    const std::string& key = name.empty() ? std::string(DEFAULT_SESSION) : name;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = sessions_.find(key);
+        if (it != sessions_.end()) {
+            return it->second;
+        }
+    }
+
+    if (!valid_name(key)) {
+        throw std::invalid_argument("Invalid session name: " + key);
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = sessions_.find(key);
+    if (it != sessions_.end()) {
+        return it->second;
+    }
+    if (sessions_.size() >= MAX_SESSIONS) {
+        throw std::invalid_argument("Too many sessions; close one first");
+    }
+    auto session = std::make_shared<MemoryScanner>();
+    sessions_.emplace(key, session);
+    fmt::print(stderr, "[INFO] Session {} opened\n", key);
+    return session;
+}
+
+bool ScanSessions::close(const std::string& name) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (sessions_.erase(name.empty() ? std::string(DEFAULT_SESSION) : name) == 0) {
+        return false;
+    }
+    fmt::print(stderr, "[INFO] Session {} closed\n", name.empty() ? DEFAULT_SESSION : name);
+    return true;
+}
+
+std::vector<SessionInfo> ScanSessions::list() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::vector<SessionInfo> infos;
+    infos.reserve(sessions_.size());
+    for (const auto& entry : sessions_) {
+        SessionInfo info = entry.second->info();
+        info.name = entry.first;
+        infos.push_back(std::move(info));
+    }
+    return infos;
+}
+
+} // namespace MemoryMCP
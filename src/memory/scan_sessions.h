@@ -0,0 +1,35 @@
+#pragma once
+#include "types.h"
+#include "memory_scanner.h"
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace MemoryMCP {
+
+// Named scan sessions, so clients working on different processes keep their
+// own results. A session is created by the first call that names it; calls
+// that name none share DEFAULT_SESSION. Callers hold a session through its
+// shared_ptr, so closing one never pulls it from under a running scan.
+class ScanSessions {
+public:
+    static constexpr const char* DEFAULT_SESSION = "default";
+    static constexpr size_t MAX_SESSIONS = 64;
+    static constexpr size_t MAX_NAME_LENGTH = 64;
+
+    // The session called name, created if needed; an empty name means
+    // DEFAULT_SESSION. Throws std::invalid_argument for names other than
+    // letters, digits, '-', '_' and '.', or when MAX_SESSIONS are open.
+    std::shared_ptr<MemoryScanner> get(const std::string& name);
+    // False if there is no such session.
+    bool close(const std::string& name);
+    std::vector<SessionInfo> list() const;
+
+private:
+    mutable std::shared_mutex mutex_;
+    std::map<std::string, std::shared_ptr<MemoryScanner>> sessions_;
+};
+
+} // namespace MemoryMCP
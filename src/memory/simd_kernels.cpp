@@ -0,0 +1,630 @@
+#include "simd_kernels.h"
+#include "bit_ops.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define MEMORY_MCP_X86_64 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+// Kernels for wider instruction sets are compiled per function, so the rest of
+// the binary keeps the baseline target and only runs them after detect_isa().
+#if defined(__GNUC__) || defined(__clang__)
+#define MEMORY_MCP_TARGET(isa) __attribute__((target(isa)))
+#else
+#define MEMORY_MCP_TARGET(isa)
+#endif
+
+namespace MemoryMCP {
+namespace simd {
+
+namespace {
+
+// Bit i of mask set means a match at address + i.
+inline void emit_mask(uint64_t mask, uintptr_t address, std::vector<uintptr_t>& out) {
+    while (mask != 0) {
+        out.push_back(address + count_trailing_zeros(mask));
+        mask &= mask - 1;
+    }
+}
+
+// First offset from begin whose address base + offset is a multiple of Stride.
+template <size_t Stride>
+inline size_t first_offset(uintptr_t base, size_t begin) {
+    return begin + (Stride - (base + begin) % Stride) % Stride;
+}
+
+template <typename T, size_t Stride = 1>
+void find_equal_scalar(const uint8_t* data, size_t begin, size_t limit, uintptr_t base, T target, std::vector<uintptr_t>& out) {
+    for (size_t i = first_offset<Stride>(base, begin); i < limit; i += Stride) {
+        T current;
+        std::memcpy(&current, data + i, sizeof(T));
+        if (current == target) {
+            out.push_back(base + i);
+        }
+    }
+}
+
+template <size_t Stride = 1>
+void find_equal_32_scalar(const uint8_t* data, size_t limit, uintptr_t base, uint32_t target, std::vector<uintptr_t>& out) {
+    find_equal_scalar<uint32_t, Stride>(data, 0, limit, base, target, out);
+}
+
+template <size_t Stride = 1>
+void find_equal_64_scalar(const uint8_t* data, size_t limit, uintptr_t base, uint64_t target, std::vector<uintptr_t>& out) {
+    find_equal_scalar<uint64_t, Stride>(data, 0, limit, base, target, out);
+}
+
+template <typename T, size_t Stride = 1>
+void find_range_scalar(const uint8_t* data, size_t begin, size_t limit, uintptr_t base, T lo, T hi, bool negate,
+                       std::vector<uintptr_t>& out) {
+    for (size_t i = first_offset<Stride>(base, begin); i < limit; i += Stride) {
+        T current;
+        std::memcpy(&current, data + i, sizeof(T));
+        // Written so that NaN is outside every range.
+        bool inside = current >= lo && current <= hi;
+        if (inside != negate) {
+            out.push_back(base + i);
+        }
+    }
+}
+
+template <typename T, size_t Stride = 1>
+void find_range_scalar(const uint8_t* data, size_t limit, uintptr_t base, T lo, T hi, bool negate, std::vector<uintptr_t>& out) {
+    find_range_scalar<T, Stride>(data, 0, limit, base, lo, hi, negate, out);
+}
+
+// Bit j set when offset begin + j (j < 64, begin + j < needle.limit) matches the anchors.
+uint64_t anchor_mask_scalar(const uint8_t* data, size_t begin, size_t end, const NeedleAnchors& needle) {
+    uint64_t mask = 0;
+    end = (std::min)(end, needle.limit);
+    for (size_t i = begin; i < end; ++i) {
+        if ((data[i] | needle.first_fold) == needle.first &&
+            (data[i + needle.last_offset] | needle.last_fold) == needle.last) {
+            mask |= uint64_t(1) << (i - begin);
+        }
+    }
+    return mask;
+}
+
+// Emits the per-needle masks of one block as (offset << 2) | needle, in offset order.
+inline void emit_anchor_masks(const uint64_t* masks, size_t needle_count, size_t block, std::vector<uint64_t>& out) {
+    uint64_t any = 0;
+    for (size_t n = 0; n < needle_count; ++n) {
+        any |= masks[n];
+    }
+    while (any != 0) {
+        size_t j = count_trailing_zeros(any);
+        any &= any - 1;
+        for (size_t n = 0; n < needle_count; ++n) {
+            if ((masks[n] >> j) & 1) {
+                out.push_back(((block + j) << 2) | n);
+            }
+        }
+    }
+}
+
+size_t anchors_limit(const NeedleAnchors* needles, size_t needle_count) {
+    size_t limit = 0;
+    for (size_t n = 0; n < needle_count; ++n) {
+        limit = (std::max)(limit, needles[n].limit);
+    }
+    return limit;
+}
+
+// Finishes [begin, limit) of an anchor scan in 64-offset blocks without SIMD.
+void find_anchors_tail(const uint8_t* data, size_t begin, const NeedleAnchors* needles, size_t needle_count,
+                       std::vector<uint64_t>& out) {
+    size_t limit = anchors_limit(needles, needle_count);
+    uint64_t masks[MAX_ANCHOR_NEEDLES];
+    for (size_t block = begin; block < limit; block += 64) {
+        for (size_t n = 0; n < needle_count; ++n) {
+            masks[n] = anchor_mask_scalar(data, block, block + 64, needles[n]);
+        }
+        emit_anchor_masks(masks, needle_count, block, out);
+    }
+}
+
+void find_anchors_scalar(const uint8_t* data, const NeedleAnchors* needles, size_t needle_count, std::vector<uint64_t>& out) {
+    find_anchors_tail(data, 0, needles, needle_count, out);
+}
+
+void find_classified_scalar(const uint8_t* data, size_t begin, size_t limit, uintptr_t base, const ByteClasses& classes,
+                            std::vector<uintptr_t>& out) {
+    for (size_t i = begin; i < limit; ++i) {
+        if ((classes.low[data[i] & 15] & classes.high[data[i] >> 4]) != 0) {
+            out.push_back(base + i);
+        }
+    }
+}
+
+void find_classified_scalar(const uint8_t* data, size_t limit, uintptr_t base, const ByteClasses& classes,
+                            std::vector<uintptr_t>& out) {
+    find_classified_scalar(data, 0, limit, base, classes, out);
+}
+
+#ifdef MEMORY_MCP_X86_64
+
+// Every kernel below tests all byte offsets of a block: the k-th unaligned load
+// compares lanes starting at k, k + W, k + 2W, ... and its per-lane result is
+// shifted by k into one block-wide mask whose bit i means "match at offset i".
+// With Stride equal to the element width W only the one k that puts lanes on
+// element-aligned addresses is loaded, so each block costs one compare instead of W.
+
+template <size_t Stride = 1>
+MEMORY_MCP_TARGET("sse2")
+void find_equal_32_sse2(const uint8_t* data, size_t limit, uintptr_t base, uint32_t target, std::vector<uintptr_t>& out) {
+    const __m128i needle = _mm_set1_epi32(static_cast<int>(target));
+    size_t i = 0;
+
+    for (; i + 16 <= limit; i += 16) {
+        uint64_t mask = 0;
+        for (size_t k = first_offset<Stride>(base, 0); k < 4; k += Stride) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + k));
+            uint32_t lanes = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi32(block, needle)));
+            mask |= static_cast<uint64_t>(lanes & 0x1111u) << k;
+        }
+        emit_mask(mask, base + i, out);
+    }
+
+    find_equal_scalar<uint32_t, Stride>(data, i, limit, base, target, out);
+}
+
+template <size_t Stride = 1>
+MEMORY_MCP_TARGET("sse2")
+void find_equal_64_sse2(const uint8_t* data, size_t limit, uintptr_t base, uint64_t target, std::vector<uintptr_t>& out) {
+    const __m128i needle = _mm_set1_epi64x(static_cast<long long>(target));
+    size_t i = 0;
+
+    for (; i + 16 <= limit; i += 16) {
+        uint64_t mask = 0;
+        for (size_t k = first_offset<Stride>(base, 0); k < 8; k += Stride) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + k));
+            // SSE2 has no 64-bit compare: both 32-bit halves of a lane must match.
+            __m128i halves = _mm_cmpeq_epi32(block, needle);
+            __m128i lanes = _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+            uint32_t bits = static_cast<uint32_t>(_mm_movemask_epi8(lanes));
+            mask |= static_cast<uint64_t>(bits & 0x0101u) << k;
+        }
+        emit_mask(mask, base + i, out);
+    }
+
+    find_equal_scalar<uint64_t, Stride>(data, i, limit, base, target, out);
+}
+
+template <size_t Stride = 1>
+MEMORY_MCP_TARGET("avx2,bmi")
+void find_equal_32_avx2(const uint8_t* data, size_t limit, uintptr_t base, uint32_t target, std::vector<uintptr_t>& out) {
+    const __m256i needle = _mm256_set1_epi32(static_cast<int>(target));
+    size_t i = 0;
+
+    for (; i + 32 <= limit; i += 32) {
+        uint64_t mask = 0;
+        for (size_t k = first_offset<Stride>(base, 0); k < 4; k += Stride) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + k));
+            uint32_t lanes = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi32(block, needle)));
+            mask |= static_cast<uint64_t>(lanes & 0x11111111u) << k;
+        }
+        emit_mask(mask, base + i, out);
+    }
+
+    find_equal_scalar<uint32_t, Stride>(data, i, limit, base, target, out);
+}
+
+template <size_t Stride = 1>
+MEMORY_MCP_TARGET("avx2,bmi")
+void find_equal_64_avx2(const uint8_t* data, size_t limit, uintptr_t base, uint64_t target, std::vector<uintptr_t>& out) {
+    const __m256i needle = _mm256_set1_epi64x(static_cast<long long>(target));
+    size_t i = 0;
+
+    for (; i + 32 <= limit; i += 32) {
+        uint64_t mask = 0;
+        for (size_t k = first_offset<Stride>(base, 0); k < 8; k += Stride) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + k));
+            uint32_t lanes = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi64(block, needle)));
+            mask |= static_cast<uint64_t>(lanes & 0x01010101u) << k;
+        }
+        emit_mask(mask, base + i, out);
+    }
+
+    find_equal_scalar<uint64_t, Stride>(data, i, limit, base, target, out);
+}
+
+template <size_t Stride = 1>
+MEMORY_MCP_TARGET("avx512f,bmi,bmi2")
+void find_equal_32_avx512(const uint8_t* data, size_t limit, uintptr_t base, uint32_t target, std::vector<uintptr_t>& out) {
+    const __m512i needle = _mm512_set1_epi32(static_cast<int>(target));
+    size_t i = 0;
+
+    for (; i + 64 <= limit; i += 64) {
+        uint64_t mask = 0;
+        for (size_t k = first_offset<Stride>(base, 0); k < 4; k += Stride) {
+            __m512i block = _mm512_loadu_si512(reinterpret_cast<const void*>(data + i + k));
+            __mmask16 lanes = _mm512_cmpeq_epi32_mask(block, needle);
+            mask |= _pdep_u64(lanes, 0x1111111111111111ull) << k;
+        }
+        emit_mask(mask, base + i, out);
+    }
+
+    find_equal_scalar<uint32_t, Stride>(data, i, limit, base, target, out);
+}
+
+template <size_t Stride = 1>
+MEMORY_MCP_TARGET("avx512f,bmi,bmi2")
+void find_equal_64_avx512(const uint8_t* data, size_t limit, uintptr_t base, uint64_t target, std::vector<uintptr_t>& out) {
+    const __m512i needle = _mm512_set1_epi64(static_cast<long long>(target));
+    size_t i = 0;
+
+    for (; i + 64 <= limit; i += 64) {
+        uint64_t mask = 0;
+        for (size_t k = first_offset<Stride>(base, 0); k < 8; k += Stride) {
+            __m512i block = _mm512_loadu_si512(reinterpret_cast<const void*>(data + i + k));
+            __mmask8 lanes = _mm512_cmpeq_epi64_mask(block, needle);
+            mask |= _pdep_u64(lanes, 0x0101010101010101ull) << k;
+        }
+        emit_mask(mask, base + i, out);
+    }
+
+    find_equal_scalar<uint64_t, Stride>(data, i, limit, base, target, out);
+}
+
+// Range kernels compute a per-lane "inside [lo, hi]" mask with one compare
+// against each bound (integers test the complement, x < lo or x > hi, since
+// SSE2/AVX2 only have greater-than) and flip it when the range is negated.
+
+MEMORY_MCP_TARGET("sse2")
+inline __m128i inside_sse2(const uint8_t* p, int32_t lo, int32_t hi) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i outside = _mm_or_si128(_mm_cmplt_epi32(x, _mm_set1_epi32(lo)), _mm_cmpgt_epi32(x, _mm_set1_epi32(hi)));
+    return _mm_xor_si128(outside, _mm_set1_epi32(-1));
+}
+
+MEMORY_MCP_TARGET("sse2")
+inline __m128i inside_sse2(const uint8_t* p, float lo, float hi) {
+    __m128 x = _mm_loadu_ps(reinterpret_cast<const float*>(p));
+    return _mm_castps_si128(_mm_and_ps(_mm_cmpge_ps(x, _mm_set1_ps(lo)), _mm_cmple_ps(x, _mm_set1_ps(hi))));
+}
+
+MEMORY_MCP_TARGET("sse2")
+inline __m128i inside_sse2(const uint8_t* p, double lo, double hi) {
+    __m128d x = _mm_loadu_pd(reinterpret_cast<const double*>(p));
+    return _mm_castpd_si128(_mm_and_pd(_mm_cmpge_pd(x, _mm_set1_pd(lo)), _mm_cmple_pd(x, _mm_set1_pd(hi))));
+}
+
+// SSE2 has no 64-bit integer compare, so int64 ranges stay on the scalar loop at this level.
+template <typename T, size_t Stride = 1>
+MEMORY_MCP_TARGET("sse2")
+void find_range_sse2(const uint8_t* data, size_t limit, uintptr_t base, T lo, T hi, bool negate, std::vector<uintptr_t>& out) {
+    constexpr uint32_t lane_bits = sizeof(T) == 4 ? 0x1111u : 0x0101u;
+    const uint32_t flip = negate ? 0xFFFFu : 0u;
+    size_t i = 0;
+
+    for (; i + 16 <= limit; i += 16) {
+        uint64_t mask = 0;
+        for (size_t k = first_offset<Stride>(base, 0); k < sizeof(T); k += Stride) {
+            uint32_t lanes = static_cast<uint32_t>(_mm_movemask_epi8(inside_sse2(data + i + k, lo, hi)));
+            mask |= static_cast<uint64_t>((lanes ^ flip) & lane_bits) << k;
+        }
+        emit_mask(mask, base + i, out);
+    }
+
+    find_range_scalar<T, Stride>(data, i, limit, base, lo, hi, negate, out);
+}
+
+MEMORY_MCP_TARGET("avx2")
+inline __m256i inside_avx2(const uint8_t* p, int32_t lo, int32_t hi) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi32(_mm256_set1_epi32(lo), x), _mm256_cmpgt_epi32(x, _mm256_set1_epi32(hi)));
+    return _mm256_xor_si256(outside, _mm256_set1_epi32(-1));
+}
+
+MEMORY_MCP_TARGET("avx2")
+inline __m256i inside_avx2(const uint8_t* p, int64_t lo, int64_t hi) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi64(_mm256_set1_epi64x(lo), x), _mm256_cmpgt_epi64(x, _mm256_set1_epi64x(hi)));
+    return _mm256_xor_si256(outside, _mm256_set1_epi32(-1));
+}
+
+MEMORY_MCP_TARGET("avx2")
+inline __m256i inside_avx2(const uint8_t* p, float lo, float hi) {
+    __m256 x = _mm256_loadu_ps(reinterpret_cast<const float*>(p));
+    return _mm256_castps_si256(_mm256_and_ps(_mm256_cmp_ps(x, _mm256_set1_ps(lo), _CMP_GE_OQ),
+                                             _mm256_cmp_ps(x, _mm256_set1_ps(hi), _CMP_LE_OQ)));
+}
+
+MEMORY_MCP_TARGET("avx2")
+inline __m256i inside_avx2(const uint8_t* p, double lo, double hi) {
+    __m256d x = _mm256_loadu_pd(reinterpret_cast<const double*>(p));
+    return _mm256_castpd_si256(_mm256_and_pd(_mm256_cmp_pd(x, _mm256_set1_pd(lo), _CMP_GE_OQ),
+                                             _mm256_cmp_pd(x, _mm256_set1_pd(hi), _CMP_LE_OQ)));
+}
+
+template <typename T, size_t Stride = 1>
+MEMORY_MCP_TARGET("avx2,bmi")
+void find_range_avx2(const uint8_t* data, size_t limit, uintptr_t base, T lo, T hi, bool negate, std::vector<uintptr_t>& out) {
+    constexpr uint32_t lane_bits = sizeof(T) == 4 ? 0x11111111u : 0x01010101u;
+    const uint32_t flip = negate ? 0xFFFFFFFFu : 0u;
+    size_t i = 0;
+
+    for (; i + 32 <= limit; i += 32) {
+        uint64_t mask = 0;
+        for (size_t k = first_offset<Stride>(base, 0); k < sizeof(T); k += Stride) {
+            uint32_t lanes = static_cast<uint32_t>(_mm256_movemask_epi8(inside_avx2(data + i + k, lo, hi)));
+            mask |= static_cast<uint64_t>((lanes ^ flip) & lane_bits) << k;
+        }
+        emit_mask(mask, base + i, out);
+    }
+
+    find_range_scalar<T, Stride>(data, i, limit, base, lo, hi, negate, out);
+}
+
+MEMORY_MCP_TARGET("avx512f")
+inline uint32_t inside_avx512(const uint8_t* p, int32_t lo, int32_t hi) {
+    __m512i x = _mm512_loadu_si512(reinterpret_cast<const void*>(p));
+    return _mm512_cmpge_epi32_mask(x, _mm512_set1_epi32(lo)) & _mm512_cmple_epi32_mask(x, _mm512_set1_epi32(hi));
+}
+
+MEMORY_MCP_TARGET("avx512f")
+inline uint32_t inside_avx512(const uint8_t* p, int64_t lo, int64_t hi) {
+    __m512i x = _mm512_loadu_si512(reinterpret_cast<const void*>(p));
+    return _mm512_cmpge_epi64_mask(x, _mm512_set1_epi64(lo)) & _mm512_cmple_epi64_mask(x, _mm512_set1_epi64(hi));
+}
+
+MEMORY_MCP_TARGET("avx512f")
+inline uint32_t inside_avx512(const uint8_t* p, float lo, float hi) {
+    __m512 x = _mm512_loadu_ps(reinterpret_cast<const void*>(p));
+    return _mm512_cmp_ps_mask(x, _mm512_set1_ps(lo), _CMP_GE_OQ) & _mm512_cmp_ps_mask(x, _mm512_set1_ps(hi), _CMP_LE_OQ);
+}
+
+MEMORY_MCP_TARGET("avx512f")
+inline uint32_t inside_avx512(const uint8_t* p, double lo, double hi) {
+    __m512d x = _mm512_loadu_pd(reinterpret_cast<const void*>(p));
+    return _mm512_cmp_pd_mask(x, _mm512_set1_pd(lo), _CMP_GE_OQ) & _mm512_cmp_pd_mask(x, _mm512_set1_pd(hi), _CMP_LE_OQ);
+}
+
+template <typename T, size_t Stride = 1>
+MEMORY_MCP_TARGET("avx512f,bmi,bmi2")
+void find_range_avx512(const uint8_t* data, size_t limit, uintptr_t base, T lo, T hi, bool negate, std::vector<uintptr_t>& out) {
+    constexpr uint64_t lane_bits = sizeof(T) == 4 ? 0x1111111111111111ull : 0x0101010101010101ull;
+    const uint32_t flip = negate ? (sizeof(T) == 4 ? 0xFFFFu : 0xFFu) : 0u;
+    size_t i = 0;
+
+    for (; i + 64 <= limit; i += 64) {
+        uint64_t mask = 0;
+        for (size_t k = first_offset<Stride>(base, 0); k < sizeof(T); k += Stride) {
+            uint32_t lanes = inside_avx512(data + i + k, lo, hi) ^ flip;
+            mask |= _pdep_u64(lanes, lane_bits) << k;
+        }
+        emit_mask(mask, base + i, out);
+    }
+
+    find_range_scalar<T, Stride>(data, i, limit, base, lo, hi, negate, out);
+}
+
+// Anchor kernels load each block once for the first anchors of all needles and
+// once per needle for its last anchor; a needle whose limit falls inside the
+// block finishes that block on the scalar path so no load passes its end.
+
+MEMORY_MCP_TARGET("sse2")
+inline uint32_t anchor_bits_sse2(__m128i block, const uint8_t* last, const NeedleAnchors& needle) {
+    __m128i first = _mm_cmpeq_epi8(_mm_or_si128(block, _mm_set1_epi8(static_cast<char>(needle.first_fold))),
+                                   _mm_set1_epi8(static_cast<char>(needle.first)));
+    __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(last));
+    __m128i second = _mm_cmpeq_epi8(_mm_or_si128(tail, _mm_set1_epi8(static_cast<char>(needle.last_fold))),
+                                    _mm_set1_epi8(static_cast<char>(needle.last)));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(first, second)));
+}
+
+MEMORY_MCP_TARGET("sse2")
+void find_anchors_sse2(const uint8_t* data, const NeedleAnchors* needles, size_t needle_count, std::vector<uint64_t>& out) {
+    size_t limit = anchors_limit(needles, needle_count);
+    uint64_t masks[MAX_ANCHOR_NEEDLES];
+    size_t i = 0;
+
+    for (; i + 64 <= limit; i += 64) {
+        for (size_t n = 0; n < needle_count; ++n) {
+            masks[n] = 0;
+        }
+        for (size_t part = 0; part < 64; part += 16) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + part));
+            for (size_t n = 0; n < needle_count; ++n) {
+                const NeedleAnchors& needle = needles[n];
+                if (i + part + 16 <= needle.limit) {
+                    masks[n] |= static_cast<uint64_t>(anchor_bits_sse2(block, data + i + part + needle.last_offset, needle)) << part;
+                } else {
+                    masks[n] |= anchor_mask_scalar(data, i + part, i + part + 16, needle) << part;
+                }
+            }
+        }
+        emit_anchor_masks(masks, needle_count, i, out);
+    }
+
+    find_anchors_tail(data, i, needles, needle_count, out);
+}
+
+MEMORY_MCP_TARGET("avx2")
+inline uint32_t anchor_bits_avx2(__m256i block, const uint8_t* last, const NeedleAnchors& needle) {
+    __m256i first = _mm256_cmpeq_epi8(_mm256_or_si256(block, _mm256_set1_epi8(static_cast<char>(needle.first_fold))),
+                                      _mm256_set1_epi8(static_cast<char>(needle.first)));
+    __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(last));
+    __m256i second = _mm256_cmpeq_epi8(_mm256_or_si256(tail, _mm256_set1_epi8(static_cast<char>(needle.last_fold))),
+                                       _mm256_set1_epi8(static_cast<char>(needle.last)));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(first, second)));
+}
+
+// Also serves the AVX-512 level: byte compares on ZMM registers need AVX-512BW,
+// which detect_isa() does not require.
+MEMORY_MCP_TARGET("avx2,bmi")
+void find_anchors_avx2(const uint8_t* data, const NeedleAnchors* needles, size_t needle_count, std::vector<uint64_t>& out) {
+    size_t limit = anchors_limit(needles, needle_count);
+    uint64_t masks[MAX_ANCHOR_NEEDLES];
+    size_t i = 0;
+
+    for (; i + 64 <= limit; i += 64) {
+        for (size_t n = 0; n < needle_count; ++n) {
+            masks[n] = 0;
+        }
+        for (size_t part = 0; part < 64; part += 32) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + part));
+            for (size_t n = 0; n < needle_count; ++n) {
+                const NeedleAnchors& needle = needles[n];
+                if (i + part + 32 <= needle.limit) {
+                    masks[n] |= static_cast<uint64_t>(anchor_bits_avx2(block, data + i + part + needle.last_offset, needle)) << part;
+                } else {
+                    masks[n] |= anchor_mask_scalar(data, i + part, i + part + 32, needle) << part;
+                }
+            }
+        }
+        emit_anchor_masks(masks, needle_count, i, out);
+    }
+
+    find_anchors_tail(data, i, needles, needle_count, out);
+}
+
+// Nibble-table classification: one shuffle looks up the low nibble, one the
+// high nibble, and a byte is in the set when the looked-up buckets intersect.
+// SSE2 has no byte shuffle, so that level classifies on the scalar loop; the
+// AVX-512 level reuses this kernel, as ZMM byte shuffles need AVX-512BW.
+MEMORY_MCP_TARGET("avx2,bmi")
+void find_classified_avx2(const uint8_t* data, size_t limit, uintptr_t base, const ByteClasses& classes,
+                          std::vector<uintptr_t>& out) {
+    const __m256i low_table = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(classes.low)));
+    const __m256i high_table = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(classes.high)));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 64 <= limit; i += 64) {
+        uint64_t mask = 0;
+        for (size_t part = 0; part < 64; part += 32) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + part));
+            __m256i low = _mm256_shuffle_epi8(low_table, _mm256_and_si256(block, nibble));
+            __m256i high = _mm256_shuffle_epi8(high_table, _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble));
+            __m256i empty = _mm256_cmpeq_epi8(_mm256_and_si256(low, high), zero);
+            mask |= static_cast<uint64_t>(~static_cast<uint32_t>(_mm256_movemask_epi8(empty))) << part;
+        }
+        emit_mask(mask, base + i, out);
+    }
+
+    find_classified_scalar(data, i, limit, base, classes, out);
+}
+
+void cpuid(int leaf, int subleaf, unsigned regs[4]) {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuidex(info, leaf, subleaf);
+    for (int i = 0; i < 4; ++i) regs[i] = static_cast<unsigned>(info[i]);
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+uint64_t read_xcr0() {
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+
+#endif // MEMORY_MCP_X86_64
+
+const KernelTable SCALAR_KERNELS = {IsaLevel::SCALAR, find_equal_32_scalar, find_equal_64_scalar,
+                                    find_range_scalar<int32_t>, find_range_scalar<int64_t>,
+                                    find_range_scalar<float>, find_range_scalar<double>,
+                                    find_anchors_scalar, find_classified_scalar,
+                                    find_equal_32_scalar<4>, find_equal_64_scalar<8>,
+                                    find_range_scalar<int32_t, 4>, find_range_scalar<int64_t, 8>,
+                                    find_range_scalar<float, 4>, find_range_scalar<double, 8>};
+
+#ifdef MEMORY_MCP_X86_64
+const KernelTable SSE2_KERNELS = {IsaLevel::SSE2, find_equal_32_sse2, find_equal_64_sse2,
+                                  find_range_sse2<int32_t>, find_range_scalar<int64_t>,
+                                  find_range_sse2<float>, find_range_sse2<double>,
+                                  find_anchors_sse2, find_classified_scalar,
+                                  find_equal_32_sse2<4>, find_equal_64_sse2<8>,
+                                  find_range_sse2<int32_t, 4>, find_range_scalar<int64_t, 8>,
+                                  find_range_sse2<float, 4>, find_range_sse2<double, 8>};
+const KernelTable AVX2_KERNELS = {IsaLevel::AVX2, find_equal_32_avx2, find_equal_64_avx2,
+                                  find_range_avx2<int32_t>, find_range_avx2<int64_t>,
+                                  find_range_avx2<float>, find_range_avx2<double>,
+                                  find_anchors_avx2, find_classified_avx2,
+                                  find_equal_32_avx2<4>, find_equal_64_avx2<8>,
+                                  find_range_avx2<int32_t, 4>, find_range_avx2<int64_t, 8>,
+                                  find_range_avx2<float, 4>, find_range_avx2<double, 8>};
+const KernelTable AVX512_KERNELS = {IsaLevel::AVX512, find_equal_32_avx512, find_equal_64_avx512,
+                                    find_range_avx512<int32_t>, find_range_avx512<int64_t>,
+                                    find_range_avx512<float>, find_range_avx512<double>,
+                                    find_anchors_avx2, find_classified_avx2,
+                                    find_equal_32_avx512<4>, find_equal_64_avx512<8>,
+                                    find_range_avx512<int32_t, 4>, find_range_avx512<int64_t, 8>,
+                                    find_range_avx512<float, 4>, find_range_avx512<double, 8>};
+#endif
+
+} // namespace
+
+IsaLevel detect_isa() {
+#ifdef MEMORY_MCP_X86_64
+    unsigned leaf0[4], leaf1[4], leaf7[4] = {0, 0, 0, 0};
+    cpuid(0, 0, leaf0);
+    cpuid(1, 0, leaf1);
+    if (leaf0[0] >= 7) {
+        cpuid(7, 0, leaf7);
+    }
+
+    bool sse2 = (leaf1[3] & (1u << 26)) != 0;
+    bool osxsave = (leaf1[2] & (1u << 27)) != 0;
+    bool avx = (leaf1[2] & (1u << 28)) != 0;
+    bool bmi1 = (leaf7[1] & (1u << 3)) != 0;
+    bool avx2 = (leaf7[1] & (1u << 5)) != 0;
+    bool bmi2 = (leaf7[1] & (1u << 8)) != 0;
+    bool avx512f = (leaf7[1] & (1u << 16)) != 0;
+
+    // The OS must save the YMM (and for AVX-512 the opmask/ZMM) state on context switches.
+    uint64_t xcr0 = (osxsave && avx) ? read_xcr0() : 0;
+    bool ymm_enabled = (xcr0 & 0x6) == 0x6;
+    bool zmm_enabled = (xcr0 & 0xE6) == 0xE6;
+
+    if (avx512f && bmi1 && bmi2 && zmm_enabled) return IsaLevel::AVX512;
+    if (avx2 && bmi1 && ymm_enabled) return IsaLevel::AVX2;
+    if (sse2) return IsaLevel::SSE2;
+#endif
+    return IsaLevel::SCALAR;
+}
+
+const char* isa_name(IsaLevel level) {
+    switch (level) {
+        case IsaLevel::SCALAR: return "scalar";
+        case IsaLevel::SSE2: return "sse2";
+        case IsaLevel::AVX2: return "avx2";
+        case IsaLevel::AVX512: return "avx512";
+        default: return "unknown";
+    }
+}
+
+const KernelTable& kernels_for(IsaLevel level) {
+    switch (level) {
+#ifdef MEMORY_MCP_X86_64
+        case IsaLevel::SSE2: return SSE2_KERNELS;
+        case IsaLevel::AVX2: return AVX2_KERNELS;
+        case IsaLevel::AVX512: return AVX512_KERNELS;
+#endif
+        default: return SCALAR_KERNELS;
+    }
+}
+
+const KernelTable& active_kernels() {
+    static const KernelTable& kernels = kernels_for(detect_isa());
+    return kernels;
+}
+
+} // namespace simd
+} // namespace MemoryMCP
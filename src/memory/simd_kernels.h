@@ -0,0 +1,104 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace MemoryMCP {
+namespace simd {
+
+enum class IsaLevel {
+    SCALAR,
+    SSE2,
+    AVX2,
+    AVX512
+};
+
+// Appends base + i to out for every offset i < limit where the 4 (or 8) bytes at
+// data + i equal target bitwise. data must be readable for limit + 3 (or + 7) bytes.
+using FindEqual32 = void (*)(const uint8_t* data, size_t limit, uintptr_t base, uint32_t target, std::vector<uintptr_t>& out);
+using FindEqual64 = void (*)(const uint8_t* data, size_t limit, uintptr_t base, uint64_t target, std::vector<uintptr_t>& out);
+
+// Appends base + i for every offset i < limit whose element of type T lies in
+// [lo, hi], or outside it when negate is set. Integers compare signed; NaN is
+// never inside. data must be readable for limit + sizeof(T) - 1 bytes.
+template <typename T>
+using FindRange = void (*)(const uint8_t* data, size_t limit, uintptr_t base, T lo, T hi, bool negate, std::vector<uintptr_t>& out);
+
+// First/last byte anchors of one needle for the substring prefilter. A byte
+// matches an anchor when (byte | fold) == value, where fold is 0x20 for a
+// case-insensitive ASCII letter and 0 otherwise.
+struct NeedleAnchors {
+    uint8_t first;
+    uint8_t first_fold;
+    uint8_t last;
+    uint8_t last_fold;
+    size_t last_offset;  // position of the last anchor within the needle
+    size_t limit;        // candidates start before limit
+};
+
+constexpr size_t MAX_ANCHOR_NEEDLES = 4;
+
+// Appends (i << 2) | n in ascending order for every offset i < needles[n].limit
+// whose anchor bytes match needle n; up to MAX_ANCHOR_NEEDLES needles are
+// tested in the same pass over data. data must be readable for
+// needles[n].limit + needles[n].last_offset bytes.
+using FindAnchors = void (*)(const uint8_t* data, const NeedleAnchors* needles, size_t needle_count, std::vector<uint64_t>& out);
+
+// A byte set for the classifier: byte b is in the set when
+// (low[b & 15] & high[b >> 4]) != 0. Up to 8 buckets (bits) describe a set;
+// a bucket holds the cross product of its nibbles, so sets that need more
+// than 8 buckets may gain extra members.
+struct ByteClasses {
+    uint8_t low[16];
+    uint8_t high[16];
+};
+
+// Appends base + i for every offset i < limit whose byte is in classes.
+using FindClassified = void (*)(const uint8_t* data, size_t limit, uintptr_t base, const ByteClasses& classes,
+                                std::vector<uintptr_t>& out);
+
+struct KernelTable {
+    IsaLevel level;
+    FindEqual32 find_equal_32;
+    FindEqual64 find_equal_64;
+    FindRange<int32_t> find_range_i32;
+    FindRange<int64_t> find_range_i64;
+    FindRange<float> find_range_f32;
+    FindRange<double> find_range_f64;
+    FindAnchors find_anchors;
+    FindClassified find_classified;
+    // The same searches restricted to offsets whose address base + i is a
+    // multiple of the element size.
+    FindEqual32 find_equal_32_aligned;
+    FindEqual64 find_equal_64_aligned;
+    FindRange<int32_t> find_range_i32_aligned;
+    FindRange<int64_t> find_range_i64_aligned;
+    FindRange<float> find_range_f32_aligned;
+    FindRange<double> find_range_f64_aligned;
+};
+
+// The range kernel of a table for T, element-aligned offsets only if aligned.
+template <typename T>
+FindRange<T> range_kernel(const KernelTable& table, bool aligned = false) {
+    if constexpr (std::is_same_v<T, int32_t>) return aligned ? table.find_range_i32_aligned : table.find_range_i32;
+    else if constexpr (std::is_same_v<T, int64_t>) return aligned ? table.find_range_i64_aligned : table.find_range_i64;
+    else if constexpr (std::is_same_v<T, float>) return aligned ? table.find_range_f32_aligned : table.find_range_f32;
+    else {
+        static_assert(std::is_same_v<T, double>, "No range kernel for this type");
+        return aligned ? table.find_range_f64_aligned : table.find_range_f64;
+    }
+}
+
+// Highest instruction set supported by both the CPU and the OS.
+IsaLevel detect_isa();
+const char* isa_name(IsaLevel level);
+
+// Kernels for a given level; levels above detect_isa() must not be called.
+const KernelTable& kernels_for(IsaLevel level);
+
+// Kernels for detect_isa(), resolved once on first use.
+const KernelTable& active_kernels();
+
+} // namespace simd
+} // namespace MemoryMCP
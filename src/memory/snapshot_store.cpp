@@ -0,0 +1,245 @@
+#include "snapshot_store.h"
+#include "scan_engine.h"
+#include "scan_kernel.h"
+#include "page_hash.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fmt/base.h>
+
+namespace MemoryMCP {
+
+namespace {
+
+// Applies visit(word_index, mask) to the bitmap words covering slots [first, last).
+template <typename F>
+void for_each_word(size_t first, size_t last, F&& visit) {
+    if (first >= last) {
+        return;
+    }
+    size_t first_word = first / 64;
+    size_t last_word = (last - 1) / 64;
+    for (size_t w = first_word; w <= last_word; ++w) {
+        uint64_t mask = ~uint64_t(0);
+        if (w == first_word) {
+            mask &= ~uint64_t(0) << (first % 64);
+        }
+        if (w == last_word && last % 64 != 0) {
+            mask &= ~uint64_t(0) >> (64 - last % 64);
+        }
+        visit(w, mask);
+    }
+}
+
+} // namespace
+
+SnapshotStore::SnapshotStore(ValueType value_type, const std::vector<MemoryRegion>& regions)
+    : value_type_(value_type), value_width_(value_type_size(value_type)) {
+    if (value_width_ == 0) {
+        throw std::invalid_argument("Snapshots need a numeric value type");
+    }
+
+    std::vector<MemoryRegion> sorted = regions;
+    std::sort(sorted.begin(), sorted.end(),
+              [](const MemoryRegion& a, const MemoryRegion& b) { return a.base < b.base; });
+
+    size_t data_size = 0;
+    size_t page_count = 0;
+    for (const MemoryRegion& region : sorted) {
+        regions_.push_back({region.base, region.size, data_size, bitmap_words_, page_count});
+        data_size += (region.size + 63) & ~size_t(63);
+        bitmap_words_ += (region.size / value_width_ + 63) / 64;
+        page_count += (region.size + SNAPSHOT_PAGE_SIZE - 1) / SNAPSHOT_PAGE_SIZE;
+    }
+
+    bitmap_start_ = data_size;
+    hashes_start_ = bitmap_start_ + bitmap_words_ * sizeof(uint64_t);
+    file_ = MappedFile::create_temporary(hashes_start_ + page_count * sizeof(uint64_t));
+}
+
+const SnapshotRegion& SnapshotStore::region_at(uint64_t address) const {
+    auto it = std::upper_bound(regions_.begin(), regions_.end(), address,
+                               [](uint64_t a, const SnapshotRegion& region) { return a < region.base; });
+    return *(it - 1);
+}
+
+ScanOptions SnapshotStore::page_aligned(const ScanOptions& options) const {
+    // Chunks start on a page boundary, which is also a bitmap word boundary
+    // (64 slots of at most 8 bytes), so parallel workers never share a word.
+    ScanOptions aligned = options;
+    size_t chunk_size = aligned.chunk_size == 0 ? SCAN_CHUNK_SIZE : aligned.chunk_size;
+    aligned.chunk_size = (chunk_size + SNAPSHOT_PAGE_SIZE - 1) / SNAPSHOT_PAGE_SIZE * SNAPSHOT_PAGE_SIZE;
+    return aligned;
+}
+
+std::vector<MemoryRegion> SnapshotStore::memory_regions(bool with_candidates_only) const {
+    const uint64_t* words = bitmap();
+    std::vector<MemoryRegion> regions;
+    regions.reserve(regions_.size());
+    for (const SnapshotRegion& region : regions_) {
+        size_t word_count = (region.size / value_width_ + 63) / 64;
+        bool has_candidates = !with_candidates_only;
+        for (size_t w = 0; w < word_count && !has_candidates; ++w) {
+            has_candidates = words[region.bitmap_offset + w] != 0;
+        }
+        if (has_candidates) {
+            regions.push_back({static_cast<uintptr_t>(region.base), region.size, PROTECTION_READ});
+        }
+    }
+    return regions;
+}
+
+size_t SnapshotStore::count_candidates() const {
+    const uint64_t* words = bitmap();
+    size_t count = 0;
+    for (size_t i = 0; i < bitmap_words_; ++i) {
+        count += popcount(words[i]);
+    }
+    return count;
+}
+
+ScanStats SnapshotStore::capture(MemorySource& source, const ScanOptions& options) {
+    ScanEngine engine(source, page_aligned(options));
+    uint64_t* words = bitmap();
+    uint64_t* hashes = page_hashes();
+
+    engine.run(memory_regions(false), 0,
+        [&](uintptr_t address, const uint8_t* data, size_t, size_t scan_limit, std::vector<uintptr_t>&) {
+            const SnapshotRegion& region = region_at(address);
+            size_t offset = static_cast<size_t>(address - region.base);
+            std::memcpy(file_.data() + region.data_offset + offset, data, scan_limit);
+
+            uint64_t* region_words = words + region.bitmap_offset;
+            for_each_word((offset + value_width_ - 1) / value_width_, (offset + scan_limit) / value_width_,
+                          [&](size_t w, uint64_t mask) { region_words[w] |= mask; });
+
+            for (size_t page = 0; page + SNAPSHOT_PAGE_SIZE <= scan_limit; page += SNAPSHOT_PAGE_SIZE) {
+                hashes[region.page_offset + (offset + page) / SNAPSHOT_PAGE_SIZE] = hash_page(data + page, SNAPSHOT_PAGE_SIZE);
+            }
+        });
+
+    candidate_count_ = count_candidates();
+    fmt::print(stderr, "[INFO] Snapshot: {} regions, {} bytes, {} candidates\n",
+               regions_.size(), file_.size(), candidate_count_);
+    return engine.stats();
+}
+
+ScanStats SnapshotStore::compare(MemorySource& source, const ScanOptions& options, CompareOp op, const std::string& operand) {
+    ScanEngine engine(source, page_aligned(options));
+    uint64_t* words = bitmap();
+    uint64_t* hashes = page_hashes();
+    std::atomic<size_t> pages_compared{0};
+    std::atomic<size_t> pages_unchanged{0};
+    std::atomic<size_t> pages_skipped{0};
+
+    dispatch_numeric_type(value_type_, [&](auto tag) {
+        using T = decltype(tag);
+        T step = parse_compare_operand<T>(op, operand, value_type_);
+
+        dispatch_compare_op(op, [&](auto op_tag) {
+            constexpr CompareOp Op = decltype(op_tag)::value;
+
+            // What an unchanged page means for its candidates: kept, dropped, or
+            // (float steps, where NaN breaks x + 0 == x) still diffed element-wise.
+            enum class Unchanged { KEEP, DROP, DIFF };
+            Unchanged unchanged = Unchanged::DROP;
+            if constexpr (Op == CompareOp::UNCHANGED) {
+                unchanged = Unchanged::KEEP;
+            } else if constexpr (Op == CompareOp::INCREASED_BY || Op == CompareOp::DECREASED_BY) {
+                if constexpr (std::is_integral_v<T>) {
+                    unchanged = step == 0 ? Unchanged::KEEP : Unchanged::DROP;
+                } else {
+                    unchanged = Unchanged::DIFF;
+                }
+            }
+
+            engine.run(memory_regions(true), 0,
+                [&](uintptr_t address, const uint8_t* data, size_t, size_t scan_limit, std::vector<uintptr_t>&) {
+                    const SnapshotRegion& region = region_at(address);
+                    size_t offset = static_cast<size_t>(address - region.base);
+                    uint8_t* previous = file_.data() + region.data_offset + offset;
+                    uint64_t* region_words = words + region.bitmap_offset;
+                    size_t compared = 0;
+                    size_t same = 0;
+                    size_t skipped = 0;
+
+                    for (size_t page = 0; page < scan_limit; page += SNAPSHOT_PAGE_SIZE) {
+                        size_t page_end = (std::min)(page + SNAPSHOT_PAGE_SIZE, scan_limit);
+                        size_t first = (offset + page + sizeof(T) - 1) / sizeof(T);
+                        size_t last = (offset + page_end) / sizeof(T);
+
+                        bool has_candidates = false;
+                        for_each_word(first, last, [&](size_t w, uint64_t mask) {
+                            has_candidates |= (region_words[w] & mask) != 0;
+                        });
+                        // Without candidates the page's old bytes are never needed again.
+                        if (!has_candidates) {
+                            skipped++;
+                            continue;
+                        }
+
+                        if (page_end - page == SNAPSHOT_PAGE_SIZE) {
+                            uint64_t& stored = hashes[region.page_offset + (offset + page) / SNAPSHOT_PAGE_SIZE];
+                            uint64_t hash = hash_page(data + page, SNAPSHOT_PAGE_SIZE);
+                            if (hash == stored && unchanged != Unchanged::DIFF) {
+                                same++;
+                                if (unchanged == Unchanged::DROP) {
+                                    for_each_word(first, last, [&](size_t w, uint64_t mask) { region_words[w] &= ~mask; });
+                                }
+                                continue;
+                            }
+                            stored = hash;
+                        }
+
+                        compared++;
+                        for_each_word(first, last, [&](size_t w, uint64_t mask) {
+                            uint64_t bits = region_words[w] & mask;
+                            uint64_t keep = region_words[w] & ~mask;
+                            while (bits != 0) {
+                                size_t slot = w * 64 + count_trailing_zeros(bits);
+                                uint64_t bit = bits & (0 - bits);
+                                bits ^= bit;
+
+                                size_t position = slot * sizeof(T) - offset;
+                                T old_value;
+                                T new_value;
+                                std::memcpy(&old_value, previous + position, sizeof(T));
+                                std::memcpy(&new_value, data + position, sizeof(T));
+                                if (compare_values<Op, T>(old_value, new_value, step)) {
+                                    keep |= bit;
+                                }
+                            }
+                            region_words[w] = keep;
+                        });
+
+                        std::memcpy(previous + page, data + page, page_end - page);
+                    }
+
+                    pages_compared += compared;
+                    pages_unchanged += same;
+                    pages_skipped += skipped;
+                });
+        });
+    });
+
+    candidate_count_ = count_candidates();
+
+    ScanStats stats = engine.stats();
+    stats.pages_compared = pages_compared;
+    stats.pages_unchanged = pages_unchanged;
+    stats.pages_skipped = pages_skipped;
+    fmt::print(stderr, "[INFO] Compare ({}): {} candidates left; pages compared {}, unchanged {}, skipped {}\n",
+               compare_op_to_string(op), candidate_count_, stats.pages_compared, stats.pages_unchanged, stats.pages_skipped);
+    return stats;
+}
+
+ResultSet SnapshotStore::materialize() const {
+    ResultSet results(value_type_, value_width_);
+    results.reserve(candidate_count_);
+    for_each_candidate(candidate_count_, [&](uint64_t address, const uint8_t* value) {
+        results.append(address, value);
+    });
+    return results;
+}
+
+} // namespace MemoryMCP
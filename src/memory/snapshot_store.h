@@ -0,0 +1,108 @@
+#pragma once
+#include "types.h"
+#include "mapped_file.h"
+#include "memory_source.h"
+#include "result_set.h"
+#include "bit_ops.h"
+#include <utility>
+#include <vector>
+
+namespace MemoryMCP {
+
+// Where one region lives in the snapshot file.
+struct SnapshotRegion {
+    uint64_t base;
+    size_t size;
+    size_t data_offset;    // byte offset of the region's copy
+    size_t bitmap_offset;  // first bitmap word of the region's candidate slots
+    size_t page_offset;    // first page hash of the region
+};
+
+// Snapshot of every readable region for scans where the initial value is
+// unknown. The region copies, a candidate bitmap (one bit per naturally
+// aligned slot of the value type) and a content hash per 4 KiB page live in a
+// MappedFile, so multi-GB snapshots stay out of the server heap. Each compare
+// pass re-reads the regions through the scan engine and streams old and new
+// bytes side by side; pages whose hash did not change are not diffed or
+// written back.
+class SnapshotStore {
+public:
+    // Lays out the file for regions; throws std::runtime_error if it cannot be created.
+    SnapshotStore(ValueType value_type, const std::vector<MemoryRegion>& regions);
+
+    ValueType value_type() const { return value_type_; }
+    size_t value_width() const { return value_width_; }
+    const std::vector<SnapshotRegion>& regions() const { return regions_; }
+    size_t file_size() const { return file_.size(); }
+    size_t candidate_count() const { return candidate_count_; }
+
+    // Copies every region into the snapshot and marks every slot that was read as a candidate.
+    ScanStats capture(MemorySource& source, const ScanOptions& options);
+
+    // Re-reads every region and keeps the candidates whose current value
+    // satisfies op against the snapshot; the current bytes then replace the
+    // snapshot. Chunks that cannot be read keep their candidates unchanged.
+    ScanStats compare(MemorySource& source, const ScanOptions& options, CompareOp op, const std::string& operand);
+
+    // Calls f(address, value) for up to limit candidates in address order,
+    // starting with candidate number offset; whole bitmap words are skipped
+    // by popcount.
+    template <typename F>
+    void for_each_candidate(size_t offset, size_t limit, F&& f) const {
+        const uint64_t* words = bitmap();
+        size_t visited = 0;
+        for (const SnapshotRegion& region : regions_) {
+            size_t slots = region.size / value_width_;
+            for (size_t w = 0; w * 64 < slots; ++w) {
+                uint64_t bits = words[region.bitmap_offset + w];
+                if (offset > 0) {
+                    size_t bit_count = popcount(bits);
+                    if (offset >= bit_count) {
+                        offset -= bit_count;
+                        continue;
+                    }
+                    for (; offset > 0; --offset) {
+                        bits &= bits - 1;
+                    }
+                }
+                while (bits != 0) {
+                    if (visited == limit) {
+                        return;
+                    }
+                    size_t slot = w * 64 + count_trailing_zeros(bits);
+                    bits &= bits - 1;
+                    f(region.base + slot * value_width_, file_.data() + region.data_offset + slot * value_width_);
+                    visited++;
+                }
+            }
+        }
+    }
+
+    template <typename F>
+    void for_each_candidate(size_t limit, F&& f) const {
+        for_each_candidate(0, limit, std::forward<F>(f));
+    }
+
+    ResultSet materialize() const;
+
+private:
+    const SnapshotRegion& region_at(uint64_t address) const;
+    ScanOptions page_aligned(const ScanOptions& options) const;
+    std::vector<MemoryRegion> memory_regions(bool with_candidates_only) const;
+    size_t count_candidates() const;
+
+    uint64_t* bitmap() { return reinterpret_cast<uint64_t*>(file_.data() + bitmap_start_); }
+    const uint64_t* bitmap() const { return reinterpret_cast<const uint64_t*>(file_.data() + bitmap_start_); }
+    uint64_t* page_hashes() { return reinterpret_cast<uint64_t*>(file_.data() + hashes_start_); }
+
+    ValueType value_type_;
+    size_t value_width_;
+    std::vector<SnapshotRegion> regions_;
+    size_t bitmap_start_ = 0;
+    size_t bitmap_words_ = 0;
+    size_t hashes_start_ = 0;
+    size_t candidate_count_ = 0;
+    MappedFile file_;
+};
+
+} // namespace MemoryMCP
@@ -0,0 +1,178 @@
+#include "streaming_reader.h"
+#include <algorithm>
+#include <cstring>
+
+namespace MemoryMCP {
+
+PooledBuffer::~PooledBuffer() {
+    if (!storage_.empty()) {
+        BufferPool::local().release(std::move(storage_));
+    }
+}
+
+BufferPool& BufferPool::local() {
+    static thread_local BufferPool pool;
+    return pool;
+}
+
+PooledBuffer BufferPool::acquire(size_t capacity) {
+    for (size_t i = 0; i < free_.size(); ++i) {
+        if (free_[i].size() >= capacity) {
+            std::vector<uint8_t> storage = std::move(free_[i]);
+            free_.erase(free_.begin() + i);
+            return PooledBuffer(std::move(storage));
+        }
+    }
+    return PooledBuffer(std::vector<uint8_t>(capacity));
+}
+
+void BufferPool::release(std::vector<uint8_t>&& storage) {
+    if (free_.size() < MAX_FREE_BUFFERS) {
+        free_.push_back(std::move(storage));
+    }
+}
+
+ChunkPrefetcher::ChunkPrefetcher() = default;
+
+ChunkPrefetcher::~ChunkPrefetcher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+ChunkPrefetcher& ChunkPrefetcher::local() {
+    static thread_local ChunkPrefetcher prefetcher;
+    return prefetcher;
+}
+
+void ChunkPrefetcher::start(MemorySource& source, uintptr_t address, uint8_t* buffer, size_t size) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        source_ = &source;
+        address_ = address;
+        buffer_ = buffer;
+        size_ = size;
+        bytes_read_ = 0;
+        pending_ = true;
+        done_ = false;
+    }
+
+    // The helper thread is only created for threads that actually stream.
+    if (!thread_.joinable()) {
+        thread_ = std::thread([this]() { run(); });
+    }
+    cv_.notify_all();
+}
+
+size_t ChunkPrefetcher::wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this]() { return done_; });
+    done_ = false;
+    return bytes_read_;
+}
+
+void ChunkPrefetcher::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this]() { return stopping_ || pending_; });
+        if (stopping_) {
+            return;
+        }
+
+        pending_ = false;
+        MemorySource* source = source_;
+        uintptr_t address = address_;
+        uint8_t* buffer = buffer_;
+        size_t size = size_;
+
+        lock.unlock();
+        size_t bytes_read = source->read(address, buffer, size);
+        lock.lock();
+
+        bytes_read_ = bytes_read;
+        done_ = true;
+        cv_.notify_all();
+    }
+}
+
+StreamingReader::StreamingReader(MemorySource& source, size_t chunk_size, size_t overlap)
+    : source_(source), chunk_size_(chunk_size), overlap_(overlap) {
+}
+
+size_t StreamingReader::stream(uintptr_t address, size_t size, uintptr_t region_end, const Visitor& visit,
+                               const std::atomic<bool>* stop) {
+    const uintptr_t end = address + size;
+    const uintptr_t read_end = (std::min)(end + overlap_, region_end);
+
+    BufferPool& pool = BufferPool::local();
+    PooledBuffer current = pool.acquire(chunk_size_ + overlap_);
+    PooledBuffer next = pool.acquire(chunk_size_ + overlap_);
+    ChunkPrefetcher& prefetcher = ChunkPrefetcher::local();
+
+    uintptr_t position = address;
+    size_t carry = 0;
+    size_t requested = (std::min)(chunk_size_, static_cast<size_t>(read_end - position));
+    size_t got = source_.read(position, current.data(), requested);
+    size_t readable = 0;
+
+    while (true) {
+        uintptr_t chunk_address = position - carry;
+        size_t available = carry + got;
+        uintptr_t next_position = position + got;
+        bool hole = got < requested;
+        if (hole) {
+            // Resume past the page that failed; nothing straddles it, so nothing is carried.
+            next_position = (next_position / STREAM_PAGE_SIZE + 1) * STREAM_PAGE_SIZE;
+        }
+        bool more = next_position < read_end;
+
+        size_t next_carry = 0;
+        size_t next_requested = 0;
+        if (more) {
+            next_carry = hole ? 0 : (std::min)(overlap_, available);
+            std::memcpy(next.data(), current.data() + available - next_carry, next_carry);
+            next_requested = (std::min)(chunk_size_, static_cast<size_t>(read_end - next_position));
+            prefetcher.start(source_, next_position, next.data() + next_carry, next_requested);
+        }
+
+        // Matches that cannot complete in this chunk are left for the next one.
+        size_t scan_limit = end > chunk_address ? static_cast<size_t>(end - chunk_address) : 0;
+        if (more) {
+            scan_limit = (std::min)(scan_limit, available - next_carry);
+        }
+
+        try {
+            if (available > 0 && scan_limit > 0) {
+                visit(chunk_address, current.data(), available, scan_limit);
+            }
+        } catch (...) {
+            if (more) {
+                prefetcher.wait();
+            }
+            throw;
+        }
+
+        readable += static_cast<size_t>((std::min)(position + got, end) - (std::min)(position, end));
+        if (!more) {
+            break;
+        }
+
+        got = prefetcher.wait();
+        if (stop != nullptr && stop->load(std::memory_order_relaxed)) {
+            break;
+        }
+        requested = next_requested;
+        position = next_position;
+        carry = next_carry;
+        std::swap(current, next);
+    }
+
+    return readable;
+}
+
+} // namespace MemoryMCP
@@ -0,0 +1,96 @@
+#pragma once
+#include "memory_source.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MemoryMCP {
+
+// Scratch buffer handed out by BufferPool; returns its storage on destruction.
+class PooledBuffer {
+public:
+    PooledBuffer() = default;
+    explicit PooledBuffer(std::vector<uint8_t>&& storage) : storage_(std::move(storage)) {}
+    PooledBuffer(PooledBuffer&&) = default;
+    PooledBuffer& operator=(PooledBuffer&&) = default;
+    ~PooledBuffer();
+
+    uint8_t* data() { return storage_.data(); }
+    size_t capacity() const { return storage_.size(); }
+
+private:
+    std::vector<uint8_t> storage_;
+};
+
+// Per-thread free list of scan buffers, so repeated scans on the same workers
+// do not allocate a new buffer per region or chunk.
+class BufferPool {
+public:
+    static BufferPool& local();
+
+    PooledBuffer acquire(size_t capacity);
+    void release(std::vector<uint8_t>&& storage);
+
+private:
+    static constexpr size_t MAX_FREE_BUFFERS = 4;
+
+    std::vector<std::vector<uint8_t>> free_;
+};
+
+// Background read of one chunk, so the next chunk is fetched while the current
+// one is being scanned. Each thread that streams owns one prefetcher.
+class ChunkPrefetcher {
+public:
+    ChunkPrefetcher();
+    ~ChunkPrefetcher();
+
+    static ChunkPrefetcher& local();
+
+    void start(MemorySource& source, uintptr_t address, uint8_t* buffer, size_t size);
+    size_t wait();
+
+private:
+    void run();
+
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    MemorySource* source_ = nullptr;
+    uintptr_t address_ = 0;
+    uint8_t* buffer_ = nullptr;
+    size_t size_ = 0;
+    size_t bytes_read_ = 0;
+    bool pending_ = false;
+    bool done_ = false;
+    bool stopping_ = false;
+};
+
+// Walks [address, address + size) of a region in chunk_size pieces with two
+// alternating buffers. The last overlap bytes of each chunk are carried to the
+// front of the next one, so matches straddling a chunk boundary are still seen.
+// A short read skips the page it stopped at and streaming goes on after it.
+class StreamingReader {
+public:
+    // Scans data[0, bytes_read) for matches starting before scan_limit.
+    using Visitor = std::function<void(uintptr_t address, const uint8_t* data, size_t bytes_read, size_t scan_limit)>;
+
+    StreamingReader(MemorySource& source, size_t chunk_size, size_t overlap);
+
+    // region_end bounds the overlap read past the end of the slice; once stop
+    // is set, streaming ends after the current chunk.
+    // Returns the number of bytes of the slice that were readable.
+    size_t stream(uintptr_t address, size_t size, uintptr_t region_end, const Visitor& visit,
+                  const std::atomic<bool>* stop = nullptr);
+
+private:
+    static constexpr uintptr_t STREAM_PAGE_SIZE = 4096;
+
+    MemorySource& source_;
+    size_t chunk_size_;
+    size_t overlap_;
+};
+
+} // namespace MemoryMCP
@@ -0,0 +1,160 @@
+#include "thread_pool.h"
+#include <algorithm>
+#include <exception>
+
+namespace MemoryMCP {
+
+static thread_local size_t tls_worker_index = ThreadPool::npos;
+
+ThreadPool::ThreadPool(size_t thread_count) {
+    if (thread_count == 0) {
+        thread_count = default_thread_count();
+    }
+
+    for (size_t i = 0; i < thread_count; ++i) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+
+    for (size_t i = 0; i < thread_count; ++i) {
+        workers_.emplace_back([this, i]() { worker_loop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+size_t ThreadPool::default_thread_count() {
+    unsigned int hardware = std::thread::hardware_concurrency();
+    return hardware == 0 ? 1 : hardware;
+}
+
+size_t ThreadPool::current_worker() {
+    return tls_worker_index;
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    // Tasks submitted from a worker stay on its own deque for locality.
+    size_t target = tls_worker_index;
+    if (target == npos || target >= queues_.size()) {
+        target = next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+        queues_[target]->tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        queued_.fetch_add(1, std::memory_order_release);
+    }
+    wake_.notify_one();
+}
+
+bool ThreadPool::try_pop(size_t index, std::function<void()>& task) {
+    {
+        WorkQueue& own = *queues_[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.front());
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+
+    for (size_t i = 1; i < queues_.size(); ++i) {
+        WorkQueue& victim = *queues_[(index + i) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::worker_loop(size_t index) {
+    tls_worker_index = index;
+
+    while (true) {
+        std::function<void()> task;
+        if (try_pop(index, task)) {
+            queued_.fetch_sub(1, std::memory_order_acq_rel);
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_.wait(lock, [this]() { return stopping_ || queued_.load(std::memory_order_acquire) > 0; });
+        if (stopping_ && queued_.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+void ThreadPool::parallel_for(size_t count, const std::function<void(size_t index, size_t worker)>& body,
+                              size_t max_workers) {
+    if (count == 0) {
+        return;
+    }
+
+    std::mutex done_mutex;
+    std::condition_variable done;
+    std::exception_ptr error;
+
+    auto run = [&](size_t index) {
+        try {
+            body(index, tls_worker_index);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(done_mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    };
+
+    // One task per index, or with a worker limit one task per allowed worker
+    // that claims indices until none are left.
+    bool limited = max_workers != 0 && max_workers < (std::min)(count, workers_.size());
+    size_t remaining = limited ? max_workers : count;
+    std::atomic<size_t> next_index{0};
+
+    for (size_t i = 0; i < (limited ? max_workers : count); ++i) {
+        submit([&, i]() {
+            if (limited) {
+                for (size_t index = next_index++; index < count; index = next_index++) {
+                    run(index);
+                }
+            } else {
+                run(i);
+            }
+
+            std::lock_guard<std::mutex> lock(done_mutex);
+            if (--remaining == 0) {
+                done.notify_one();
+            }
+        });
+    }
+
+    std::unique_lock<std::mutex> lock(done_mutex);
+    done.wait(lock, [&]() { return remaining == 0; });
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace MemoryMCP
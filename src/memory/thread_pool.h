@@ -0,0 +1,58 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MemoryMCP {
+
+// Fixed-size pool with one task deque per worker. Workers take tasks from the
+// front of their own deque and steal from the back of the others when idle.
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t thread_count = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers_.size(); }
+
+    void submit(std::function<void()> task);
+
+    // Runs body(index, worker) for every index in [0, count) and blocks until all
+    // calls have returned. The first exception thrown by body is rethrown here.
+    // A non-zero max_workers bounds how many workers run body at once.
+    void parallel_for(size_t count, const std::function<void(size_t index, size_t worker)>& body,
+                      size_t max_workers = 0);
+
+    // Index of the calling pool worker, or npos when called from another thread.
+    static size_t current_worker();
+    static size_t default_thread_count();
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void worker_loop(size_t index);
+    bool try_pop(size_t index, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> workers_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    std::atomic<size_t> queued_{0};
+    std::atomic<size_t> next_queue_{0};
+    bool stopping_ = false;
+};
+
+} // namespace MemoryMCP
@@ -0,0 +1,238 @@
+#ifdef _WIN32
+#include "windows_memory_source.h"
+#include <psapi.h>
+#include <tlhelp32.h>
+#include <fmt/base.h>
+
+#pragma comment(lib, "psapi.lib")
+
+namespace MemoryMCP {
+
+WindowsMemorySource::WindowsMemorySource() : process_handle_(NULL), process_id_(0) {
+}
+
+WindowsMemorySource::~WindowsMemorySource() {
+    close();
+}
+
+DWORD WindowsMemorySource::find_process_by_name(const std::string& process_name) {
+    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+    if (snapshot == INVALID_HANDLE_VALUE) {
+        fmt::print(stderr, "[ERROR] Failed to create process snapshot\n");
+        return 0;
+    }
+
+    PROCESSENTRY32W pe32;
+    pe32.dwSize = sizeof(PROCESSENTRY32W);
+
+    if (!Process32FirstW(snapshot, &pe32)) {
+        fmt::print(stderr, "[ERROR] Failed to get first process\n");
+        CloseHandle(snapshot);
+        return 0;
+    }
+
+    do {
+        std::wstring wname(pe32.szExeFile);
+        std::string name = wstring_to_string(wname);
+
+        if (name == process_name) {
+            fmt::print(stderr, "[SUCCESS] Process found: {} (PID: {})\n", name, pe32.th32ProcessID);
+            CloseHandle(snapshot);
+            return pe32.th32ProcessID;
+        }
+    } while (Process32NextW(snapshot, &pe32));
+
+    fmt::print(stderr, "[ERROR] Process not found: {}\n", process_name);
+    CloseHandle(snapshot);
+    return 0;
+}
+
+bool WindowsMemorySource::update_process_index(std::map<DWORD, std::string>& index) {
+    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+    if (snapshot == INVALID_HANDLE_VALUE) {
+        fmt::print(stderr, "[ERROR] Failed to create process snapshot\n");
+        return false;
+    }
+
+    PROCESSENTRY32W pe32;
+    pe32.dwSize = sizeof(PROCESSENTRY32W);
+
+    // Only processes new since the last update have their names converted.
+    std::map<DWORD, std::string> running;
+    if (Process32FirstW(snapshot, &pe32)) {
+        do {
+            auto known = index.find(pe32.th32ProcessID);
+            if (known != index.end()) {
+                running.emplace(pe32.th32ProcessID, std::move(known->second));
+            } else {
+                running.emplace(pe32.th32ProcessID, wstring_to_string(pe32.szExeFile));
+            }
+        } while (Process32NextW(snapshot, &pe32));
+    }
+
+    CloseHandle(snapshot);
+    index.swap(running);
+    return true;
+}
+
+bool WindowsMemorySource::process_matches(DWORD process_id, const std::string& process_name) {
+    HANDLE handle = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, process_id);
+    if (handle == NULL) {
+        return false;
+    }
+
+    wchar_t path[MAX_PATH];
+    DWORD length = MAX_PATH;
+    bool found = QueryFullProcessImageNameW(handle, 0, path, &length) != 0;
+    CloseHandle(handle);
+    if (!found) {
+        return false;
+    }
+
+    std::wstring image(path, length);
+    size_t slash = image.find_last_of(L"\\/");
+    return wstring_to_string(slash == std::wstring::npos ? image : image.substr(slash + 1)) == process_name;
+}
+
+bool WindowsMemorySource::open(DWORD process_id) {
+    close();
+
+    HANDLE handle = OpenProcess(
+        PROCESS_QUERY_INFORMATION | PROCESS_VM_READ | SYNCHRONIZE,
+        FALSE,
+        process_id
+    );
+
+    if (handle == NULL) {
+        fmt::print(stderr, "[ERROR] Failed to open process PID {}\n", process_id);
+        fmt::print(stderr, "[INFO] Error code: {}\n", GetLastError());
+        return false;
+    }
+
+    process_handle_ = handle;
+    process_id_ = process_id;
+    return true;
+}
+
+void WindowsMemorySource::close() {
+    if (process_handle_ != NULL) {
+        CloseHandle(process_handle_);
+        process_handle_ = NULL;
+    }
+    process_id_ = 0;
+    modules_.clear();
+}
+
+bool WindowsMemorySource::is_alive() const {
+    return process_handle_ != NULL && WaitForSingleObject(process_handle_, 0) == WAIT_TIMEOUT;
+}
+
+uint32_t WindowsMemorySource::translate_protection(const MEMORY_BASIC_INFORMATION& mbi) {
+    // Guard pages fault on first touch, so they are never reported as readable.
+    if (mbi.Protect & (PAGE_GUARD | PAGE_NOACCESS)) {
+        return PROTECTION_NONE;
+    }
+    // PAGE_NOCACHE and PAGE_WRITECOMBINE only modify the base protection.
+    switch (mbi.Protect & 0xFF) {
+        case PAGE_READONLY: return PROTECTION_READ;
+        case PAGE_READWRITE:
+        case PAGE_WRITECOPY: return PROTECTION_READ | PROTECTION_WRITE;
+        case PAGE_EXECUTE: return PROTECTION_EXECUTE;
+        case PAGE_EXECUTE_READ: return PROTECTION_READ | PROTECTION_EXECUTE;
+        case PAGE_EXECUTE_READWRITE:
+        case PAGE_EXECUTE_WRITECOPY: return PROTECTION_READ | PROTECTION_WRITE | PROTECTION_EXECUTE;
+        default: return PROTECTION_NONE;
+    }
+}
+
+RegionType WindowsMemorySource::translate_type(const MEMORY_BASIC_INFORMATION& mbi) {
+    switch (mbi.Type) {
+        case MEM_IMAGE: return RegionType::IMAGE;
+        case MEM_MAPPED: return RegionType::MAPPED;
+        default: return RegionType::PRIVATE;
+    }
+}
+
+std::string WindowsMemorySource::module_name(uintptr_t allocation_base, std::map<uintptr_t, std::string>& seen) {
+    auto cached = modules_.find(allocation_base);
+    if (cached != modules_.end()) {
+        return seen.emplace(allocation_base, cached->second).first->second;
+    }
+
+    wchar_t path[MAX_PATH];
+    DWORD length = GetMappedFileNameW(process_handle_, (LPVOID)allocation_base, path, MAX_PATH);
+    std::wstring file(path, length);
+    size_t slash = file.find_last_of(L"\\/");
+    std::string name = wstring_to_string(slash == std::wstring::npos ? file : file.substr(slash + 1));
+    return seen.emplace(allocation_base, std::move(name)).first->second;
+}
+
+std::vector<MemoryRegion> WindowsMemorySource::enumerate_regions() {
+    std::vector<MemoryRegion> regions;
+    if (!is_open()) {
+        return regions;
+    }
+
+    // Image sections and views share their allocation's file, so each file is named once.
+    std::map<uintptr_t, std::string> seen;
+    MEMORY_BASIC_INFORMATION mbi;
+    uintptr_t address = 0;
+
+    while (VirtualQueryEx(process_handle_, (LPCVOID)address, &mbi, sizeof(mbi))) {
+        if (mbi.State == MEM_COMMIT) {
+            MemoryRegion region;
+            region.base = (uintptr_t)mbi.BaseAddress;
+            region.size = mbi.RegionSize;
+            region.protection = translate_protection(mbi);
+            region.type = translate_type(mbi);
+            if (region.type != RegionType::PRIVATE) {
+                region.module = module_name((uintptr_t)mbi.AllocationBase, seen);
+            }
+            regions.push_back(std::move(region));
+        }
+
+        address = (uintptr_t)mbi.BaseAddress + mbi.RegionSize;
+
+        if (address == 0) break;
+    }
+
+    // Names of unloaded files are dropped so a new file at the same base is looked up again.
+    modules_.swap(seen);
+    return regions;
+}
+
+bool WindowsMemorySource::update_regions(std::vector<MemoryRegion>& regions) {
+    // There is no change feed for another process's address space, so the
+    // walk is repeated; only files mapped since the last walk are named.
+    std::vector<MemoryRegion> current = enumerate_regions();
+    if (current == regions) {
+        return false;
+    }
+    regions.swap(current);
+    return true;
+}
+
+size_t WindowsMemorySource::read(uintptr_t address, void* buffer, size_t size) {
+    if (!is_open() || size == 0) {
+        return 0;
+    }
+
+    SIZE_T bytes_read = 0;
+    if (!ReadProcessMemory(process_handle_, (LPCVOID)address, buffer, size, &bytes_read)) {
+        return 0;
+    }
+    return bytes_read;
+}
+
+size_t WindowsMemorySource::read_batch(std::vector<ReadRequest>& requests) {
+    // Windows has no vectored cross-process read, so the batch is one call per request.
+    size_t total = 0;
+    for (auto& request : requests) {
+        request.bytes_read = read(request.address, request.buffer, request.size);
+        total += request.bytes_read;
+    }
+    return total;
+}
+
+} // namespace MemoryMCP
+#endif
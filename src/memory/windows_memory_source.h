@@ -0,0 +1,45 @@
+#pragma once
+#ifdef _WIN32
+#include "memory_source.h"
+
+namespace MemoryMCP {
+
+// Reads process memory through ReadProcessMemory and discovers regions and
+// processes through VirtualQueryEx and the Toolhelp snapshot API. The open
+// handle keeps the process's PID from being reused and is signalled when the
+// process exits, which is what is_alive() checks.
+class WindowsMemorySource : public MemorySource {
+public:
+    WindowsMemorySource();
+    ~WindowsMemorySource() override;
+
+    const char* name() const override { return "windows"; }
+
+    DWORD find_process_by_name(const std::string& process_name) override;
+    bool open(DWORD process_id) override;
+    void close() override;
+    bool is_open() const override { return process_handle_ != NULL; }
+    DWORD process_id() const override { return process_id_; }
+    bool is_alive() const override;
+
+    bool update_process_index(std::map<DWORD, std::string>& index) override;
+    bool process_matches(DWORD process_id, const std::string& process_name) override;
+
+    std::vector<MemoryRegion> enumerate_regions() override;
+    bool update_regions(std::vector<MemoryRegion>& regions) override;
+    size_t read(uintptr_t address, void* buffer, size_t size) override;
+    size_t read_batch(std::vector<ReadRequest>& requests) override;
+
+private:
+    static uint32_t translate_protection(const MEMORY_BASIC_INFORMATION& mbi);
+    static RegionType translate_type(const MEMORY_BASIC_INFORMATION& mbi);
+    // File name mapped at allocation_base, from the last walk's names when known; recorded in seen.
+    std::string module_name(uintptr_t allocation_base, std::map<uintptr_t, std::string>& seen);
+
+    HANDLE process_handle_;
+    DWORD process_id_;
+    std::map<uintptr_t, std::string> modules_;  // allocation base -> file name, as of the last walk
+};
+
+} // namespace MemoryMCP
+#endif
@@ -0,0 +1,181 @@
+#include "address_input.h"
+#include "result_set.h"
+#include <stdexcept>
+
+namespace MemoryMCP {
+
+namespace {
+
+// Top-level object only: the addresses array is decoded entry by entry and
+// everything else but the top-level strings is skipped, however deeply nested.
+class FilterInputHandler : public nlohmann::json_sax<json> {
+public:
+    explicit FilterInputHandler(FilterInput& input) : input_(input) {}
+
+    bool null() override {
+        if (depth_ == 1 && field_ == Field::ADDRESSES) {
+            addresses_null_ = true;
+        }
+        return entry(false, 0);
+    }
+    bool boolean(bool) override { return entry(false, 0); }
+    bool number_integer(number_integer_t value) override { return entry(value >= 0, static_cast<uint64_t>(value)); }
+    bool number_unsigned(number_unsigned_t value) override { return entry(true, value); }
+    bool number_float(number_float_t, const string_t&) override { return entry(false, 0); }
+    bool binary(binary_t&) override { return entry(false, 0); }
+
+    bool string(string_t& value) override {
+        if (in_addresses()) {
+            uint64_t address = 0;
+            bool valid = parse_address(value, address);
+            return entry(valid, address);
+        }
+        if (depth_ == 1 && field_ == Field::NEW_VALUE) {
+            input_.new_value = std::move(value);
+            has_new_value_ = true;
+        } else if (depth_ == 1 && field_ == Field::VALUE_TYPE) {
+            input_.value_type = std::move(value);
+            has_value_type_ = true;
+        } else if (depth_ == 1 && field_ == Field::SESSION) {
+            input_.session = std::move(value);
+        }
+        return true;
+    }
+
+    bool start_object(std::size_t) override {
+        if (depth_ == 0) {
+            top_level_object_ = true;
+        }
+        return open();
+    }
+    bool end_object() override { return close(); }
+
+    bool start_array(std::size_t) override {
+        if (depth_ == 1 && field_ == Field::ADDRESSES) {
+            has_addresses_ = true;
+            addresses_depth_ = depth_ + 1;
+        }
+        return open();
+    }
+    bool end_array() override {
+        if (depth_ == addresses_depth_) {
+            addresses_depth_ = 0;
+        }
+        return close();
+    }
+
+    bool key(string_t& value) override {
+        if (depth_ == 1) {
+            addresses_key_ = addresses_key_ || value == "addresses";
+            field_ = value == "addresses" ? Field::ADDRESSES
+                   : value == "new_value" ? Field::NEW_VALUE
+                   : value == "value_type" ? Field::VALUE_TYPE
+                   : value == "session" ? Field::SESSION
+                   : Field::OTHER;
+        }
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e) override {
+        throw std::invalid_argument(std::string("Invalid filter request: ") + e.what());
+    }
+
+    void check() {
+        if (!top_level_object_) {
+            throw std::invalid_argument("Invalid filter request: expected an object");
+        }
+        if (!has_new_value_ || !has_value_type_) {
+            throw std::invalid_argument("Invalid filter request: new_value and value_type are required");
+        }
+        // Omitted or null re-checks every result; anything else must be a list.
+        if (addresses_key_ && !has_addresses_ && !addresses_null_) {
+            throw std::invalid_argument("Invalid filter request: addresses must be an array");
+        }
+        input_.all_results = !has_addresses_;
+    }
+
+private:
+    enum class Field { OTHER, ADDRESSES, NEW_VALUE, VALUE_TYPE, SESSION };
+
+    bool in_addresses() const { return addresses_depth_ != 0 && depth_ == addresses_depth_; }
+
+    // A scalar; counts as an address entry when directly inside the array.
+    bool entry(bool valid, uint64_t address) {
+        if (in_addresses()) {
+            input_.listed++;
+            if (valid) {
+                input_.addresses.push_back(address);
+            } else {
+                input_.invalid++;
+            }
+        }
+        return true;
+    }
+
+    bool open() {
+        // A nested object or array in the list is one invalid entry.
+        entry(false, 0);
+        depth_++;
+        return true;
+    }
+
+    bool close() {
+        depth_--;
+        return true;
+    }
+
+    FilterInput& input_;
+    size_t depth_ = 0;
+    size_t addresses_depth_ = 0;
+    Field field_ = Field::OTHER;
+    bool top_level_object_ = false;
+    bool addresses_key_ = false;
+    bool addresses_null_ = false;
+    bool has_addresses_ = false;
+    bool has_new_value_ = false;
+    bool has_value_type_ = false;
+};
+
+} // namespace
+
+FilterInput parse_filter_input(const std::string& body) {
+    FilterInput input;
+    FilterInputHandler handler(input);
+    json::sax_parse(body, &handler);
+    handler.check();
+    return input;
+}
+
+size_t decode_addresses(const json& items, std::vector<uint64_t>& out) {
+    size_t invalid = 0;
+    out.reserve(out.size() + items.size());
+    for (const json& item : items) {
+        uint64_t address = 0;
+        if (item.is_string() && parse_address(item.get_ref<const std::string&>(), address)) {
+            out.push_back(address);
+        } else if (item.is_number_unsigned()) {
+            out.push_back(item.get<uint64_t>());
+        } else if (item.is_number_integer() && item.get<int64_t>() >= 0) {
+            out.push_back(static_cast<uint64_t>(item.get<int64_t>()));
+        } else {
+            invalid++;
+        }
+    }
+    return invalid;
+}
+
+void unpack_addresses(const char* data, size_t size, std::vector<uint64_t>& out) {
+    if (size % sizeof(uint64_t) != 0) {
+        throw std::invalid_argument("Packed addresses must be a multiple of 8 bytes");
+    }
+    out.reserve(out.size() + size / sizeof(uint64_t));
+    for (size_t at = 0; at < size; at += sizeof(uint64_t)) {
+        uint64_t address = 0;
+        for (size_t byte = 0; byte < sizeof(uint64_t); ++byte) {
+            address |= static_cast<uint64_t>(static_cast<uint8_t>(data[at + byte])) << (8 * byte);
+        }
+        out.push_back(address);
+    }
+}
+
+} // namespace MemoryMCP
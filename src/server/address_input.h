@@ -0,0 +1,38 @@
+#pragma once
+#include "types.h"
+#include <string>
+#include <vector>
+
+namespace MemoryMCP {
+
+// Address lists as clients send them, decoded straight into uint64 buffers so
+// a large filter never holds one string per address.
+
+// Body of a filter request.
+struct FilterInput {
+    std::vector<uint64_t> addresses;
+    size_t listed = 0;   // entries in the addresses array, valid or not
+    size_t invalid = 0;  // entries that were neither hex strings nor unsigned numbers
+    bool all_results = false;  // the body has no addresses array: re-check every result
+    std::string new_value;
+    std::string value_type;
+    std::string session;  // empty if the body names none
+};
+
+// Parses {"addresses": [...], "new_value": "...", "value_type": "...",
+// "session": "..."} with a SAX handler, so no DOM is built. Addresses may be
+// hex strings or unsigned numbers; an omitted list stands for every result.
+// session is optional and other keys are skipped. Throws
+// std::invalid_argument on malformed JSON or missing fields.
+FilterInput parse_filter_input(const std::string& body);
+
+// Appends the addresses of a JSON array to out; returns how many entries
+// were not addresses.
+size_t decode_addresses(const json& items, std::vector<uint64_t>& out);
+
+// Appends little-endian uint64 addresses packed back to back, the raw
+// encoding of get_addresses. Throws std::invalid_argument unless size is a
+// multiple of 8.
+void unpack_addresses(const char* data, size_t size, std::vector<uint64_t>& out);
+
+} // namespace MemoryMCP
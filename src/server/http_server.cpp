@@ -1,7 +1,15 @@
 #include "http_server.h"
 #include "memory_scanner.h"
+#include "scan_sessions.h"
+#include "job_queue.h"
+#include "address_input.h"
+#include "json_rpc.h"
+#include "result_encoding.h"
+#include "result_set.h"
+#include "thread_pool.h"
+#include "tool_registry.h"
 #include <httplib.h>
-#include <fmt/base.h>
+#include <fmt/format.h>
 #include <nlohmann/json.hpp>
 
 using namespace httplib;
@@ -9,6 +17,22 @@ using json = nlohmann::json;
 
 namespace MemoryMCP {
 
+namespace {
+
+// An explicit encoding name wins over the Accept header.
+ResultEncoding requested_encoding(const Request& req, const std::string& name) {
+    if (name.empty()) {
+        return negotiate_result_encoding(req.get_header_value("Accept"));
+    }
+    ResultEncoding encoding;
+    if (!parse_result_encoding(name, encoding)) {
+        throw std::invalid_argument("Unknown encoding: " + name);
+    }
+    return encoding;
+}
+
+} // namespace
+
 HttpServer::HttpServer(uint16_t port) : port_(port) {
     server_ = std::make_unique<Server>();
 }
@@ -32,10 +56,42 @@ void HttpServer::setup_routes() {
         handle_scan(req, res);
     });
 
+    server_->Post("/scan/pattern", [this](const Request& req, Response& res) {
+        handle_scan_pattern(req, res);
+    });
+
+    server_->Post("/scan/unknown", [this](const Request& req, Response& res) {
+        handle_scan_unknown(req, res);
+    });
+
+    server_->Post("/scan/compare", [this](const Request& req, Response& res) {
+        handle_scan_compare(req, res);
+    });
+
     server_->Get("/addresses", [this](const Request& req, Response& res) {
         handle_get_addresses(req, res);
     });
 
+    server_->Get("/jobs", [this](const Request& req, Response& res) {
+        handle_list_jobs(req, res);
+    });
+
+    server_->Get(R"(/jobs/(\d+))", [this](const Request& req, Response& res) {
+        handle_get_job(req, res);
+    });
+
+    server_->Post(R"(/jobs/(\d+)/cancel)", [this](const Request& req, Response& res) {
+        handle_cancel_job(req, res);
+    });
+
+    server_->Get("/sessions", [this](const Request& req, Response& res) {
+        handle_list_sessions(req, res);
+    });
+
+    server_->Post(R"(/sessions/([A-Za-z0-9._-]+)/close)", [this](const Request& req, Response& res) {
+        handle_close_session(req, res);
+    });
+
     server_->Post("/filter", [this](const Request& req, Response& res) {
         handle_filter(req, res);
     });
@@ -70,7 +126,10 @@ bool HttpServer::start() {
     }
 
     setup_routes();
-    scanner_ = std::make_unique<MemoryScanner>();
+    sessions_ = std::make_unique<ScanSessions>();
+    tools_ = std::make_unique<ToolRegistry>(*sessions_);
+    jobs_ = std::make_unique<JobQueue>();
+    batch_pool_ = std::make_unique<ThreadPool>(BATCH_THREADS);
 
     return server_->listen("0.0.0.0", port_);
 }
@@ -86,6 +145,7 @@ void HttpServer::handle_scan(const Request& req, Response& res) {
 
     try {
         json request_body = json::parse(req.body);
+        std::shared_ptr<MemoryScanner> scanner = session(req, request_body);
         
         std::string process_name = request_body["process_name"];
         std::string value = request_body["value"];
@@ -93,27 +153,36 @@ void HttpServer::handle_scan(const Request& req, Response& res) {
         
         ValueType value_type = MemoryMCP::string_to_value_type(type_str);
         
+        ScanOptions options;
+        options.thread_count = request_body.value("threads", size_t(0));
+        options.regions = region_filter_from_json(request_body);
+        
         fmt::print("[INFO] Process: {}\n", process_name);
         fmt::print("[INFO] Value: {}\n", value);
         fmt::print("[INFO] Type: {}\n", MemoryMCP::value_type_to_string(value_type));
         
-        ScanResponse scan_response = scanner_->scan_memory(process_name, value, value_type);
+        ScanCondition condition = scan_condition_from_json(request_body);
+        if (request_body.value("async", false)) {
+            submit_job(res, "scan", options, [scanner, process_name, value, value_type, condition](const ScanOptions& job_options) {
+                return json(scanner->scan_memory(process_name, value, value_type, job_options, condition));
+            });
+            return;
+        }
+        ScanResponse scan_response = scanner->scan_memory(process_name, value, value_type, options, condition);
         
         json response;
         response["success"] = scan_response.success;
         response["count"] = scan_response.count;
         response["message"] = scan_response.message;
+        response["stats"] = scan_response.stats;
+        response["cursor"] = scan_response.cursor;
+        response["alignment"] = scan_response.alignment;
         
-        if (scan_response.success) {
-            json addresses_array = json::array();
-            for (const auto& addr : scan_response.addresses) {
-                json addr_obj;
-                addr_obj["address"] = "0x" + std::to_string(addr.address);
-                addr_obj["value"] = addr.value;
-                addr_obj["type"] = MemoryMCP::value_type_to_string(addr.type);
-                addresses_array.push_back(addr_obj);
-            }
-            response["addresses"] = addresses_array;
+        // Counts and a cursor by default; "stream": true appends every hit.
+        if (scan_response.success && request_body.value("stream", false)) {
+            ResultEncoding encoding = requested_encoding(req, request_body.value("encoding", std::string()));
+            stream_addresses(res, scanner, response, 0, scan_response.cursor, encoding);
+            return;
         }
         
         res.set_content(response.dump(), "application/json");
@@ -126,24 +195,28 @@ void HttpServer::handle_scan(const Request& req, Response& res) {
     }
 }
 
-void HttpServer::handle_get_addresses(const Request& req, Response& res) {
-    fmt::print("[INFO] Processing get addresses request\n");
+void HttpServer::handle_scan_pattern(const Request& req, Response& res) {
+    fmt::print("[INFO] Processing pattern scan request\n");
 
     try {
-        size_t max_count = 100;
-        if (req.has_param("max_count")) {
-            max_count = std::stoul(req.get_param_value("max_count"));
-        }
+        json request_body = json::parse(req.body);
+        std::shared_ptr<MemoryScanner> scanner = session(req, request_body);
         
-        AddressesResponse addr_response = scanner_->get_addresses(max_count);
+        std::string process_name = request_body["process_name"];
+        std::vector<std::string> signatures = request_body["signatures"];
         
-        json response;
-        response["success"] = addr_response.success;
-        response["count"] = addr_response.count;
-        response["message"] = addr_response.message;
-        response["addresses"] = addr_response.addresses;
+        ScanOptions options;
+        options.thread_count = request_body.value("threads", size_t(0));
+        options.regions = region_filter_from_json(request_body);
         
-        res.set_content(response.dump(), "application/json");
+        if (request_body.value("async", false)) {
+            submit_job(res, "scan_pattern", options, [scanner, process_name, signatures](const ScanOptions& job_options) {
+                return json(scanner->scan_pattern(process_name, signatures, job_options));
+            });
+            return;
+        }
+        PatternScanResponse pattern_response = scanner->scan_pattern(process_name, signatures, options);
+        res.set_content(json(pattern_response).dump(), "application/json");
         
     } catch (const std::exception& e) {
         json error_response;
@@ -153,35 +226,34 @@ void HttpServer::handle_get_addresses(const Request& req, Response& res) {
     }
 }
 
-void HttpServer::handle_filter(const Request& req, Response& res) {
-    fmt::print("[INFO] Processing filter request\n");
+void HttpServer::handle_scan_unknown(const Request& req, Response& res) {
+    fmt::print("[INFO] Processing unknown value scan request\n");
 
     try {
         json request_body = json::parse(req.body);
+        std::shared_ptr<MemoryScanner> scanner = session(req, request_body);
         
-        std::vector<std::string> addresses = request_body["addresses"];
-        std::string new_value = request_body["new_value"];
+        std::string process_name = request_body["process_name"];
         std::string type_str = request_body["value_type"];
         
+        ScanOptions options;
+        options.thread_count = request_body.value("threads", size_t(0));
+        options.regions = region_filter_from_json(request_body);
+        
         ValueType value_type = MemoryMCP::string_to_value_type(type_str);
-        FilterResponse filter_response = scanner_->filter_addresses(addresses, new_value, value_type);
+        if (request_body.value("async", false)) {
+            submit_job(res, "scan_unknown", options, [scanner, process_name, value_type](const ScanOptions& job_options) {
+                return json(scanner->scan_unknown(process_name, value_type, job_options));
+            });
+            return;
+        }
+        ScanResponse scan_response = scanner->scan_unknown(process_name, value_type, options);
         
         json response;
-        response["success"] = filter_response.success;
-        response["count"] = filter_response.count;
-        response["message"] = filter_response.message;
-        
-        if (filter_response.success) {
-            json addresses_array = json::array();
-            for (const auto& addr : filter_response.addresses) {
-                json addr_obj;
-                addr_obj["address"] = "0x" + std::to_string(addr.address);
-                addr_obj["value"] = addr.value;
-                addr_obj["type"] = MemoryMCP::value_type_to_string(addr.type);
-                addresses_array.push_back(addr_obj);
-            }
-            response["addresses"] = addresses_array;
-        }
+        response["success"] = scan_response.success;
+        response["count"] = scan_response.count;
+        response["message"] = scan_response.message;
+        response["stats"] = scan_response.stats;
         
         res.set_content(response.dump(), "application/json");
         
@@ -193,15 +265,32 @@ void HttpServer::handle_filter(const Request& req, Response& res) {
     }
 }
 
-void HttpServer::handle_reset(const Request&, Response& res) {
-    fmt::print("[INFO] Processing reset request\n");
+void HttpServer::handle_scan_compare(const Request& req, Response& res) {
+    fmt::print("[INFO] Processing compare scan request\n");
 
     try {
-        ResetResponse reset_response = scanner_->reset();
+        json request_body = json::parse(req.body);
+        std::shared_ptr<MemoryScanner> scanner = session(req, request_body);
+        
+        CompareOp op = MemoryMCP::string_to_compare_op(request_body["op"]);
+        std::string operand = request_body.value("value", std::string());
+        
+        ScanOptions options;
+        options.thread_count = request_body.value("threads", size_t(0));
+        
+        if (request_body.value("async", false)) {
+            submit_job(res, "compare_scan", options, [scanner, op, operand](const ScanOptions& job_options) {
+                return json(scanner->compare_scan(op, operand, job_options));
+            });
+            return;
+        }
+        ScanResponse scan_response = scanner->compare_scan(op, operand, options);
         
         json response;
-        response["success"] = reset_response.success;
-        response["message"] = reset_response.message;
+        response["success"] = scan_response.success;
+        response["count"] = scan_response.count;
+        response["message"] = scan_response.message;
+        response["stats"] = scan_response.stats;
         
         res.set_content(response.dump(), "application/json");
         
@@ -213,194 +302,294 @@ void HttpServer::handle_reset(const Request&, Response& res) {
     }
 }
 
-void HttpServer::handle_mcp(const Request&, Response& res) {
-    fmt::print("[INFO] Processing MCP metadata request\n");
+void HttpServer::handle_get_addresses(const Request& req, Response& res) {
+    fmt::print("[INFO] Processing get addresses request\n");
 
     try {
-        json response;
-        response["jsonrpc"] = "2.0";
-        response["result"] = {
-            {"protocolVersion", "2024-11-05"},
-            {"capabilities", {
-                {"tools", {{"listChanged", false}}}
-            }},
-            {"serverInfo", {
-                {"name", "memory-mcp-server"},
-                {"version", "1.0.0"}
-            }}
-        };
+        size_t max_count = 100;
+        if (req.has_param("max_count")) {
+            max_count = std::stoul(req.get_param_value("max_count"));
+        }
+        size_t offset = 0;
+        if (req.has_param("offset")) {
+            offset = std::stoul(req.get_param_value("offset"));
+        }
+        std::string cursor = req.has_param("cursor") ? req.get_param_value("cursor") : std::string();
+        ResultEncoding encoding = requested_encoding(req, req.get_param_value("encoding"));
+        std::shared_ptr<MemoryScanner> scanner = session(req);
         
-        res.set_content(response.dump(), "application/json");
+        if (req.has_param("stream") && req.get_param_value("stream") != "false" && req.get_param_value("stream") != "0") {
+            stream_addresses(res, scanner, {{"success", true}}, offset, cursor, encoding);
+            return;
+        }
+        
+        AddressesResponse addr_response = scanner->get_addresses(max_count, offset, cursor, encoding != ResultEncoding::JSON);
+        if (encoding == ResultEncoding::RAW) {
+            // Raw bodies carry no page fields, so those go in headers and
+            // errors stay JSON.
+            if (!addr_response.success) {
+                encoding = ResultEncoding::JSON;
+            } else {
+                res.set_header("X-Total-Count", std::to_string(addr_response.total));
+                res.set_header("X-Offset", std::to_string(addr_response.offset));
+                if (!addr_response.next_cursor.empty()) {
+                    res.set_header("X-Next-Cursor", addr_response.next_cursor);
+                }
+            }
+        }
+        res.set_content(encode_addresses(addr_response, encoding), result_encoding_content_type(encoding));
         
     } catch (const std::exception& e) {
         json error_response;
-        error_response["jsonrpc"] = "2.0";
-        error_response["error"] = {
-            {"code", -32700},
-            {"message", "Parse error: " + std::string(e.what())}
-        };
+        error_response["success"] = false;
+        error_response["message"] = "Error: " + std::string(e.what());
         res.set_content(error_response.dump(), "application/json");
     }
 }
 
-void HttpServer::handle_mcp_tools_call(const Request& req, Response& res) {
-    fmt::print("[INFO] Processing MCP tools call request\n");
+void HttpServer::handle_list_jobs(const Request&, Response& res) {
+    json response;
+    response["success"] = true;
+    response["jobs"] = jobs_->list();
+    res.set_content(response.dump(), "application/json");
+}
 
-    try {
-        json request_body = json::parse(req.body);
-        json params = request_body["params"];
-        std::string name = params["name"];
-        json arguments = params["arguments"];
+void HttpServer::handle_get_job(const Request& req, Response& res) {
+    std::string id = req.matches[1];
+    JobStatus status;
+    if (!jobs_->status(id, status)) {
+        json error_response;
+        error_response["success"] = false;
+        error_response["message"] = "Unknown job: " + id;
+        res.status = 404;
+        res.set_content(error_response.dump(), "application/json");
+        return;
+    }
+    res.set_content(json(status).dump(), "application/json");
+}
 
-        json response;
-        response["jsonrpc"] = "2.0";
-        response["id"] = request_body.value("id", nullptr);
-
-        if (name == "scan_memory") {
-            std::string process_name = arguments["process_name"];
-            std::string value = arguments["value"];
-            std::string type_str = arguments["value_type"];
-
-            ValueType value_type = MemoryMCP::string_to_value_type(type_str);
-            ScanResponse scan_response = scanner_->scan_memory(process_name, value, value_type);
-
-            response["result"] = {
-                {"content", json::array({
-                    {
-                        {"type", "text"},
-                        {"text", "Scan completed. Found " + std::to_string(scan_response.count) + " addresses."}
-                    }
-                })},
-                {"isError", !scan_response.success}
-            };
-
-
-        } else if (name == "get_addresses") {
-            size_t max_count = arguments.value("max_count", 100);
-            AddressesResponse addr_response = scanner_->get_addresses(max_count);
-
-            std::string addresses_text = "Found addresses:\n";
-            for (const auto& addr : addr_response.addresses) {
-                addresses_text += addr + "\n";
+void HttpServer::handle_cancel_job(const Request& req, Response& res) {
+    std::string id = req.matches[1];
+    json response;
+    if (jobs_->cancel(id)) {
+        response["success"] = true;
+        response["message"] = "Cancellation requested for job " + id;
+    } else {
+        response["success"] = false;
+        response["message"] = "Unknown job: " + id;
+        res.status = 404;
+    }
+    res.set_content(response.dump(), "application/json");
+}
+
+void HttpServer::handle_list_sessions(const Request&, Response& res) {
+    json response;
+    response["success"] = true;
+    response["sessions"] = sessions_->list();
+    res.set_content(response.dump(), "application/json");
+}
+
+void HttpServer::handle_close_session(const Request& req, Response& res) {
+    std::string name = req.matches[1];
+    json response;
+    if (sessions_->close(name)) {
+        response["success"] = true;
+        response["message"] = "Session " + name + " closed";
+    } else {
+        response["success"] = false;
+        response["message"] = "Unknown session: " + name;
+        res.status = 404;
+    }
+    res.set_content(response.dump(), "application/json");
+}
+
+std::shared_ptr<MemoryScanner> HttpServer::session(const Request& req, const json& body) {
+    if (body.is_object() && body.contains("session")) {
+        return sessions_->get(body["session"].get<std::string>());
+    }
+    return sessions_->get(req.get_param_value("session"));
+}
+
+void HttpServer::submit_job(Response& res, const std::string& kind, const ScanOptions& options,
+                            std::function<json(const ScanOptions&)> work) {
+    std::string id = jobs_->submit(kind, options, std::move(work));
+    json response;
+    response["success"] = true;
+    response["job_id"] = id;
+    response["message"] = "Queued as job " + id + "; poll /jobs/" + id;
+    res.status = 202;
+    res.set_content(response.dump(), "application/json");
+}
+
+void HttpServer::stream_addresses(Response& res, std::shared_ptr<MemoryScanner> scanner, const json& head,
+                                  size_t offset, const std::string& cursor, ResultEncoding encoding) {
+    // The body is head with an "addresses" array appended one page per chunk,
+    // so memory stays at one page however many results there are. A page
+    // that fails (say, a scan replaced the results) ends the array early.
+    // CBOR and MessagePack send head and then every page as separate items;
+    // raw sends only the packed addresses and ends early without notice.
+    struct StreamState {
+        std::string head;
+        size_t offset;
+        std::string cursor;
+        bool head_sent = false;
+        size_t written = 0;
+    };
+    auto state = std::make_shared<StreamState>();
+    if (encoding == ResultEncoding::JSON) {
+        state->head = head.dump();
+        state->head.pop_back();
+        state->head += state->head.size() > 1 ? ",\"addresses\":[" : "\"addresses\":[";
+    } else if (encoding == ResultEncoding::CBOR) {
+        json::to_cbor(head, state->head);
+    } else if (encoding == ResultEncoding::MSGPACK) {
+        json::to_msgpack(head, state->head);
+    } else if (head.contains("count")) {
+        res.set_header("X-Total-Count", head["count"].dump());
+    }
+    state->offset = offset;
+    state->cursor = cursor;
+    
+    const char* content_type = encoding == ResultEncoding::CBOR ? "application/cbor-seq" : result_encoding_content_type(encoding);
+    res.set_chunked_content_provider(content_type, [scanner, state, encoding](size_t, DataSink& sink) {
+        std::string chunk;
+        if (!state->head_sent) {
+            chunk = std::move(state->head);
+            state->head_sent = true;
+        }
+        
+        bool numeric = encoding != ResultEncoding::JSON;
+        AddressesResponse page = scanner->get_addresses(STREAM_PAGE_SIZE, state->offset, state->cursor, numeric);
+        if (numeric) {
+            if (page.success || encoding != ResultEncoding::RAW) {
+                chunk += encode_addresses(page, encoding);
             }
+        } else if (page.success) {
+            for (size_t i = 0; i < page.addresses.size(); ++i) {
+                json entry = {{"address", page.addresses[i]}};
+                if (i < page.values.size()) {
+                    entry["value"] = page.values[i];
+                }
+                if (state->written++ > 0) {
+                    chunk += ',';
+                }
+                chunk += entry.dump();
+            }
+        }
+        
+        bool done = !page.success || page.next_cursor.empty();
+        if (done && !numeric) {
+            json tail = {{"complete", page.success}, {"total", page.total}};
+            if (!page.success) {
+                tail["error"] = page.message;
+            }
+            chunk += "]," + tail.dump().substr(1);
+        }
+        state->cursor = page.next_cursor;
+        
+        if (!sink.write(chunk.data(), chunk.size())) {
+            return false;
+        }
+        if (done) {
+            sink.done();
+        }
+        return true;
+    });
+}
 
-            response["result"] = {
-                {"content", json::array({
-                    {
-                        {"type", "text"},
-                        {"text", addresses_text}
-                    }
-                })},
-                {"isError", !addr_response.success}
-            };
-
-        } else if (name == "filter_addresses") {
-            std::vector<std::string> addresses = arguments["addresses"];
-            std::string new_value = arguments["new_value"];
-            std::string type_str = arguments["value_type"];
-
-            ValueType value_type = MemoryMCP::string_to_value_type(type_str);
-            FilterResponse filter_response = scanner_->filter_addresses(addresses, new_value, value_type);
-
-            response["result"] = {
-                {"content", json::array({
-                    {
-                        {"type", "text"},
-                        {"text", "Filtering completed. Remaining: " + std::to_string(filter_response.count) + " addresses."}
-                    }
-                })},
-                {"isError", !filter_response.success}
-            };
-
-        } else if (name == "reset_memory_scanner") {
-            ResetResponse reset_response = scanner_->reset();
-
-            response["result"] = {
-                {"content", json::array({
-                    {
-                        {"type", "text"},
-                        {"text", reset_response.message}
-                    }
-                })},
-                {"isError", !reset_response.success}
-            };
+void HttpServer::handle_filter(const Request& req, Response& res) {
+    fmt::print("[INFO] Processing filter request\n");
+
+    try {
+        // Addresses are decoded straight into a uint64 buffer: from a packed
+        // little-endian body with the rest in query parameters, or by a SAX
+        // pass over a JSON body.
+        FilterInput input;
+        if (req.get_header_value("Content-Type").rfind("application/octet-stream", 0) == 0) {
+            if (!req.has_param("new_value") || !req.has_param("value_type")) {
+                throw std::invalid_argument("new_value and value_type query parameters are required");
+            }
+            unpack_addresses(req.body.data(), req.body.size(), input.addresses);
+            input.listed = input.addresses.size();
+            input.new_value = req.get_param_value("new_value");
+            input.value_type = req.get_param_value("value_type");
         } else {
-            response["error"] = {
-                {"code", -32601},
-                {"message", "Unknown tool: " + name}
-            };
+            input = parse_filter_input(req.body);
+        }
+        if (input.invalid > 0) {
+            fmt::print("[WARNING] Ignored {} invalid addresses\n", input.invalid);
         }
         
+        ValueType value_type = MemoryMCP::string_to_value_type(input.value_type);
+        std::shared_ptr<MemoryScanner> scanner = sessions_->get(input.session.empty() ? req.get_param_value("session") : input.session);
+        FilterResponse filter_response = scanner->filter_addresses(std::move(input.addresses), input.new_value, value_type,
+                                                                    input.all_results);
+        
+        json response;
+        response["success"] = filter_response.success;
+        response["count"] = filter_response.count;
+        response["message"] = filter_response.message;
+        response["cursor"] = filter_response.cursor;
+        
         res.set_content(response.dump(), "application/json");
         
     } catch (const std::exception& e) {
         json error_response;
-        error_response["jsonrpc"] = "2.0";
-        error_response["error"] = {
-            {"code", -32700},
-            {"message", "Parse error: " + std::string(e.what())}
-        };
+        error_response["success"] = false;
+        error_response["message"] = "Error: " + std::string(e.what());
         res.set_content(error_response.dump(), "application/json");
     }
 }
 
-void HttpServer::handle_mcp_tools_list(const Request&, Response& res) {
-    fmt::print("[INFO] Processing MCP tools list request\n");
+void HttpServer::handle_reset(const Request& req, Response& res) {
+    fmt::print("[INFO] Processing reset request\n");
 
     try {
+        json request_body = req.body.empty() ? json::object() : json::parse(req.body);
+        ResetResponse reset_response = session(req, request_body)->reset();
+        
         json response;
-        response["jsonrpc"] = "2.0";
-        response["result"] = {
-            {"tools", json::array({
-                {
-                    {"name", "scan_memory"},
-                    {"description", "Scans process memory for specified value"},
-                    {"inputSchema", {
-                        {"type", "object"},
-                        {"properties", {
-                            {"process_name", {{"type", "string"}, {"description", "Process name"}}},
-                            {"value", {{"type", "string"}, {"description", "Search value"}}},
-                            {"value_type", {{"type", "string"}, {"description", "Data type"}}}
-                        }},
-                        {"required", json::array({"process_name", "value", "value_type"})}
-                    }}
-                },
-                {
-                    {"name", "get_addresses"},
-                    {"description", "Gets found memory addresses"},
-                    {"inputSchema", {
-                        {"type", "object"},
-                        {"properties", {
-                            {"max_count", {{"type", "integer"}, {"description", "Maximum number of addresses"}}}
-                        }}
-                    }}
-                },
-                {
-                    {"name", "filter_addresses"},
-                    {"description", "Filters addresses by new value"},
-                    {"inputSchema", {
-                        {"type", "object"},
-                        {"properties", {
-                            {"addresses", {{"type", "array"}, {"description", "Address list"}}},
-                            {"new_value", {{"type", "string"}, {"description", "New value"}}},
-                            {"value_type", {{"type", "string"}, {"description", "Data type"}}}
-                        }},
-                        {"required", json::array({"addresses", "new_value", "value_type"})}
-                    }}
-                },
-                {
-                    {"name", "reset_memory_scanner"},
-                    {"description", "Resets all search data"},
-                    {"inputSchema", {
-                        {"type", "object"},
-                        {"properties", json::object()}
-                    }}
-                }
-            })}
-        };
+        response["success"] = reset_response.success;
+        response["message"] = reset_response.message;
         
         res.set_content(response.dump(), "application/json");
         
+    } catch (const std::exception& e) {
+        json error_response;
+        error_response["success"] = false;
+        error_response["message"] = "Error: " + std::string(e.what());
+        res.set_content(error_response.dump(), "application/json");
+    }
+}
+
+void HttpServer::handle_mcp(const Request&, Response& res) {
+    fmt::print("[INFO] Processing MCP metadata request\n");
+
+    res.set_content(R"({"jsonrpc":"2.0","result":)" + tools_->initialize_result() + "}", "application/json");
+}
+
+void HttpServer::handle_mcp_tools_call(const Request& req, Response& res) {
+    fmt::print("[INFO] Processing MCP tools call request\n");
+
+    try {
+        json request_body = json::parse(req.body);
+        
+        if (request_body.is_array()) {
+            std::string replies = run_json_rpc_batch(request_body, *batch_pool_, [this](const json& call) {
+                // Notifications in a batch run but get no reply.
+                std::string reply = tools_->call(call);
+                return call.contains("id") && !call["id"].is_null() ? reply : std::string();
+            });
+            if (replies.empty()) {
+                res.status = 204;
+                return;
+            }
+            res.set_content(replies, "application/json");
+            return;
+        }
+        
+        res.set_content(tools_->call(request_body), "application/json");
+        
     } catch (const std::exception& e) {
         json error_response;
         error_response["jsonrpc"] = "2.0";
@@ -412,6 +601,12 @@ void HttpServer::handle_mcp_tools_list(const Request&, Response& res) {
     }
 }
 
+void HttpServer::handle_mcp_tools_list(const Request&, Response& res) {
+    fmt::print("[INFO] Processing MCP tools list request\n");
+
+    res.set_content(R"({"jsonrpc":"2.0","result":)" + tools_->tools_list_result() + "}", "application/json");
+}
+
 void HttpServer::handle_cors(const Request&, Response& res) {
     res.set_header("Access-Control-Allow-Origin", "*");
     res.set_header("Access-Control-Allow-Methods", "GET, POST, OPTIONS");
@@ -1,5 +1,7 @@
 #pragma once
 #include "types.h"
+#include "result_encoding.h"
+#include <functional>
 #include <memory>
 #include <string>
 #include <atomic>
@@ -12,6 +14,10 @@ namespace httplib {
 
 namespace MemoryMCP {
     class MemoryScanner;
+    class ScanSessions;
+    class JobQueue;
+    class ThreadPool;
+    class ToolRegistry;
 
 class HttpServer {
 public:
@@ -25,17 +31,39 @@ private:
     void setup_routes();
     
     void handle_scan(const httplib::Request& req, httplib::Response& res);
+    void handle_scan_pattern(const httplib::Request& req, httplib::Response& res);
+    void handle_scan_unknown(const httplib::Request& req, httplib::Response& res);
+    void handle_scan_compare(const httplib::Request& req, httplib::Response& res);
     void handle_get_addresses(const httplib::Request& req, httplib::Response& res);
+    void handle_list_jobs(const httplib::Request& req, httplib::Response& res);
+    void handle_get_job(const httplib::Request& req, httplib::Response& res);
+    void handle_cancel_job(const httplib::Request& req, httplib::Response& res);
+    void handle_list_sessions(const httplib::Request& req, httplib::Response& res);
+    void handle_close_session(const httplib::Request& req, httplib::Response& res);
     void handle_filter(const httplib::Request& req, httplib::Response& res);
     void handle_reset(const httplib::Request& req, httplib::Response& res);
     void handle_mcp(const httplib::Request& req, httplib::Response& res);
     void handle_mcp_tools_call(const httplib::Request& req, httplib::Response& res);
     void handle_mcp_tools_list(const httplib::Request& req, httplib::Response& res);
     void handle_cors(const httplib::Request& req, httplib::Response& res);
+    // The session named by the body's "session" field, else by the query
+    // parameter, else the default one.
+    std::shared_ptr<MemoryScanner> session(const httplib::Request& req, const nlohmann::json& body = nlohmann::json());
+    // Queues work on jobs_ and answers with the job id.
+    void submit_job(httplib::Response& res, const std::string& kind, const ScanOptions& options,
+                    std::function<nlohmann::json(const ScanOptions&)> work);
+    void stream_addresses(httplib::Response& res, std::shared_ptr<MemoryScanner> scanner, const nlohmann::json& head,
+                          size_t offset, const std::string& cursor, ResultEncoding encoding);
+
+    static constexpr size_t STREAM_PAGE_SIZE = 4096;
+    static constexpr size_t BATCH_THREADS = 4;
 
     uint16_t port_;
     std::unique_ptr<httplib::Server> server_;
-    std::unique_ptr<MemoryScanner> scanner_;
+    std::unique_ptr<ScanSessions> sessions_;
+    std::unique_ptr<ToolRegistry> tools_;
+    std::unique_ptr<JobQueue> jobs_;  // declared after sessions_ so it stops first
+    std::unique_ptr<ThreadPool> batch_pool_;
 };
 
 } // namespace MemoryMCP 
\ No newline at end of file
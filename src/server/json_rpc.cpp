@@ -0,0 +1,94 @@
+#include "json_rpc.h"
+#include "tool_registry.h"
+#include <fmt/base.h>
+
+namespace MemoryMCP {
+
+json json_rpc_error(const json& id, int code, const std::string& message) {
+    return {
+        {"jsonrpc", "2.0"},
+        {"id", id},
+        {"error", {{"code", code}, {"message", message}}}
+    };
+}
+
+std::string json_rpc_result(const json& id, const std::string& result) {
+    std::string id_text = id.dump();
+    std::string reply;
+    reply.reserve(result.size() + id_text.size() + 36);
+    reply += R"({"jsonrpc":"2.0","id":)";
+    reply += id_text;
+    reply += R"(,"result":)";
+    reply += result;
+    reply += '}';
+    return reply;
+}
+
+bool tool_replaces_results(const std::string& tool) {
+    const ToolRegistry::Tool* entry = ToolRegistry::find(tool);
+    return entry && entry->replaces_results;
+}
+
+bool replaces_results(const json& request) {
+    if (!request.is_object() || request.value("method", std::string()) != "tools/call") {
+        return false;
+    }
+    const json& params = request.contains("params") ? request["params"] : json();
+    return params.is_object() && tool_replaces_results(params.value("name", std::string()));
+}
+
+std::string run_json_rpc_batch(const json& batch, ThreadPool& pool,
+                               const std::function<std::string(const json&)>& handle) {
+    if (!batch.is_array() || batch.empty()) {
+        return json_rpc_error(nullptr, -32600, "Invalid Request: empty batch").dump();
+    }
+
+    std::vector<std::string> replies(batch.size());
+    auto answer = [&](size_t index) {
+        const json& request = batch[index];
+        json id = request.is_object() ? request.value("id", json()) : json();
+        try {
+            if (!request.is_object()) {
+                replies[index] = json_rpc_error(nullptr, -32600, "Invalid Request").dump();
+                return;
+            }
+            replies[index] = handle(request);
+        } catch (const std::exception& e) {
+            fmt::print(stderr, "[ERROR] Batch call failed: {}\n", e.what());
+            replies[index] = json_rpc_error(id, -32603, std::string("Internal error: ") + e.what()).dump();
+        }
+    };
+
+    size_t begin = 0;
+    while (begin < batch.size()) {
+        if (replaces_results(batch[begin])) {
+            answer(begin);
+            begin++;
+            continue;
+        }
+        size_t end = begin;
+        while (end < batch.size() && !replaces_results(batch[end])) {
+            end++;
+        }
+        if (end - begin == 1) {
+            answer(begin);
+        } else {
+            pool.parallel_for(end - begin, [&](size_t index, size_t) { answer(begin + index); });
+        }
+        begin = end;
+    }
+
+    std::string result;
+    for (const std::string& reply : replies) {
+        if (!reply.empty()) {
+            result += result.empty() ? '[' : ',';
+            result += reply;
+        }
+    }
+    if (!result.empty()) {
+        result += ']';
+    }
+    return result;
+}
+
+} // namespace MemoryMCP
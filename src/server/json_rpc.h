@@ -0,0 +1,34 @@
+#pragma once
+#include "types.h"
+#include "thread_pool.h"
+#include <functional>
+#include <string>
+
+namespace MemoryMCP {
+
+// JSON-RPC 2.0 pieces shared by the stdio and HTTP transports.
+
+json json_rpc_error(const json& id, int code, const std::string& message);
+
+// Reply carrying result, which is already serialized JSON.
+std::string json_rpc_result(const json& id, const std::string& result);
+
+// True for tools that replace the scanner's results. They must not run
+// alongside or out of order with other calls.
+bool tool_replaces_results(const std::string& tool);
+
+// True for a tools/call of a tool that replaces the results.
+bool replaces_results(const json& request);
+
+// Answers a batch array. Runs of calls that only read results go to pool in
+// parallel. A call that replaces results waits for everything before it,
+// runs alone on the calling thread and holds back everything after it.
+// handle returns a serialized reply, or an empty string for a notification.
+// Exceptions become -32603 errors. Replies keep batch order and are joined
+// into one array; empty if every call was a notification. An empty batch
+// gets a single -32600 error, as the spec requires. Must not be called from
+// a worker of pool.
+std::string run_json_rpc_batch(const json& batch, ThreadPool& pool,
+                               const std::function<std::string(const json&)>& handle);
+
+} // namespace MemoryMCP
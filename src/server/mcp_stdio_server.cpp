@@ -0,0 +1,229 @@
+#include "mcp_stdio_server.h"
+#include "json_rpc.h"
+#include <chrono>
+#include <fmt/format.h>
+
+namespace MemoryMCP {
+
+McpStdioServer::McpStdioServer(std::istream& in, std::ostream& out, size_t worker_count)
+    : in_(in), out_(out), registry_(sessions_),
+      batch_pool_(std::make_unique<ThreadPool>(worker_count)),
+      workers_(std::make_unique<ThreadPool>(worker_count)),
+      scanner_lane_(std::make_unique<ThreadPool>(1)) {
+    writer_ = std::thread(&McpStdioServer::write_loop, this);
+    reporter_ = std::thread(&McpStdioServer::progress_loop, this);
+}
+
+McpStdioServer::~McpStdioServer() {
+    // Pools first: their tasks still send replies.
+    scanner_lane_.reset();
+    workers_.reset();
+    batch_pool_.reset();
+    {
+        std::lock_guard<std::mutex> lock(out_mutex_);
+        stopping_ = true;
+    }
+    out_ready_.notify_all();
+    if (reporter_.joinable()) {
+        reporter_.join();
+    }
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+}
+
+void McpStdioServer::run(const std::atomic<bool>& running) {
+    std::string line;
+    while (running && std::getline(in_, line)) {
+        dispatch(line);
+    }
+    scanner_lane_.reset();
+    workers_.reset();
+}
+
+void McpStdioServer::dispatch(const std::string& line) {
+    json request;
+    try {
+        // Skip empty lines/blank messages
+        if (line.find_first_not_of(" \t\r\n") == std::string::npos) {
+            return;
+        }
+        request = json::parse(line);
+    } catch (const std::exception& e) {
+        // Don't print anything to stdout, to not break MCP indicator
+        fmt::print(stderr, "[ERROR] MCP parse error: {}\n", e.what());
+        return;
+    }
+
+    if (request.is_array()) {
+        // One reply array for the whole batch. The batch takes the scanner
+        // lane if any of its calls replaces results.
+        bool serial = false;
+        for (const json& call : request) {
+            serial = serial || replaces_results(call);
+            track(call);
+        }
+        (serial ? scanner_lane_ : workers_)->submit([this, request]() {
+            std::string replies = run_json_rpc_batch(request, *batch_pool_, [this](const json& call) { return process(call); });
+            if (!replies.empty()) {
+                send(std::move(replies));
+            }
+        });
+        return;
+    }
+
+    // Notifications have no id and are cheap; handle them right here so a
+    // cancellation is not queued behind the call it cancels.
+    if (!request.is_object() || !request.contains("id") || request["id"].is_null()) {
+        process(request);
+        return;
+    }
+
+    track(request);
+    (replaces_results(request) ? scanner_lane_ : workers_)->submit([this, request]() {
+        std::string reply = process(request);
+        if (!reply.empty()) {
+            send(std::move(reply));
+        }
+    });
+}
+
+std::string McpStdioServer::process(const json& request) {
+    if (!request.is_object()) {
+        return json_rpc_error(nullptr, -32600, "Invalid Request").dump();
+    }
+    std::string method = request.value("method", std::string());
+
+    if (!request.contains("id") || request["id"].is_null()) {
+        if (method == "notifications/cancelled" && request.contains("params") && request["params"].is_object()) {
+            cancel(request["params"].value("requestId", json()));
+        }
+        return std::string();
+    }
+
+    std::shared_ptr<Call> call;
+    if (method == "tools/call") {
+        std::lock_guard<std::mutex> lock(calls_mutex_);
+        auto it = calls_.find(request["id"].dump());
+        if (it != calls_.end()) {
+            call = it->second;
+            // Cancelled while it waited for a worker.
+            if (call->progress.cancelled) {
+                calls_.erase(it);
+                fmt::print(stderr, "[INFO] Request {} cancelled before it ran\n", request["id"].dump());
+                return std::string();
+            }
+        }
+    }
+
+    std::string response;
+    try {
+        response = registry_.answer(request, call ? &call->progress : nullptr);
+    } catch (const std::exception& e) {
+        fmt::print(stderr, "[ERROR] MCP request failed: {}\n", e.what());
+        response = json_rpc_error(request["id"], -32603, std::string("Internal error: ") + e.what()).dump();
+    }
+
+    if (call) {
+        std::lock_guard<std::mutex> lock(calls_mutex_);
+        calls_.erase(request["id"].dump());
+        if (call->progress.cancelled) {
+            fmt::print(stderr, "[INFO] Request {} cancelled; reply dropped\n", request["id"].dump());
+            return std::string();
+        }
+    }
+    return response;
+}
+
+void McpStdioServer::track(const json& request) {
+    if (!request.is_object() || !request.contains("id") || request["id"].is_null() ||
+        !request.contains("method") || request["method"] != "tools/call") {
+        return;
+    }
+
+    auto call = std::make_shared<Call>();
+    const json& params = request.contains("params") ? request["params"] : json();
+    if (params.is_object() && params.contains("_meta") && params["_meta"].is_object()) {
+        call->progress_token = params["_meta"].value("progressToken", json());
+    }
+
+    std::lock_guard<std::mutex> lock(calls_mutex_);
+    calls_[request["id"].dump()] = call;
+}
+
+void McpStdioServer::cancel(const json& request_id) {
+    std::lock_guard<std::mutex> lock(calls_mutex_);
+    auto it = calls_.find(request_id.dump());
+    if (it != calls_.end()) {
+        it->second->progress.cancelled = true;
+        fmt::print(stderr, "[INFO] Cancelling request {}\n", it->first);
+    }
+}
+
+void McpStdioServer::send(std::string text) {
+    {
+        std::lock_guard<std::mutex> lock(out_mutex_);
+        out_queue_.push_back(std::move(text));
+    }
+    out_ready_.notify_all();
+}
+
+void McpStdioServer::write_loop() {
+    std::unique_lock<std::mutex> lock(out_mutex_);
+    while (true) {
+        out_ready_.wait(lock, [this] { return stopping_ || !out_queue_.empty(); });
+        if (out_queue_.empty()) {
+            return;
+        }
+        std::deque<std::string> pending;
+        pending.swap(out_queue_);
+
+        // Everything queued goes out in one write.
+        lock.unlock();
+        std::string buffer;
+        for (const std::string& text : pending) {
+            buffer += text;
+            buffer += '\n';
+        }
+        out_.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        out_.flush();
+        lock.lock();
+    }
+}
+
+void McpStdioServer::progress_loop() {
+    std::unique_lock<std::mutex> lock(out_mutex_);
+    while (!out_ready_.wait_for(lock, PROGRESS_INTERVAL, [this] { return stopping_; })) {
+        lock.unlock();
+
+        {
+            // Sent under calls_mutex_, so no notification is queued after
+            // process() drops the call and its reply goes out.
+            std::lock_guard<std::mutex> calls_lock(calls_mutex_);
+            for (auto& entry : calls_) {
+                Call& call = *entry.second;
+                uint64_t scanned = call.progress.bytes_scanned;
+                if (call.progress_token.is_null() || scanned == call.reported || call.progress.cancelled) {
+                    continue;
+                }
+                call.reported = scanned;
+                json notification = {
+                    {"jsonrpc", "2.0"},
+                    {"method", "notifications/progress"},
+                    {"params", {
+                        {"progressToken", call.progress_token},
+                        {"progress", scanned},
+                        {"total", call.progress.bytes_total.load()},
+                        {"message", fmt::format("{} of {} regions, {} hits", call.progress.regions_done.load(),
+                                                call.progress.regions_total.load(), call.progress.hits.load())}
+                    }}
+                };
+                send(notification.dump());
+            }
+        }
+
+        lock.lock();
+    }
+}
+
+} // namespace MemoryMCP
@@ -0,0 +1,83 @@
+#pragma once
+#include "types.h"
+#include "scan_sessions.h"
+#include "scan_engine.h"
+#include "thread_pool.h"
+#include "tool_registry.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <istream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+namespace MemoryMCP {
+
+// MCP over stdio. A reader parses one JSON-RPC message per line and hands
+// requests to workers; every reply goes through one writer thread, so a long
+// scan neither blocks other requests nor interleaves its output with theirs.
+// Tool calls that replace the scanner's results run one at a time in arrival
+// order; everything else runs as soon as a worker is free. Requests with
+// params._meta.progressToken get notifications/progress while they run, and
+// notifications/cancelled stops the scan behind the named request, whose
+// reply is then dropped. A batch array is answered with one reply array.
+class McpStdioServer {
+public:
+    McpStdioServer(std::istream& in, std::ostream& out, size_t worker_count = 4);
+    ~McpStdioServer();
+
+    McpStdioServer(const McpStdioServer&) = delete;
+    McpStdioServer& operator=(const McpStdioServer&) = delete;
+
+    // Serves until in ends or running turns false, then waits for the
+    // requests already accepted and flushes their replies.
+    void run(const std::atomic<bool>& running);
+
+private:
+    // A tool call in flight; progress is shared with the scan it runs.
+    struct Call {
+        ScanProgress progress;
+        json progress_token;
+        uint64_t reported = 0;
+    };
+
+    void dispatch(const std::string& line);
+    // Registers a tool call before it is queued, so it can be cancelled
+    // while it waits for a worker.
+    void track(const json& request);
+    // Serialized reply to one message; empty for notifications and
+    // cancelled calls.
+    std::string process(const json& request);
+    void cancel(const json& request_id);
+    void send(std::string text);
+    void write_loop();
+    void progress_loop();
+
+    static constexpr auto PROGRESS_INTERVAL = std::chrono::milliseconds(250);
+
+    std::istream& in_;
+    std::ostream& out_;
+    ScanSessions sessions_;
+    ToolRegistry registry_;
+
+    std::mutex calls_mutex_;
+    std::map<std::string, std::shared_ptr<Call>> calls_;  // keyed by the dumped request id
+
+    std::mutex out_mutex_;
+    std::condition_variable out_ready_;
+    std::deque<std::string> out_queue_;
+    bool stopping_ = false;
+
+    std::thread writer_;
+    std::thread reporter_;
+    std::unique_ptr<ThreadPool> batch_pool_;    // runs the read-only calls of batches
+    std::unique_ptr<ThreadPool> workers_;
+    std::unique_ptr<ThreadPool> scanner_lane_;  // one worker, so FIFO
+};
+
+} // namespace MemoryMCP
@@ -0,0 +1,159 @@
+#include "result_encoding.h"
+#include <cctype>
+#include <stdexcept>
+
+namespace MemoryMCP {
+
+bool parse_result_encoding(const std::string& name, ResultEncoding& out) {
+    if (name == "json") {
+        out = ResultEncoding::JSON;
+    } else if (name == "cbor") {
+        out = ResultEncoding::CBOR;
+    } else if (name == "msgpack") {
+        out = ResultEncoding::MSGPACK;
+    } else if (name == "raw") {
+        out = ResultEncoding::RAW;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+ResultEncoding negotiate_result_encoding(const std::string& accept) {
+    size_t begin = 0;
+    while (begin < accept.size()) {
+        size_t end = accept.find(',', begin);
+        if (end == std::string::npos) {
+            end = accept.size();
+        }
+        std::string media;
+        for (size_t i = begin; i < end && accept[i] != ';'; ++i) {
+            if (!std::isspace(static_cast<unsigned char>(accept[i]))) {
+                media += static_cast<char>(std::tolower(static_cast<unsigned char>(accept[i])));
+            }
+        }
+        begin = end + 1;
+
+        if (media == "application/json") {
+            return ResultEncoding::JSON;
+        }
+        if (media == "application/cbor" || media == "application/cbor-seq") {
+            return ResultEncoding::CBOR;
+        }
+        if (media == "application/msgpack" || media == "application/x-msgpack" || media == "application/vnd.msgpack") {
+            return ResultEncoding::MSGPACK;
+        }
+        if (media == "application/octet-stream") {
+            return ResultEncoding::RAW;
+        }
+    }
+    return ResultEncoding::JSON;
+}
+
+const char* result_encoding_content_type(ResultEncoding encoding) {
+    switch (encoding) {
+        case ResultEncoding::CBOR: return "application/cbor";
+        case ResultEncoding::MSGPACK: return "application/msgpack";
+        case ResultEncoding::RAW: return "application/octet-stream";
+        default: return "application/json";
+    }
+}
+
+std::string encode_addresses(const AddressesResponse& page, ResultEncoding encoding) {
+    if (encoding == ResultEncoding::JSON) {
+        return json(page).dump();
+    }
+    std::string out;
+    if (encoding == ResultEncoding::RAW) {
+        append_packed_addresses(out, page.raw_addresses);
+        return out;
+    }
+
+    json j = {
+        {"addresses", page.raw_addresses},
+        {"values", page.values},
+        {"count", page.count},
+        {"message", page.message},
+        {"success", page.success},
+        {"total", page.total},
+        {"offset", page.offset},
+        {"next_cursor", page.next_cursor}
+    };
+    if (encoding == ResultEncoding::CBOR) {
+        json::to_cbor(j, out);
+    } else {
+        json::to_msgpack(j, out);
+    }
+    return out;
+}
+
+void append_packed_addresses(std::string& out, const std::vector<uint64_t>& addresses) {
+    size_t at = out.size();
+    out.resize(at + addresses.size() * sizeof(uint64_t));
+    for (uint64_t address : addresses) {
+        for (size_t byte = 0; byte < sizeof(uint64_t); ++byte) {
+            out[at++] = static_cast<char>(address >> (8 * byte));
+        }
+    }
+}
+
+std::string base64_encode(const std::string& bytes) {
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    std::string out;
+    out.reserve((bytes.size() + 2) / 3 * 4);
+    size_t i = 0;
+    for (; i + 3 <= bytes.size(); i += 3) {
+        uint32_t group = static_cast<uint8_t>(bytes[i]) << 16 | static_cast<uint8_t>(bytes[i + 1]) << 8 |
+                         static_cast<uint8_t>(bytes[i + 2]);
+        out += alphabet[group >> 18];
+        out += alphabet[(group >> 12) & 63];
+        out += alphabet[(group >> 6) & 63];
+        out += alphabet[group & 63];
+    }
+    if (i < bytes.size()) {
+        uint32_t group = static_cast<uint8_t>(bytes[i]) << 16;
+        if (i + 1 < bytes.size()) {
+            group |= static_cast<uint8_t>(bytes[i + 1]) << 8;
+        }
+        out += alphabet[group >> 18];
+        out += alphabet[(group >> 12) & 63];
+        out += i + 1 < bytes.size() ? alphabet[(group >> 6) & 63] : '=';
+        out += '=';
+    }
+    return out;
+}
+
+std::string base64_decode(const std::string& text) {
+    std::string out;
+    out.reserve(text.size() / 4 * 3 + 2);
+    uint32_t group = 0;
+    int bits = 0;
+    for (char c : text) {
+        int sextet;
+        if (c >= 'A' && c <= 'Z') {
+            sextet = c - 'A';
+        } else if (c >= 'a' && c <= 'z') {
+            sextet = c - 'a' + 26;
+        } else if (c >= '0' && c <= '9') {
+            sextet = c - '0' + 52;
+        } else if (c == '+') {
+            sextet = 62;
+        } else if (c == '/') {
+            sextet = 63;
+        } else if (c == '=') {
+            break;
+        } else {
+            throw std::invalid_argument("Invalid base64");
+        }
+        group = (group << 6) | static_cast<uint32_t>(sextet);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out += static_cast<char>((group >> bits) & 0xFF);
+        }
+    }
+    return out;
+}
+
+} // namespace MemoryMCP
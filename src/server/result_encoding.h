@@ -0,0 +1,34 @@
+#pragma once
+#include "types.h"
+#include <string>
+#include <vector>
+
+namespace MemoryMCP {
+
+// How pages of addresses are sent. JSON carries hex strings. CBOR and
+// MessagePack carry the same page with addresses as numbers, so clients need
+// not parse text. RAW is only the addresses, packed as little-endian uint64.
+enum class ResultEncoding {
+    JSON,
+    CBOR,
+    MSGPACK,
+    RAW
+};
+
+// json, cbor, msgpack or raw; false for anything else.
+bool parse_result_encoding(const std::string& name, ResultEncoding& out);
+// The first media type in an Accept header that names an encoding, or JSON
+// if none does. Quality values are ignored.
+ResultEncoding negotiate_result_encoding(const std::string& accept);
+const char* result_encoding_content_type(ResultEncoding encoding);
+
+// page must come from get_addresses with numeric set unless encoding is JSON.
+std::string encode_addresses(const AddressesResponse& page, ResultEncoding encoding);
+// Appends addresses as little-endian uint64 values.
+void append_packed_addresses(std::string& out, const std::vector<uint64_t>& addresses);
+std::string base64_encode(const std::string& bytes);
+// Accepts padded or unpadded input; throws std::invalid_argument on any
+// other character.
+std::string base64_decode(const std::string& text);
+
+} // namespace MemoryMCP
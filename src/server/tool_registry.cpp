@@ -0,0 +1,456 @@
+#include "tool_registry.h"
+#include "address_input.h"
+#include "json_rpc.h"
+#include "result_encoding.h"
+#include <stdexcept>
+#include <vector>
+#include <fmt/format.h>
+
+namespace MemoryMCP {
+
+namespace {
+
+json text_result(const std::string& text, bool is_error) {
+    return {
+        {"content", json::array({
+            {
+                {"type", "text"},
+                {"text", text}
+            }
+        })},
+        {"isError", is_error}
+    };
+}
+
+const json& empty_object() {
+    static const json object = json::object();
+    return object;
+}
+
+} // namespace
+
+const ToolRegistry::Tool ToolRegistry::TOOLS[ToolRegistry::TOOL_COUNT] = {
+    {"scan_memory", true, &ToolRegistry::scan_memory},
+    {"scan_pattern", true, &ToolRegistry::scan_pattern},
+    {"scan_unknown_value", true, &ToolRegistry::scan_unknown_value},
+    {"compare_scan", true, &ToolRegistry::compare_scan},
+    {"get_addresses", false, &ToolRegistry::get_addresses},
+    {"filter_addresses", true, &ToolRegistry::filter_addresses},
+    {"reset_memory_scanner", true, &ToolRegistry::reset_memory_scanner},
+    {"list_sessions", false, &ToolRegistry::list_sessions},
+    {"close_session", true, &ToolRegistry::close_session}
+};
+
+ToolRegistry::ToolRegistry(ScanSessions& sessions) : sessions_(sessions) {
+    initialize_result_ = json{
+        {"protocolVersion", "2024-11-05"},
+        {"capabilities", {
+            {"tools", {{"listChanged", false}}}
+        }},
+        {"serverInfo", {
+            {"name", "memory-mcp-server"},
+            {"version", "1.0.0"}
+        }}
+    }.dump();
+    json schemas = tool_schemas();
+    for (json& tool : schemas["tools"]) {
+        if (tool["name"] != "list_sessions") {
+            tool["inputSchema"]["properties"]["session"] = {
+                {"type", "string"},
+                {"description", "Scan session to work on; created on first use (default \"default\")"}
+            };
+        }
+        if (tool["name"] == "scan_memory" || tool["name"] == "scan_pattern" || tool["name"] == "scan_unknown_value") {
+            tool["inputSchema"]["properties"]["regions"] = region_filter_schema();
+        }
+    }
+    tools_list_result_ = schemas.dump();
+
+    // Build the name table now rather than on the first tools/call.
+    find(std::string_view());
+}
+
+uint32_t ToolRegistry::hash_name(std::string_view name, uint32_t seed) {
+    // FNV-1a, then a murmur finalizer so every bit reaches the low ones.
+    uint32_t hash = 2166136261u ^ seed;
+    for (char c : name) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+ToolRegistry::NameTable ToolRegistry::build_name_table() {
+    // With 9 names in 32 slots about one seed in four works.
+    NameTable table;
+    for (uint32_t seed = 0;; ++seed) {
+        table.slots.fill(-1);
+        bool collided = false;
+        for (size_t i = 0; i < TOOL_COUNT && !collided; ++i) {
+            int8_t& slot = table.slots[hash_name(TOOLS[i].name, seed) % TABLE_SIZE];
+            collided = slot >= 0;
+            slot = static_cast<int8_t>(i);
+        }
+        if (!collided) {
+            table.seed = seed;
+            return table;
+        }
+    }
+}
+
+const ToolRegistry::Tool* ToolRegistry::find(std::string_view name) {
+    static const NameTable table = build_name_table();
+    int8_t index = table.slots[hash_name(name, table.seed) % TABLE_SIZE];
+    return index >= 0 && name == TOOLS[index].name ? &TOOLS[index] : nullptr;
+}
+
+std::string ToolRegistry::answer(const json& request, ScanProgress* progress) {
+    json id = request.value("id", json());
+    if (!request.contains("method")) {
+        return json_rpc_error(id, -32600, "Invalid Request").dump();
+    }
+    const std::string& method = request["method"].get_ref<const std::string&>();
+
+    // MCP: 'initialized' is a notification normally (no id). If it ever comes with id, return empty result.
+    if (method == "initialized") {
+        return json_rpc_result(id, "{}");
+    }
+    if (method == "initialize") {
+        return json_rpc_result(id, initialize_result_);
+    }
+    if (method == "tools/list") {
+        return json_rpc_result(id, tools_list_result_);
+    }
+    if (method == "tools/call") {
+        return call(request, progress);
+    }
+    return json_rpc_error(id, -32601, "Unknown method: " + method).dump();
+}
+
+std::string ToolRegistry::call(const json& request, ScanProgress* progress) {
+    json id = request.value("id", json());
+    auto params = request.find("params");
+    const json& params_object = params != request.end() ? *params : empty_object();
+    const std::string& name = params_object.at("name").get_ref<const std::string&>();
+
+    const Tool* tool = find(name);
+    if (!tool) {
+        return json_rpc_error(id, -32601, "Unknown tool: " + name).dump();
+    }
+    auto arguments = params_object.find("arguments");
+    const json& arguments_object = arguments != params_object.end() && !arguments->is_null() ? *arguments : empty_object();
+    return json_rpc_result(id, (this->*tool->handler)(arguments_object, progress).dump());
+}
+
+json ToolRegistry::scan_memory(const json& arguments, ScanProgress* progress) {
+    std::string process_name = arguments.at("process_name");
+    std::string value = arguments.at("value");
+    std::string type_str = arguments.at("value_type");
+
+    ValueType value_type = string_to_value_type(type_str);
+    ScanOptions options;
+    options.progress = progress;
+    options.thread_count = arguments.value("threads", size_t(0));
+    options.regions = region_filter_from_json(arguments);
+    ScanCondition condition = scan_condition_from_json(arguments);
+    ScanResponse scan_response = session(arguments)->scan_memory(process_name, value, value_type, options, condition);
+
+    return text_result("Scan completed. Found " + std::to_string(scan_response.count) + " addresses at alignment " +
+                           std::to_string(scan_response.alignment) + ".",
+                       !scan_response.success);
+}
+
+json ToolRegistry::scan_pattern(const json& arguments, ScanProgress* progress) {
+    std::string process_name = arguments.at("process_name");
+    std::vector<std::string> signatures = arguments.at("signatures");
+    ScanOptions options;
+    options.progress = progress;
+    options.thread_count = arguments.value("threads", size_t(0));
+    options.regions = region_filter_from_json(arguments);
+    PatternScanResponse pattern_response = session(arguments)->scan_pattern(process_name, signatures, options);
+
+    // Per signature: its match count and the first few matches.
+    std::vector<std::string> listed(pattern_response.counts.size());
+    for (const auto& match : pattern_response.matches) {
+        listed[match.signature] += fmt::format("\n  0x{:X}  {}", match.address, match.bytes);
+    }
+    std::string text = pattern_response.message;
+    for (size_t n = 0; n < listed.size(); ++n) {
+        text += fmt::format("\n[{}] {}: {} matches", n, signatures[n], pattern_response.counts[n]) + listed[n];
+    }
+    return text_result(text, !pattern_response.success);
+}
+
+json ToolRegistry::scan_unknown_value(const json& arguments, ScanProgress* progress) {
+    std::string process_name = arguments.at("process_name");
+    std::string type_str = arguments.at("value_type");
+
+    ValueType value_type = string_to_value_type(type_str);
+    ScanOptions options;
+    options.progress = progress;
+    options.thread_count = arguments.value("threads", size_t(0));
+    options.regions = region_filter_from_json(arguments);
+    ScanResponse scan_response = session(arguments)->scan_unknown(process_name, value_type, options);
+
+    return text_result(scan_response.message, !scan_response.success);
+}
+
+json ToolRegistry::compare_scan(const json& arguments, ScanProgress* progress) {
+    CompareOp op = string_to_compare_op(arguments.at("op"));
+    std::string operand = arguments.value("value", std::string());
+    ScanOptions options;
+    options.progress = progress;
+    options.thread_count = arguments.value("threads", size_t(0));
+    ScanResponse scan_response = session(arguments)->compare_scan(op, operand, options);
+
+    return text_result(scan_response.message, !scan_response.success);
+}
+
+json ToolRegistry::get_addresses(const json& arguments, ScanProgress*) {
+    size_t max_count = arguments.value("max_count", 100);
+    size_t offset = arguments.value("offset", size_t(0));
+    std::string cursor = arguments.value("cursor", std::string());
+    std::string encoding_name = arguments.value("encoding", std::string("json"));
+    ResultEncoding encoding;
+    if (!parse_result_encoding(encoding_name, encoding)) {
+        return text_result("Unknown encoding: " + encoding_name, true);
+    }
+    AddressesResponse addr_response = session(arguments)->get_addresses(max_count, offset, cursor, encoding != ResultEncoding::JSON);
+
+    // Binary pages travel as a base64 blob beside a one-line summary.
+    if (encoding != ResultEncoding::JSON) {
+        if (!addr_response.success) {
+            return text_result(addr_response.message, true);
+        }
+        std::string summary = fmt::format("Encoded addresses {}-{} of {} as {}", addr_response.offset,
+                                          addr_response.offset + addr_response.count, addr_response.total, encoding_name);
+        if (!addr_response.next_cursor.empty()) {
+            summary += "; next cursor: " + addr_response.next_cursor;
+        }
+        json result = text_result(summary, false);
+        result["content"].push_back({
+            {"type", "resource"},
+            {"resource", {
+                {"uri", fmt::format("memory://addresses?offset={}&count={}", addr_response.offset, addr_response.count)},
+                {"mimeType", result_encoding_content_type(encoding)},
+                {"blob", base64_encode(encode_addresses(addr_response, encoding))}
+            }}
+        });
+        return result;
+    }
+
+    std::string addresses_text = addr_response.success ? "Found addresses:\n" : addr_response.message + "\n";
+    for (size_t i = 0; i < addr_response.addresses.size(); ++i) {
+        addresses_text += addr_response.addresses[i];
+        if (i < addr_response.values.size()) {
+            addresses_text += " = " + addr_response.values[i];
+        }
+        addresses_text += "\n";
+    }
+    if (!addr_response.next_cursor.empty()) {
+        addresses_text += "Showing " + std::to_string(addr_response.offset) + "-" +
+                          std::to_string(addr_response.offset + addr_response.count) + " of " +
+                          std::to_string(addr_response.total) + "; next cursor: " + addr_response.next_cursor + "\n";
+    }
+    return text_result(addresses_text, !addr_response.success);
+}
+
+json ToolRegistry::filter_addresses(const json& arguments, ScanProgress*) {
+    std::string new_value = arguments.at("new_value");
+    std::string type_str = arguments.at("value_type");
+
+    // Decoded into one uint64 buffer, without a string per address. With no
+    // list at all, every stored result is re-checked.
+    std::vector<uint64_t> addresses;
+    bool all_results = false;
+    if (arguments.contains("addresses_packed")) {
+        std::string packed = base64_decode(arguments["addresses_packed"].get_ref<const std::string&>());
+        unpack_addresses(packed.data(), packed.size(), addresses);
+    } else if (arguments.contains("addresses") && !arguments["addresses"].is_null()) {
+        const json& items = arguments["addresses"];
+        if (!items.is_array()) {
+            throw std::invalid_argument("addresses must be an array");
+        }
+        size_t invalid = decode_addresses(items, addresses);
+        if (invalid > 0) {
+            fmt::print(stderr, "[WARNING] Ignored {} invalid addresses\n", invalid);
+        }
+    } else {
+        all_results = true;
+    }
+
+    ValueType value_type = string_to_value_type(type_str);
+    FilterResponse filter_response = session(arguments)->filter_addresses(std::move(addresses), new_value, value_type, all_results);
+
+    return text_result("Filtering completed. Remaining: " + std::to_string(filter_response.count) + " addresses.",
+                       !filter_response.success);
+}
+
+json ToolRegistry::reset_memory_scanner(const json& arguments, ScanProgress*) {
+    ResetResponse reset_response = session(arguments)->reset();
+    return text_result(reset_response.message, !reset_response.success);
+}
+
+json ToolRegistry::list_sessions(const json&, ScanProgress*) {
+    std::string text = "Sessions:\n";
+    for (const SessionInfo& info : sessions_.list()) {
+        text += fmt::format("{}: PID {}, {} {} {}\n", info.name, info.process_id, info.count,
+                            value_type_to_string(info.value_type), info.snapshot ? "candidates" : "results");
+    }
+    return text_result(text, false);
+}
+
+json ToolRegistry::close_session(const json& arguments, ScanProgress*) {
+    std::string name = arguments.at("session");
+    bool closed = sessions_.close(name);
+    return text_result(closed ? "Session " + name + " closed" : "Unknown session: " + name, !closed);
+}
+
+std::shared_ptr<MemoryScanner> ToolRegistry::session(const json& arguments) {
+    return sessions_.get(arguments.value("session", std::string()));
+}
+
+json ToolRegistry::region_filter_schema() {
+    return {
+        {"type", "object"},
+        {"description", "Which readable regions to scan (default all)"},
+        {"properties", {
+            {"writable", {{"type", "boolean"}, {"description", "Writable regions only"}}},
+            {"executable", {{"type", "boolean"}, {"description", "Executable regions only"}}},
+            {"skip_image", {{"type", "boolean"}, {"description", "Skip executables and libraries"}}},
+            {"skip_mapped", {{"type", "boolean"}, {"description", "Skip mapped data files"}}},
+            {"modules", {{"type", "array"}, {"items", {{"type", "string"}}}, {"description", "Only regions backed by these files, e.g. game.exe"}}},
+            {"start", {{"type", "string"}, {"description", "Start of the address window, hex with 0x"}}},
+            {"end", {{"type", "string"}, {"description", "End of the address window (exclusive)"}}},
+            {"min_size", {{"type", "integer"}, {"description", "Smallest region size in bytes"}}},
+            {"max_size", {{"type", "integer"}, {"description", "Largest region size in bytes"}}}
+        }}
+    };
+}
+
+json ToolRegistry::tool_schemas() {
+    return {
+        {"tools", json::array({
+            {
+                {"name", "scan_memory"},
+                {"description", "Scans process memory for specified value"},
+                {"inputSchema", {
+                    {"type", "object"},
+                    {"properties", {
+                        {"process_name", {{"type", "string"}, {"description", "Process name"}}},
+                        {"value", {{"type", "string"}, {"description", "Search value"}}},
+                        {"value_type", {{"type", "string"}, {"description", "Data type"}}},
+                        {"predicate", {{"type", "string"}, {"enum", json::array({"eq", "ne", "lt", "gt", "between", "epsilon", "rounded"})}, {"description", "Test applied to each value (default eq)"}}},
+                        {"upper", {{"type", "string"}, {"description", "Inclusive upper bound for between; value is the lower bound"}}},
+                        {"epsilon", {{"type", "number"}, {"description", "Tolerance around value for epsilon (float types)"}}},
+                        {"digits", {{"type", "integer"}, {"description", "Decimal digits kept for rounded (float types)"}}},
+                        {"encodings", {{"type", "array"}, {"items", {{"type", "string"}, {"enum", json::array({"utf8", "utf16le", "utf32le"})}}}, {"description", "String encodings to search at once (default utf8, utf16le)"}}},
+                        {"ignore_case", {{"type", "boolean"}, {"description", "Match ASCII letters in either case (strings)"}}},
+                        {"alignment", {{"oneOf", json::array({{{"type", "integer"}, {"enum", json::array({1, 2, 4, 8})}},
+                                                              {{"type", "string"}, {"enum", json::array({"natural"})}}})},
+                                       {"description", "Stride between tested addresses; natural (default) uses the value's size"}}},
+                        {"threads", {{"type", "integer"}, {"description", "Worker threads (0 = all cores)"}}}
+                    }},
+                    {"required", json::array({"process_name", "value", "value_type"})}
+                }}
+            },
+            {
+                {"name", "scan_pattern"},
+                {"description", "Scans process memory for array-of-bytes signatures such as \"48 8B 05 ?? ?? ?? ?? 48 85 C0\"; all signatures share one pass"},
+                {"inputSchema", {
+                    {"type", "object"},
+                    {"properties", {
+                        {"process_name", {{"type", "string"}, {"description", "Process name"}}},
+                        {"signatures", {{"type", "array"}, {"items", {{"type", "string"}}}, {"description", "Hex byte signatures; ?? masks a byte, 4? or ?5 a nibble"}}},
+                        {"threads", {{"type", "integer"}, {"description", "Worker threads (0 = all cores)"}}}
+                    }},
+                    {"required", json::array({"process_name", "signatures"})}
+                }}
+            },
+            {
+                {"name", "scan_unknown_value"},
+                {"description", "Snapshots process memory for a value whose initial value is unknown"},
+                {"inputSchema", {
+                    {"type", "object"},
+                    {"properties", {
+                        {"process_name", {{"type", "string"}, {"description", "Process name"}}},
+                        {"value_type", {{"type", "string"}, {"description", "Numeric data type"}}},
+                        {"threads", {{"type", "integer"}, {"description", "Worker threads (0 = all cores)"}}}
+                    }},
+                    {"required", json::array({"process_name", "value_type"})}
+                }}
+            },
+            {
+                {"name", "compare_scan"},
+                {"description", "Keeps candidates whose value changed, stayed the same, increased or decreased since the last scan"},
+                {"inputSchema", {
+                    {"type", "object"},
+                    {"properties", {
+                        {"op", {{"type", "string"}, {"enum", json::array({"changed", "unchanged", "increased", "decreased", "increased_by", "decreased_by"})}, {"description", "Comparison with the previous value"}}},
+                        {"value", {{"type", "string"}, {"description", "Step for increased_by / decreased_by"}}},
+                        {"threads", {{"type", "integer"}, {"description", "Worker threads (0 = all cores)"}}}
+                    }},
+                    {"required", json::array({"op"})}
+                }}
+            },
+            {
+                {"name", "get_addresses"},
+                {"description", "Gets found memory addresses one page at a time"},
+                {"inputSchema", {
+                    {"type", "object"},
+                    {"properties", {
+                        {"max_count", {{"type", "integer"}, {"description", "Maximum number of addresses"}}},
+                        {"offset", {{"type", "integer"}, {"description", "Index of the first address to return"}}},
+                        {"cursor", {{"type", "string"}, {"description", "next_cursor of a previous page; overrides offset"}}},
+                        {"encoding", {{"type", "string"}, {"enum", json::array({"json", "cbor", "msgpack", "raw"})}, {"description", "json lists the page as text; the others return it as a base64 blob resource (raw: packed little-endian uint64 addresses)"}}}
+                    }}
+                }}
+            },
+            {
+                {"name", "filter_addresses"},
+                {"description", "Re-reads scanned addresses and keeps those that now hold new_value"},
+                {"inputSchema", {
+                    {"type", "object"},
+                    {"properties", {
+                        {"addresses", {{"type", "array"}, {"description", "Addresses to re-check; omit to re-check all results"}}},
+                        {"addresses_packed", {{"type", "string"}, {"description", "Base64 of little-endian uint64 addresses, the raw encoding of get_addresses; replaces addresses"}}},
+                        {"new_value", {{"type", "string"}, {"description", "New value"}}},
+                        {"value_type", {{"type", "string"}, {"description", "Data type"}}}
+                    }},
+                    {"required", json::array({"new_value", "value_type"})}
+                }}
+            },
+            {
+                {"name", "reset_memory_scanner"},
+                {"description", "Resets all search data"},
+                {"inputSchema", {
+                    {"type", "object"},
+                    {"properties", json::object()}
+                }}
+            },
+            {
+                {"name", "list_sessions"},
+                {"description", "Lists the scan sessions with their process, value type and result count"},
+                {"inputSchema", {
+                    {"type", "object"},
+                    {"properties", json::object()}
+                }}
+            },
+            {
+                {"name", "close_session"},
+                {"description", "Closes a scan session and frees its results"},
+                {"inputSchema", {
+                    {"type", "object"},
+                    {"properties", json::object()},
+                    {"required", json::array({"session"})}
+                }}
+            }
+        })}
+    };
+}
+
+} // namespace MemoryMCP
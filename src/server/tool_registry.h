@@ -0,0 +1,81 @@
+#pragma once
+#include "types.h"
+#include "memory_scanner.h"
+#include "scan_sessions.h"
+#include "scan_engine.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace MemoryMCP {
+
+// The MCP methods and tools, shared by the stdio and HTTP transports. Tool
+// names map to handlers through a perfect hash found once at startup, so a
+// tools/call costs one hash and one name compare. The initialize and
+// tools/list results never change; they are serialized once and answering
+// them copies a string into the reply. Every tool but list_sessions takes a
+// session argument naming the ScanSessions entry it works on.
+class ToolRegistry {
+public:
+    using Handler = json (ToolRegistry::*)(const json& arguments, ScanProgress* progress);
+
+    struct Tool {
+        const char* name;
+        // Replaces the scanner's results, so it must not run alongside or
+        // out of order with other calls.
+        bool replaces_results;
+        Handler handler;
+    };
+
+    explicit ToolRegistry(ScanSessions& sessions);
+
+    ToolRegistry(const ToolRegistry&) = delete;
+    ToolRegistry& operator=(const ToolRegistry&) = delete;
+
+    // nullptr for an unknown tool.
+    static const Tool* find(std::string_view name);
+
+    const std::string& initialize_result() const { return initialize_result_; }
+    const std::string& tools_list_result() const { return tools_list_result_; }
+
+    // Serialized reply to any MCP request; scans report to progress if
+    // given. Throws on malformed params.
+    std::string answer(const json& request, ScanProgress* progress = nullptr);
+    // Serialized reply to request taken as a tools/call, whatever its method.
+    std::string call(const json& request, ScanProgress* progress = nullptr);
+
+private:
+    json scan_memory(const json& arguments, ScanProgress* progress);
+    json scan_pattern(const json& arguments, ScanProgress* progress);
+    json scan_unknown_value(const json& arguments, ScanProgress* progress);
+    json compare_scan(const json& arguments, ScanProgress* progress);
+    json get_addresses(const json& arguments, ScanProgress* progress);
+    json filter_addresses(const json& arguments, ScanProgress* progress);
+    json reset_memory_scanner(const json& arguments, ScanProgress* progress);
+    json list_sessions(const json& arguments, ScanProgress* progress);
+    json close_session(const json& arguments, ScanProgress* progress);
+
+    std::shared_ptr<MemoryScanner> session(const json& arguments);
+
+    static json tool_schemas();
+    static json region_filter_schema();
+
+    static constexpr size_t TOOL_COUNT = 9;
+    static constexpr size_t TABLE_SIZE = 32;  // power of two, at least twice TOOL_COUNT
+    static const Tool TOOLS[TOOL_COUNT];
+
+    // Slot hash(name, seed) % TABLE_SIZE holds the tool's index into TOOLS.
+    struct NameTable {
+        uint32_t seed = 0;
+        std::array<int8_t, TABLE_SIZE> slots{};
+    };
+    static NameTable build_name_table();
+    static uint32_t hash_name(std::string_view name, uint32_t seed);
+
+    ScanSessions& sessions_;
+    std::string initialize_result_;
+    std::string tools_list_result_;
+};
+
+} // namespace MemoryMCP
@@ -2,6 +2,7 @@
 #include <string>
 #include <vector>
 #include <cstdint>
+#include <stdexcept>
 #include <nlohmann/json.hpp>
 
 #ifdef _WIN32
@@ -23,9 +24,16 @@ using json = nlohmann::json;
 
 namespace MemoryMCP {
 
-constexpr size_t MAX_REGIONS = 1000;
-constexpr size_t MAX_REGION_SIZE = 1024 * 1024;
 constexpr size_t BUFFER_SIZE = 4096;
+constexpr size_t SCAN_CHUNK_SIZE = 1024 * 1024;
+constexpr size_t SCAN_STRIPE_CHUNKS = 8;
+constexpr size_t MAX_SCAN_THREADS = 256;
+constexpr size_t RESULT_DELTA_THRESHOLD = 1 << 20;
+constexpr size_t CANDIDATE_RUN_GAP = 4096;
+constexpr size_t CANDIDATE_RUN_SIZE = 64 * 1024;
+constexpr size_t SNAPSHOT_MATERIALIZE_LIMIT = 1 << 20;
+constexpr size_t SNAPSHOT_PAGE_SIZE = 4096;
+constexpr size_t PATTERN_MATCHES_KEPT = 10;
 
 enum class ValueType {
     STRING,
@@ -37,6 +45,44 @@ enum class ValueType {
     FLOAT64
 };
 
+// Comparison of each candidate's current value against its previous one, for
+// scans where the initial value is unknown.
+enum class CompareOp {
+    CHANGED,
+    UNCHANGED,
+    INCREASED,
+    DECREASED,
+    INCREASED_BY,
+    DECREASED_BY
+};
+
+// How scan_memory tests each element against the search value.
+enum class ScanPredicate {
+    EQUAL,      // same representation as value
+    NOT_EQUAL,
+    LESS,
+    GREATER,
+    BETWEEN,    // value <= x <= upper
+    EPSILON,    // |x - value| <= epsilon (float types)
+    ROUNDED     // x rounded to digits decimals equals value (float types)
+};
+
+// Encodings a string scan looks for.
+enum class StringEncoding {
+    UTF8,
+    UTF16LE,
+    UTF32LE
+};
+
+// Lifecycle of an asynchronous scan job.
+enum class JobState {
+    QUEUED,
+    RUNNING,
+    COMPLETED,
+    FAILED,
+    CANCELLED
+};
+
 struct MemoryAddress {
     uintptr_t address;
     std::string value;
@@ -53,13 +99,104 @@ struct ScanRequest {
     NLOHMANN_DEFINE_TYPE_INTRUSIVE(ScanRequest, process_name, value, value_type)
 };
 
+// The optional predicate fields of a scan request, passed down to the kernels.
+struct ScanCondition {
+    ScanPredicate predicate = ScanPredicate::EQUAL;
+    std::string upper;
+    double epsilon = 0.0;
+    int digits = 0;
+    std::vector<StringEncoding> encodings = {StringEncoding::UTF8, StringEncoding::UTF16LE};
+    bool ignore_case = false;
+    size_t alignment = 0;  // stride between tested addresses: 1, 2, 4 or 8; 0 = the value's size
+};
+
+// Which readable regions a scan reads; the defaults select all of them.
+struct RegionFilter {
+    bool writable = false;             // writable regions only
+    bool executable = false;           // executable regions only
+    bool skip_image = false;           // skip executables and libraries
+    bool skip_mapped = false;          // skip mapped data files
+    std::vector<std::string> modules;  // if set, only regions backed by these files (any case)
+    uint64_t start = 0;                // address window [start, end); regions are clipped to it
+    uint64_t end = UINT64_MAX;
+    size_t min_size = 0;               // region size bounds, before clipping; 0 = none
+    size_t max_size = 0;
+};
+
+struct ScanProgress;
+
+struct ScanOptions {
+    size_t thread_count = 0;              // 0 = one worker per hardware thread
+    size_t chunk_size = SCAN_CHUNK_SIZE;  // bytes handed to a worker at a time
+    ScanProgress* progress = nullptr;     // live counters and cancellation, if any
+    RegionFilter regions;
+};
+
+struct ScanStats {
+    size_t thread_count = 0;
+    size_t chunk_count = 0;
+    size_t bytes_scanned = 0;
+    double elapsed_ms = 0.0;
+    double busy_ms = 0.0;   // summed over all workers
+    double speedup = 0.0;   // busy_ms / elapsed_ms
+    // Compare scans only: pages diffed, pages whose hash was unchanged, pages without candidates.
+    size_t pages_compared = 0;
+    size_t pages_unchanged = 0;
+    size_t pages_skipped = 0;
+    
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE(ScanStats, thread_count, chunk_count, bytes_scanned, elapsed_ms, busy_ms, speedup,
+                                   pages_compared, pages_unchanged, pages_skipped)
+};
+
 struct ScanResponse {
     std::vector<MemoryAddress> addresses;
     size_t count;
     std::string message;
     bool success;
+    ScanStats stats;
+    std::string cursor;  // first page of the results for get_addresses
+    size_t alignment = 0;  // stride the scan tested addresses at
     
-    NLOHMANN_DEFINE_TYPE_INTRUSIVE(ScanResponse, addresses, count, message, success)
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE(ScanResponse, addresses, count, message, success, stats, cursor, alignment)
+};
+
+struct PatternMatch {
+    uintptr_t address;
+    size_t signature;   // index into the scanned signatures
+    std::string bytes;  // matched bytes as hex
+    
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE(PatternMatch, address, signature, bytes)
+};
+
+struct PatternScanResponse {
+    std::vector<PatternMatch> matches;  // the first PATTERN_MATCHES_KEPT of each signature
+    std::vector<size_t> counts;  // matches per signature
+    size_t count;
+    std::string message;
+    bool success;
+    ScanStats stats;
+    std::string cursor;  // first page of the match addresses for get_addresses
+    
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE(PatternScanResponse, matches, counts, count, message, success, stats, cursor)
+};
+
+struct JobStatus {
+    std::string id;
+    std::string kind;
+    JobState state = JobState::QUEUED;
+    uint64_t bytes_scanned = 0;
+    uint64_t bytes_total = 0;
+    size_t regions_done = 0;
+    size_t regions_total = 0;
+    size_t hits = 0;
+    double elapsed_ms = 0.0;
+    double eta_ms = 0.0;  // 0 until a running job has progress to extrapolate from
+    json result;          // the scan's response once the job has finished
+    std::string message;
+    bool success = false;
+    
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE(JobStatus, id, kind, state, bytes_scanned, bytes_total, regions_done, regions_total,
+                                   hits, elapsed_ms, eta_ms, result, message, success)
 };
 
 struct AddressesRequest {
@@ -70,11 +207,27 @@ struct AddressesRequest {
 
 struct AddressesResponse {
     std::vector<std::string> addresses;
+    std::vector<std::string> values;  // empty when the results carry no values
     size_t count;
     std::string message;
     bool success;
+    size_t total = 0;         // results in the whole set
+    size_t offset = 0;        // index of addresses[0] in the set
+    std::string next_cursor;  // empty on the last page
+    std::vector<uint64_t> raw_addresses;  // filled instead of addresses for binary encodings
+    
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE(AddressesResponse, addresses, values, count, message, success, total, offset, next_cursor)
+};
+
+struct SessionInfo {
+    std::string name;
+    uint32_t process_id = 0;
+    ValueType value_type = ValueType::INT32;
+    size_t count = 0;        // results, or candidates while snapshot is set
+    bool snapshot = false;   // tracking an unknown value
+    uint64_t generation = 0;
     
-    NLOHMANN_DEFINE_TYPE_INTRUSIVE(AddressesResponse, addresses, count, message, success)
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE(SessionInfo, name, process_id, value_type, count, snapshot, generation)
 };
 
 struct FilterRequest {
@@ -90,8 +243,9 @@ struct FilterResponse {
     size_t count;
     std::string message;
     bool success;
+    std::string cursor;  // first page of the kept results for get_addresses
     
-    NLOHMANN_DEFINE_TYPE_INTRUSIVE(FilterResponse, addresses, count, message, success)
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE(FilterResponse, addresses, count, message, success, cursor)
 };
 
 struct ResetResponse {
@@ -134,6 +288,19 @@ inline std::string value_type_to_string(ValueType type) {
     }
 }
 
+// Width in bytes of a numeric value type; 0 for strings.
+inline size_t value_type_size(ValueType type) {
+    switch (type) {
+        case ValueType::INT:
+        case ValueType::INT32:
+        case ValueType::FLOAT:
+        case ValueType::FLOAT32: return 4;
+        case ValueType::INT64:
+        case ValueType::FLOAT64: return 8;
+        default: return 0;
+    }
+}
+
 inline ValueType string_to_value_type(const std::string& type_str) {
     if (type_str == "string") return ValueType::STRING;
     if (type_str == "int") return ValueType::INT;
@@ -145,6 +312,177 @@ inline ValueType string_to_value_type(const std::string& type_str) {
     return ValueType::STRING;
 }
 
+inline std::string compare_op_to_string(CompareOp op) {
+    switch (op) {
+        case CompareOp::CHANGED: return "changed";
+        case CompareOp::UNCHANGED: return "unchanged";
+        case CompareOp::INCREASED: return "increased";
+        case CompareOp::DECREASED: return "decreased";
+        case CompareOp::INCREASED_BY: return "increased_by";
+        case CompareOp::DECREASED_BY: return "decreased_by";
+        default: return "unknown";
+    }
+}
+
+inline CompareOp string_to_compare_op(const std::string& op_str) {
+    if (op_str == "changed") return CompareOp::CHANGED;
+    if (op_str == "unchanged") return CompareOp::UNCHANGED;
+    if (op_str == "increased") return CompareOp::INCREASED;
+    if (op_str == "decreased") return CompareOp::DECREASED;
+    if (op_str == "increased_by") return CompareOp::INCREASED_BY;
+    if (op_str == "decreased_by") return CompareOp::DECREASED_BY;
+    throw std::invalid_argument("Unknown compare op: " + op_str);
+}
+
+inline std::string scan_predicate_to_string(ScanPredicate predicate) {
+    switch (predicate) {
+        case ScanPredicate::EQUAL: return "eq";
+        case ScanPredicate::NOT_EQUAL: return "ne";
+        case ScanPredicate::LESS: return "lt";
+        case ScanPredicate::GREATER: return "gt";
+        case ScanPredicate::BETWEEN: return "between";
+        case ScanPredicate::EPSILON: return "epsilon";
+        case ScanPredicate::ROUNDED: return "rounded";
+        default: return "unknown";
+    }
+}
+
+inline ScanPredicate string_to_scan_predicate(const std::string& predicate_str) {
+    if (predicate_str == "eq") return ScanPredicate::EQUAL;
+    if (predicate_str == "ne") return ScanPredicate::NOT_EQUAL;
+    if (predicate_str == "lt") return ScanPredicate::LESS;
+    if (predicate_str == "gt") return ScanPredicate::GREATER;
+    if (predicate_str == "between") return ScanPredicate::BETWEEN;
+    if (predicate_str == "epsilon") return ScanPredicate::EPSILON;
+    if (predicate_str == "rounded") return ScanPredicate::ROUNDED;
+    throw std::invalid_argument("Unknown scan predicate: " + predicate_str);
+}
+
+inline std::string job_state_to_string(JobState state) {
+    switch (state) {
+        case JobState::QUEUED: return "queued";
+        case JobState::RUNNING: return "running";
+        case JobState::COMPLETED: return "completed";
+        case JobState::FAILED: return "failed";
+        case JobState::CANCELLED: return "cancelled";
+        default: return "unknown";
+    }
+}
+
+inline std::string string_encoding_to_string(StringEncoding encoding) {
+    switch (encoding) {
+        case StringEncoding::UTF8: return "utf8";
+        case StringEncoding::UTF16LE: return "utf16le";
+        case StringEncoding::UTF32LE: return "utf32le";
+        default: return "unknown";
+    }
+}
+
+inline StringEncoding string_to_string_encoding(const std::string& encoding_str) {
+    if (encoding_str == "utf8") return StringEncoding::UTF8;
+    if (encoding_str == "utf16le") return StringEncoding::UTF16LE;
+    if (encoding_str == "utf32le") return StringEncoding::UTF32LE;
+    throw std::invalid_argument("Unknown string encoding: " + encoding_str);
+}
+
+// Reads the optional predicate fields of a scan request body; an unknown
+// predicate throws instead of silently falling back to equality.
+inline ScanCondition scan_condition_from_json(const json& j) {
+    ScanCondition condition;
+    condition.predicate = string_to_scan_predicate(j.value("predicate", std::string("eq")));
+    condition.upper = j.value("upper", std::string());
+    condition.epsilon = j.value("epsilon", 0.0);
+    condition.digits = j.value("digits", 0);
+    if (j.contains("encodings")) {
+        condition.encodings.clear();
+        for (const auto& encoding : j.at("encodings")) {
+            condition.encodings.push_back(string_to_string_encoding(encoding.get<std::string>()));
+        }
+    }
+    condition.ignore_case = j.value("ignore_case", false);
+    // "natural" (the default) strides by the value's size; strings always use 1.
+    auto alignment = j.find("alignment");
+    if (alignment != j.end() && !alignment->is_null() && *alignment != "natural") {
+        int64_t stride = alignment->is_number_integer() ? alignment->get<int64_t>() : 0;
+        if (stride != 1 && stride != 2 && stride != 4 && stride != 8) {
+            throw std::invalid_argument("alignment must be 1, 2, 4, 8 or \"natural\"");
+        }
+        condition.alignment = static_cast<size_t>(stride);
+    }
+    return condition;
+}
+
+// Reads the optional "regions" object of a scan request body. Addresses are
+// numbers or strings, hex with a 0x prefix.
+inline RegionFilter region_filter_from_json(const json& j) {
+    RegionFilter filter;
+    auto regions = j.find("regions");
+    if (regions == j.end() || regions->is_null()) {
+        return filter;
+    }
+    if (!regions->is_object()) {
+        throw std::invalid_argument("regions must be an object");
+    }
+
+    auto address = [&](const char* key, uint64_t fallback) -> uint64_t {
+        auto field = regions->find(key);
+        if (field == regions->end()) {
+            return fallback;
+        }
+        if (field->is_number_unsigned()) {
+            return field->get<uint64_t>();
+        }
+        std::string text = field->is_string() ? field->get<std::string>() : field->dump();
+        size_t used = 0;
+        uint64_t value = 0;
+        try {
+            value = std::stoull(text, &used, 0);
+        } catch (const std::exception&) {
+            used = 0;
+        }
+        if (text.empty() || used != text.size() || text[0] == '-') {
+            throw std::invalid_argument(std::string("Invalid regions.") + key + ": " + text);
+        }
+        return value;
+    };
+
+    filter.writable = regions->value("writable", false);
+    filter.executable = regions->value("executable", false);
+    filter.skip_image = regions->value("skip_image", false);
+    filter.skip_mapped = regions->value("skip_mapped", false);
+    filter.modules = regions->value("modules", std::vector<std::string>());
+    filter.start = address("start", 0);
+    filter.end = address("end", UINT64_MAX);
+    filter.min_size = regions->value("min_size", size_t(0));
+    filter.max_size = regions->value("max_size", size_t(0));
+    if (filter.start >= filter.end) {
+        throw std::invalid_argument("regions.start must be below regions.end");
+    }
+    return filter;
+}
+
+// Ops that take a value operand (the X in "increased by X").
+inline bool compare_op_has_operand(CompareOp op) {
+    return op == CompareOp::INCREASED_BY || op == CompareOp::DECREASED_BY;
+}
+
+NLOHMANN_JSON_SERIALIZE_ENUM(CompareOp, {
+    {CompareOp::CHANGED, "changed"},
+    {CompareOp::UNCHANGED, "unchanged"},
+    {CompareOp::INCREASED, "increased"},
+    {CompareOp::DECREASED, "decreased"},
+    {CompareOp::INCREASED_BY, "increased_by"},
+    {CompareOp::DECREASED_BY, "decreased_by"}
+})
+
+NLOHMANN_JSON_SERIALIZE_ENUM(JobState, {
+    {JobState::QUEUED, "queued"},
+    {JobState::RUNNING, "running"},
+    {JobState::COMPLETED, "completed"},
+    {JobState::FAILED, "failed"},
+    {JobState::CANCELLED, "cancelled"}
+})
+
 NLOHMANN_JSON_SERIALIZE_ENUM(ValueType, {
     {ValueType::STRING, "string"},
     {ValueType::INT, "int"},
@@ -155,6 +493,7 @@ NLOHMANN_JSON_SERIALIZE_ENUM(ValueType, {
     {ValueType::FLOAT64, "float64"}
 })
 
+#ifdef _WIN32
 inline std::wstring string_to_wstring(const std::string& str) {
     int size_needed = MultiByteToWideChar(CP_UTF8, 0, str.c_str(), (int)str.length(), NULL, 0);
     std::wstring wstrTo(size_needed, 0);
@@ -168,5 +507,6 @@ inline std::string wstring_to_string(const std::wstring& wstr) {
     WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), (int)wstr.length(), &strTo[0], size_needed, NULL, NULL);
     return strTo;
 }
+#endif
 
 } // namespace MemoryMCP 
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+#include "memory/memory_source.h"
+#include <cstring>
+#include <vector>
+
+namespace MemoryMCP {
+
+// Serves reads from buffers owned by the test instead of another process.
+// Reads touching [hole_begin, hole_end) stop there, like an unmapped page.
+class FakeMemorySource : public MemorySource {
+public:
+    const char* name() const override { return "fake"; }
+    DWORD find_process_by_name(const std::string&) override { return 1; }
+    bool open(DWORD) override { return true; }
+    void close() override {}
+    bool is_open() const override { return true; }
+    DWORD process_id() const override { return 1; }
+    bool is_alive() const override { return true; }
+    bool update_process_index(std::map<DWORD, std::string>& index) override {
+        index = {{1, "fake"}};
+        return true;
+    }
+    bool process_matches(DWORD process_id, const std::string& process_name) override {
+        return process_id == 1 && process_name == "fake";
+    }
+
+    std::vector<MemoryRegion> enumerate_regions() override {
+        std::vector<MemoryRegion> regions;
+        for (auto& block : blocks) {
+            regions.push_back({reinterpret_cast<uintptr_t>(block.data()), block.size(), PROTECTION_READ});
+        }
+        return regions;
+    }
+
+    bool update_regions(std::vector<MemoryRegion>& regions) override {
+        region_updates++;
+        std::vector<MemoryRegion> current = enumerate_regions();
+        if (current == regions) {
+            return false;
+        }
+        regions.swap(current);
+        return true;
+    }
+
+    size_t read(uintptr_t address, void* buffer, size_t size) override {
+        read_calls++;
+        return copy(address, buffer, size);
+    }
+
+    size_t read_batch(std::vector<ReadRequest>& requests) override {
+        batch_calls++;
+        size_t total = 0;
+        for (auto& request : requests) {
+            request.bytes_read = copy(request.address, request.buffer, request.size);
+            total += request.bytes_read;
+        }
+        return total;
+    }
+
+    std::vector<std::vector<uint8_t>> blocks;
+    uintptr_t hole_begin = 0;
+    uintptr_t hole_end = 0;
+    size_t read_calls = 0;
+    size_t batch_calls = 0;
+    size_t region_updates = 0;
+
+private:
+    size_t copy(uintptr_t address, void* buffer, size_t size) {
+        if (address < hole_end && address + size > hole_begin) {
+            size = address < hole_begin ? hole_begin - address : 0;
+        }
+        std::memcpy(buffer, reinterpret_cast<const void*>(address), size);
+        return size;
+    }
+};
+
+} // namespace MemoryMCP
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include "server/address_input.h"
+#include "server/result_encoding.h"
+
+using namespace MemoryMCP;
+
+TEST(AddressInputTest, ParsesFilterRequest) {
+    FilterInput input = parse_filter_input(R"({
+        "note": {"addresses": ["0x1"], "new_value": "ignored"},
+        "addresses": ["0x7FFE1000", 4096, "deadbeef", "zz", -1, 1.5, null, ["0x2"], {"a": "0x3"}],
+        "new_value": "100",
+        "value_type": "int32",
+        "extra": [1, 2, 3]
+    })");
+
+    ASSERT_EQ(input.addresses.size(), 3);
+    EXPECT_EQ(input.addresses[0], 0x7FFE1000ull);
+    EXPECT_EQ(input.addresses[1], 4096ull);
+    EXPECT_EQ(input.addresses[2], 0xDEADBEEFull);
+    EXPECT_EQ(input.listed, 9);
+    EXPECT_EQ(input.invalid, 6);
+    EXPECT_EQ(input.new_value, "100");
+    EXPECT_EQ(input.value_type, "int32");
+
+    FilterInput empty = parse_filter_input(R"({"addresses": [], "new_value": "1", "value_type": "int8"})");
+    EXPECT_TRUE(empty.addresses.empty());
+    EXPECT_EQ(empty.listed, 0);
+    EXPECT_FALSE(empty.all_results);
+    EXPECT_FALSE(input.all_results);
+
+    // An omitted or null list re-checks every result.
+    FilterInput omitted = parse_filter_input(R"({"new_value": "1", "value_type": "int8"})");
+    EXPECT_TRUE(omitted.addresses.empty());
+    EXPECT_TRUE(omitted.all_results);
+    EXPECT_TRUE(parse_filter_input(R"({"addresses": null, "new_value": "1", "value_type": "int8"})").all_results);
+}
+
+TEST(AddressInputTest, RejectsBadFilterRequests) {
+    EXPECT_THROW(parse_filter_input(R"({"addresses": ["0x1"], "new_value": "1"})"), std::invalid_argument);
+    EXPECT_THROW(parse_filter_input(R"({"addresses": "0x1", "new_value": "1", "value_type": "int8"})"), std::invalid_argument);
+    EXPECT_THROW(parse_filter_input(R"({"addresses": ["0x1"], "new_value": 1, "value_type": "int8"})"), std::invalid_argument);
+    EXPECT_THROW(parse_filter_input(R"({"addresses": {"a": "0x1"}, "new_value": "1", "value_type": "int8"})"), std::invalid_argument);
+    EXPECT_THROW(parse_filter_input(R"(["0x1"])"), std::invalid_argument);
+    EXPECT_THROW(parse_filter_input(R"({"addresses": ["0x1", )"), std::invalid_argument);
+    EXPECT_THROW(parse_filter_input(""), std::invalid_argument);
+}
+
+TEST(AddressInputTest, DecodesArraysAndPackedAddresses) {
+    std::vector<uint64_t> addresses;
+    EXPECT_EQ(decode_addresses(json::array({"0x10", 32, "nope", true}), addresses), 2);
+    EXPECT_EQ(addresses, (std::vector<uint64_t>{0x10, 32}));
+
+    std::string packed;
+    append_packed_addresses(packed, {0x1000, 0xFFFFFFFFFFFFFFFFull, 0x7FFE12345678ull});
+    addresses.clear();
+    unpack_addresses(packed.data(), packed.size(), addresses);
+    EXPECT_EQ(addresses, (std::vector<uint64_t>{0x1000, 0xFFFFFFFFFFFFFFFFull, 0x7FFE12345678ull}));
+
+    EXPECT_THROW(unpack_addresses(packed.data(), 7, addresses), std::invalid_argument);
+
+    // Packed addresses survive the base64 trip the MCP tools use.
+    addresses.clear();
+    std::string decoded = base64_decode(base64_encode(packed));
+    unpack_addresses(decoded.data(), decoded.size(), addresses);
+    EXPECT_EQ(addresses.size(), 3);
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "memory/candidate_reader.h"
+#include "fake_memory_source.h"
+#include <cstring>
+
+using namespace MemoryMCP;
+
+TEST(CandidateReaderTest, CoalescesNearbyCandidates) {
+    FakeMemorySource source;
+    std::vector<uint8_t> block(1024 * 1024);
+    for (size_t i = 0; i + 4 <= block.size(); i += 4) {
+        uint32_t value = static_cast<uint32_t>(i);
+        std::memcpy(block.data() + i, &value, sizeof(value));
+    }
+    source.blocks.push_back(std::move(block));
+    uintptr_t base = reinterpret_cast<uintptr_t>(source.blocks[0].data());
+
+    ResultSet candidates(ValueType::INT32, 4);
+    for (size_t offset = 0; offset < 1024 * 1024; offset += 64) {
+        candidates.append(base + offset, source.blocks[0].data() + offset);
+    }
+
+    CandidateReader reader(source, 4);
+    size_t visited = 0;
+    size_t readable = reader.read(candidates, [&](size_t index, uint64_t address, const uint8_t* value, size_t length) {
+        ASSERT_NE(value, nullptr);
+        EXPECT_EQ(length, 4);
+        EXPECT_EQ(address, candidates.address(index));
+        uint32_t current;
+        std::memcpy(&current, value, sizeof(current));
+        EXPECT_EQ(current, static_cast<uint32_t>(address - base));
+        visited++;
+    });
+
+    EXPECT_EQ(readable, candidates.size());
+    EXPECT_EQ(visited, candidates.size());
+    // 16384 candidates in 64 KiB runs: 16 runs, not one read per value.
+    EXPECT_LE(reader.run_count(), 17);
+    EXPECT_EQ(source.read_calls, 0);
+}
+
+TEST(CandidateReaderTest, SeparatesDistantCandidatesAndSkipsHoles) {
+    FakeMemorySource source;
+    source.blocks.push_back(std::vector<uint8_t>(64 * 1024, 0xAB));
+    uintptr_t base = reinterpret_cast<uintptr_t>(source.blocks[0].data());
+
+    // The hole sits inside one run; the candidate after it is read on its own.
+    source.hole_begin = base + 1000;
+    source.hole_end = base + 1100;
+
+    ResultSet candidates(ValueType::INT64, 8);
+    uint8_t old_value[8] = {};
+    for (size_t offset : {0, 992, 1000, 1200, 40000}) {
+        candidates.append(base + offset, old_value);
+    }
+
+    CandidateReader reader(source, 8);
+    std::vector<uint64_t> unreadable;
+    size_t readable = reader.read(candidates, [&](size_t, uint64_t address, const uint8_t* value, size_t) {
+        if (value == nullptr) {
+            unreadable.push_back(address);
+        } else {
+            EXPECT_EQ(value[0], 0xAB);
+        }
+    });
+
+    EXPECT_EQ(readable, 4);
+    EXPECT_EQ(unreadable, std::vector<uint64_t>{base + 1000});
+    EXPECT_EQ(reader.run_count(), 2);
+}
+
+TEST(CandidateReaderTest, ReadsUpToMaxWidth) {
+    FakeMemorySource source;
+    source.blocks.push_back(std::vector<uint8_t>(64 * 1024, 0xCD));
+    uintptr_t base = reinterpret_cast<uintptr_t>(source.blocks[0].data());
+
+    // Only 3 of the 6 bytes behind the second candidate are readable.
+    source.hole_begin = base + 1003;
+    source.hole_end = base + 2000;
+
+    ResultSet candidates(ValueType::STRING, 0);
+    for (size_t offset : {100, 1000, 1002}) {
+        candidates.append(base + offset, nullptr);
+    }
+
+    CandidateReader reader(source, 3, 6);
+    std::vector<size_t> lengths;
+    size_t readable = reader.read(candidates, [&](size_t, uint64_t, const uint8_t* value, size_t length) {
+        lengths.push_back(value != nullptr ? length : 0);
+    });
+
+    EXPECT_EQ(readable, 2);
+    EXPECT_EQ(lengths, (std::vector<size_t>{6, 3, 0}));
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include "memory/job_queue.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace MemoryMCP;
+
+namespace {
+
+// Polls until the job leaves the queued and running states.
+JobStatus wait_for(const JobQueue& jobs, const std::string& id) {
+    JobStatus status;
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(jobs.status(id, status));
+        if (status.state != JobState::QUEUED && status.state != JobState::RUNNING) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return status;
+}
+
+} // namespace
+
+TEST(JobQueueTest, RunsJobAndKeepsResult) {
+    JobQueue jobs;
+    std::string id = jobs.submit("scan", ScanOptions(), [](const ScanOptions& options) {
+        EXPECT_NE(options.progress, nullptr);
+        options.progress->bytes_total = 100;
+        options.progress->bytes_scanned = 100;
+        options.progress->hits = 3;
+        return json{{"success", true}, {"message", "Scan completed"}, {"count", 3}};
+    });
+
+    JobStatus status = wait_for(jobs, id);
+    EXPECT_EQ(status.state, JobState::COMPLETED);
+    EXPECT_TRUE(status.success);
+    EXPECT_EQ(status.kind, "scan");
+    EXPECT_EQ(status.message, "Scan completed");
+    EXPECT_EQ(status.hits, 3);
+    EXPECT_EQ(status.bytes_scanned, 100);
+    EXPECT_EQ(status.result["count"], 3);
+
+    json j = status;
+    EXPECT_EQ(j["state"], "completed");
+    EXPECT_EQ(j["id"], id);
+}
+
+TEST(JobQueueTest, FailedScansAndExceptions) {
+    JobQueue jobs;
+    std::string failed = jobs.submit("scan", ScanOptions(), [](const ScanOptions&) {
+        return json{{"success", false}, {"message", "Process not found"}};
+    });
+    std::string thrown = jobs.submit("scan", ScanOptions(), [](const ScanOptions&) -> json {
+        throw std::runtime_error("boom");
+    });
+
+    JobStatus status = wait_for(jobs, failed);
+    EXPECT_EQ(status.state, JobState::FAILED);
+    EXPECT_EQ(status.message, "Process not found");
+
+    status = wait_for(jobs, thrown);
+    EXPECT_EQ(status.state, JobState::FAILED);
+    EXPECT_NE(status.message.find("boom"), std::string::npos);
+}
+
+TEST(JobQueueTest, CancelRunningAndQueuedJobs) {
+    JobQueue jobs;
+    std::atomic<bool> started{false};
+    std::string running = jobs.submit("scan", ScanOptions(), [&](const ScanOptions& options) {
+        started = true;
+        while (!options.progress->cancelled) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return json{{"success", false}, {"message", "Scan cancelled"}};
+    });
+    std::atomic<bool> queued_ran{false};
+    std::string queued = jobs.submit("scan", ScanOptions(), [&](const ScanOptions&) {
+        queued_ran = true;
+        return json{{"success", true}};
+    });
+
+    while (!started) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    JobStatus status;
+    ASSERT_TRUE(jobs.status(running, status));
+    EXPECT_EQ(status.state, JobState::RUNNING);
+    ASSERT_TRUE(jobs.status(queued, status));
+    EXPECT_EQ(status.state, JobState::QUEUED);
+
+    EXPECT_TRUE(jobs.cancel(queued));
+    ASSERT_TRUE(jobs.status(queued, status));
+    EXPECT_EQ(status.state, JobState::CANCELLED);
+
+    EXPECT_TRUE(jobs.cancel(running));
+    status = wait_for(jobs, running);
+    EXPECT_EQ(status.state, JobState::CANCELLED);
+    EXPECT_FALSE(queued_ran);
+
+    EXPECT_FALSE(jobs.cancel("999"));
+    EXPECT_FALSE(jobs.status("999", status));
+    EXPECT_EQ(jobs.list().size(), 2);
+}
+
+TEST(JobQueueTest, EtaFromProgress) {
+    JobQueue jobs;
+    std::atomic<bool> release{false};
+    std::string id = jobs.submit("scan", ScanOptions(), [&](const ScanOptions& options) {
+        options.progress->bytes_total = 1000;
+        options.progress->bytes_scanned = 250;
+        while (!release) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return json{{"success", true}};
+    });
+
+    JobStatus status;
+    for (int i = 0; i < 1000 && status.bytes_scanned == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        ASSERT_TRUE(jobs.status(id, status));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_TRUE(jobs.status(id, status));
+    EXPECT_EQ(status.state, JobState::RUNNING);
+    EXPECT_GT(status.eta_ms, 0.0);
+    EXPECT_NEAR(status.eta_ms, status.elapsed_ms * 3.0, status.elapsed_ms * 0.5);
+
+    release = true;
+    EXPECT_EQ(wait_for(jobs, id).state, JobState::COMPLETED);
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include "server/json_rpc.h"
+#include <mutex>
+#include <vector>
+
+using namespace MemoryMCP;
+
+namespace {
+
+json tool_call(int id, const std::string& tool) {
+    return {{"jsonrpc", "2.0"}, {"id", id}, {"method", "tools/call"}, {"params", {{"name", tool}}}};
+}
+
+} // namespace
+
+TEST(JsonRpcTest, ReplacesResults) {
+    EXPECT_TRUE(replaces_results(tool_call(1, "scan_memory")));
+    EXPECT_TRUE(replaces_results(tool_call(1, "filter_addresses")));
+    EXPECT_FALSE(replaces_results(tool_call(1, "get_addresses")));
+    EXPECT_FALSE(replaces_results(json{{"method", "tools/list"}, {"id", 1}}));
+    EXPECT_FALSE(replaces_results(json::array()));
+}
+
+TEST(JsonRpcTest, BatchKeepsOrderAroundWritingCalls) {
+    ThreadPool pool(4);
+    json batch = json::array({
+        tool_call(1, "get_addresses"), tool_call(2, "get_addresses"), tool_call(3, "get_addresses"),
+        tool_call(4, "reset_memory_scanner"),
+        tool_call(5, "get_addresses"), tool_call(6, "get_addresses")
+    });
+
+    std::mutex mutex;
+    std::vector<int> order;
+    json replies = json::parse(run_json_rpc_batch(batch, pool, [&](const json& request) {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(request["id"]);
+        return json_rpc_result(request["id"], "{}");
+    }));
+
+    // The reset waits for the reads before it and holds back those after it.
+    ASSERT_EQ(order.size(), 6);
+    EXPECT_EQ(order[3], 4);
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (i < 3) {
+            EXPECT_LT(order[i], 4);
+        } else if (i > 3) {
+            EXPECT_GT(order[i], 4);
+        }
+    }
+
+    ASSERT_TRUE(replies.is_array());
+    ASSERT_EQ(replies.size(), 6);
+    for (size_t i = 0; i < replies.size(); ++i) {
+        EXPECT_EQ(replies[i]["id"], static_cast<int>(i + 1));
+    }
+}
+
+TEST(JsonRpcTest, BatchErrorsAndNotifications) {
+    ThreadPool pool(2);
+    json batch = json::array({
+        tool_call(1, "get_addresses"),
+        json{{"jsonrpc", "2.0"}, {"method", "notifications/initialized"}},
+        42,
+        tool_call(2, "boom")
+    });
+
+    json replies = json::parse(run_json_rpc_batch(batch, pool, [](const json& request) -> std::string {
+        if (!request.contains("id")) {
+            return std::string();
+        }
+        if (request["params"]["name"] == "boom") {
+            throw std::runtime_error("boom");
+        }
+        return json_rpc_result(request["id"], "{}");
+    }));
+
+    ASSERT_EQ(replies.size(), 3);
+    EXPECT_EQ(replies[0]["id"], 1);
+    EXPECT_EQ(replies[1]["error"]["code"], -32600);
+    EXPECT_EQ(replies[2]["id"], 2);
+    EXPECT_EQ(replies[2]["error"]["code"], -32603);
+
+    json empty = json::parse(run_json_rpc_batch(json::array(), pool, [](const json&) { return std::string(); }));
+    EXPECT_TRUE(empty.is_object());
+    EXPECT_EQ(empty["error"]["code"], -32600);
+
+    json notifications = json::array({json{{"jsonrpc", "2.0"}, {"method", "notifications/initialized"}}});
+    EXPECT_TRUE(run_json_rpc_batch(notifications, pool, [](const json&) { return std::string(); }).empty());
+}
@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+#include "server/mcp_stdio_server.h"
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+using namespace MemoryMCP;
+
+namespace {
+
+// Feeds input to a server until EOF and returns its output lines by id.
+std::map<std::string, json> serve(const std::string& input, size_t& lines) {
+    std::istringstream in(input);
+    std::ostringstream out;
+    {
+        McpStdioServer server(in, out);
+        std::atomic<bool> running{true};
+        server.run(running);
+    }
+
+    std::map<std::string, json> replies;
+    std::istringstream output(out.str());
+    std::string line;
+    lines = 0;
+    while (std::getline(output, line)) {
+        json message = json::parse(line);
+        replies[message["id"].dump()] = message;
+        lines++;
+    }
+    return replies;
+}
+
+// Output the test can watch while the server writes it.
+class WatchedOutput : public std::streambuf {
+public:
+    bool wait_for(const std::string& text) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return changed_.wait_for(lock, std::chrono::seconds(10), [&] { return text_.find(text) != std::string::npos; });
+    }
+    std::string str() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return text_;
+    }
+
+protected:
+    std::streamsize xsputn(const char* data, std::streamsize size) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            text_.append(data, static_cast<size_t>(size));
+        }
+        changed_.notify_all();
+        return size;
+    }
+    int_type overflow(int_type c) override {
+        if (c != traits_type::eof()) {
+            char byte = traits_type::to_char_type(c);
+            xsputn(&byte, 1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::string text_;
+};
+
+// Input whose second part is handed out only once trigger shows up in output.
+class GatedInput : public std::streambuf {
+public:
+    GatedInput(std::string first, std::string second, WatchedOutput& output, std::string trigger)
+        : first_(std::move(first)), second_(std::move(second)), output_(output), trigger_(std::move(trigger)) {}
+
+protected:
+    int_type underflow() override {
+        if (part_ == 0) {
+            setg(&first_[0], &first_[0], &first_[0] + first_.size());
+        } else if (part_ == 1) {
+            output_.wait_for(trigger_);
+            setg(&second_[0], &second_[0], &second_[0] + second_.size());
+        } else {
+            return traits_type::eof();
+        }
+        part_++;
+        return traits_type::to_int_type(*gptr());
+    }
+
+private:
+    std::string first_;
+    std::string second_;
+    WatchedOutput& output_;
+    std::string trigger_;
+    int part_ = 0;
+};
+
+} // namespace
+
+TEST(McpStdioServerTest, AnswersEveryRequestOnce) {
+    std::string input =
+        R"({"jsonrpc":"2.0","id":1,"method":"initialize","params":{}})" "\n"
+        R"({"jsonrpc":"2.0","method":"notifications/initialized"})" "\n"
+        "not json\n"
+        "\n"
+        R"({"jsonrpc":"2.0","id":"two","method":"tools/list"})" "\n"
+        R"({"jsonrpc":"2.0","id":3,"method":"tools/call","params":{"name":"get_addresses","arguments":{"max_count":5}}})" "\n"
+        R"({"jsonrpc":"2.0","id":4,"method":"no/such/method"})" "\n"
+        R"({"jsonrpc":"2.0","id":5,"method":"tools/call","params":{"name":"scan_memory"}})" "\n"
+        R"({"jsonrpc":"2.0","method":"notifications/cancelled","params":{"requestId":99}})" "\n";
+
+    size_t lines = 0;
+    std::map<std::string, json> replies = serve(input, lines);
+    EXPECT_EQ(lines, 5);
+    ASSERT_EQ(replies.size(), 5);
+
+    EXPECT_EQ(replies["1"]["result"]["protocolVersion"], "2024-11-05");
+    EXPECT_FALSE(replies["\"two\""]["result"]["tools"].empty());
+    EXPECT_FALSE(replies["3"]["result"]["isError"].get<bool>());
+    EXPECT_EQ(replies["4"]["error"]["code"], -32601);
+    // Missing arguments surface as an error reply instead of a silent drop.
+    EXPECT_EQ(replies["5"]["error"]["code"], -32603);
+}
+
+TEST(McpStdioServerTest, RepliesAreWholeLines) {
+    std::string input;
+    for (int id = 0; id < 200; ++id) {
+        input += R"({"jsonrpc":"2.0","id":)" + std::to_string(id) + R"(,"method":"tools/list"})" "\n";
+    }
+
+    size_t lines = 0;
+    std::map<std::string, json> replies = serve(input, lines);
+    EXPECT_EQ(lines, 200);
+    EXPECT_EQ(replies.size(), 200);
+}
+
+TEST(McpStdioServerTest, BatchGetsOneReplyLine) {
+    std::string input =
+        R"([{"jsonrpc":"2.0","id":1,"method":"tools/list"},)"
+        R"({"jsonrpc":"2.0","method":"notifications/initialized"},)"
+        R"({"jsonrpc":"2.0","id":2,"method":"tools/call","params":{"name":"get_addresses","arguments":{}}},)"
+        R"({"jsonrpc":"2.0","id":3,"method":"tools/call","params":{"name":"reset_memory_scanner","arguments":{}}}])" "\n"
+        R"([{"jsonrpc":"2.0","method":"notifications/initialized"}])" "\n";
+
+    std::istringstream in(input);
+    std::ostringstream out;
+    {
+        McpStdioServer server(in, out);
+        std::atomic<bool> running{true};
+        server.run(running);
+    }
+
+    std::istringstream output(out.str());
+    std::string line;
+    ASSERT_TRUE(std::getline(output, line));
+    json replies = json::parse(line);
+    ASSERT_TRUE(replies.is_array());
+    ASSERT_EQ(replies.size(), 3);
+    EXPECT_EQ(replies[0]["id"], 1);
+    EXPECT_EQ(replies[1]["id"], 2);
+    EXPECT_EQ(replies[2]["id"], 3);
+    // A batch of notifications only gets no reply at all.
+    EXPECT_FALSE(std::getline(output, line));
+}
+
+#ifdef __linux__
+TEST(McpStdioServerTest, CancelledCallsGetNoReply) {
+    std::string name;
+    std::ifstream comm("/proc/self/comm");
+    std::getline(comm, name);
+
+    // A signature that matches at every offset of this buffer keeps the scan
+    // busy well past the first progress notification.
+    std::vector<uint8_t> zeros(64 * 1024 * 1024, 0);
+    std::string signature = "00";
+    for (int i = 1; i < 64; ++i) {
+        signature += " 00";
+    }
+    json scan = {{"jsonrpc", "2.0"}, {"id", 1}, {"method", "tools/call"}, {"params", {{"name", "scan_pattern"},
+                 {"arguments", {{"process_name", name}, {"signatures", {signature}}}}, {"_meta", {{"progressToken", "scan"}}}}}};
+    // Queued on the scanner lane behind the scan.
+    json reset = {{"jsonrpc", "2.0"}, {"id", 2}, {"method", "tools/call"}, {"params", {{"name", "reset_memory_scanner"}}}};
+
+    // Both are cancelled once the scan reports progress.
+    WatchedOutput output;
+    GatedInput input(scan.dump() + "\n" + reset.dump() + "\n",
+                     R"({"jsonrpc":"2.0","method":"notifications/cancelled","params":{"requestId":1}})" "\n"
+                     R"({"jsonrpc":"2.0","method":"notifications/cancelled","params":{"requestId":2}})" "\n"
+                     R"({"jsonrpc":"2.0","id":3,"method":"tools/list"})" "\n",
+                     output, R"("progressToken":"scan")");
+    {
+        std::istream in(&input);
+        std::ostream out(&output);
+        McpStdioServer server(in, out);
+        std::atomic<bool> running{true};
+        server.run(running);
+    }
+    EXPECT_EQ(zeros[0], 0);
+
+    std::vector<json> replies;
+    std::istringstream lines(output.str());
+    std::string line;
+    while (std::getline(lines, line)) {
+        json message = json::parse(line);
+        if (message.contains("id")) {
+            replies.push_back(message);
+        }
+    }
+    ASSERT_EQ(replies.size(), 1);
+    EXPECT_EQ(replies[0]["id"], 3);
+}
+#endif
@@ -1,7 +1,18 @@
 #include <gtest/gtest.h>
 #include "memory/memory_scanner.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <memory>
 
+#ifdef __linux__
+#include <csignal>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 using namespace MemoryMCP;
 
 class MemoryScannerTest : public ::testing::Test {
@@ -34,6 +45,32 @@ TEST_F(MemoryScannerTest, GetAddressesEmpty) {
     EXPECT_TRUE(resp.success);
 }
 
+TEST_F(MemoryScannerTest, GetAddressesPaging) {
+    AddressesResponse resp = scanner->get_addresses(10, 5);
+    EXPECT_TRUE(resp.success);
+    EXPECT_EQ(resp.count, 0);
+    EXPECT_EQ(resp.total, 0);
+    EXPECT_EQ(resp.offset, 0);
+    EXPECT_TRUE(resp.next_cursor.empty());
+
+    resp = scanner->get_addresses(10, 0, "0:0");
+    EXPECT_TRUE(resp.success);
+}
+
+TEST_F(MemoryScannerTest, GetAddressesRejectsBadCursors) {
+    for (const char* cursor : {"abc", "1", ":5", "1:", "1:2:3", "-1:0", "99999999999999999999:0"}) {
+        AddressesResponse resp = scanner->get_addresses(10, 0, cursor);
+        EXPECT_FALSE(resp.success) << cursor;
+        EXPECT_FALSE(resp.message.empty());
+    }
+
+    // Resetting replaces the results, so older cursors go stale.
+    scanner->reset();
+    AddressesResponse resp = scanner->get_addresses(10, 0, "0:0");
+    EXPECT_FALSE(resp.success);
+    EXPECT_NE(resp.message.find("Stale"), std::string::npos);
+}
+
 TEST_F(MemoryScannerTest, FilterAddressesEmpty) {
     std::vector<std::string> addresses = {"0x1000", "0x2000"};
     FilterResponse resp = scanner->filter_addresses(addresses, "new_value", ValueType::STRING);
@@ -42,6 +79,27 @@ TEST_F(MemoryScannerTest, FilterAddressesEmpty) {
     EXPECT_TRUE(resp.success);
 }
 
+TEST_F(MemoryScannerTest, FilterDecodedAddressesEmpty) {
+    FilterResponse resp = scanner->filter_addresses(std::vector<uint64_t>{0x2000, 0x1000, 0x2000}, "1", ValueType::INT32, false);
+    EXPECT_TRUE(resp.success);
+    EXPECT_EQ(resp.count, 0);
+
+    resp = scanner->filter_addresses(std::vector<uint64_t>(), "1", ValueType::INT32, true);
+    EXPECT_TRUE(resp.success);
+    EXPECT_EQ(resp.count, 0);
+}
+
+TEST_F(MemoryScannerTest, FilterReturnsCursor) {
+    FilterResponse resp = scanner->filter_addresses(std::vector<uint64_t>(), "1", ValueType::INT32, true);
+    ASSERT_TRUE(resp.success);
+    EXPECT_TRUE(resp.addresses.empty());
+    ASSERT_FALSE(resp.cursor.empty());
+
+    AddressesResponse page = scanner->get_addresses(10, 0, resp.cursor);
+    EXPECT_TRUE(page.success);
+    EXPECT_EQ(page.total, resp.count);
+}
+
 TEST_F(MemoryScannerTest, ScanMemoryInvalidProcess) {
     // Test with non-existent process
     ScanResponse resp = scanner->scan_memory("non_existent_process.exe", "test", ValueType::STRING);
@@ -51,9 +109,6 @@ TEST_F(MemoryScannerTest, ScanMemoryInvalidProcess) {
     EXPECT_FALSE(resp.message.empty());
 }
 
-// Note: value_type_to_string and string_to_value_type are private methods
-// These tests would need the methods to be made public or use friend class
-
 TEST_F(MemoryScannerTest, MemoryScannerLifetime) {
     // Test that scanner can be destroyed and recreated
     scanner.reset();
@@ -63,3 +118,193 @@ TEST_F(MemoryScannerTest, MemoryScannerLifetime) {
     ResetResponse resp = scanner->reset();
     EXPECT_TRUE(resp.success);
 }
+
+#ifdef __linux__
+TEST_F(MemoryScannerTest, FilterAndCompareFailOnceTheProcessExits) {
+    std::vector<int32_t> buffer(1024, 0);
+    buffer[10] = 0x5EED1234;
+    std::string name = ("mcp-exit-" + std::to_string(getpid())).substr(0, 15);
+
+    // A child with its own name holds a copy of buffer.
+    int ready[2];
+    ASSERT_EQ(pipe(ready), 0);
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        prctl(PR_SET_NAME, name.c_str());
+        char byte = 1;
+        if (write(ready[1], &byte, 1) == 1) {
+            pause();
+        }
+        _exit(0);
+    }
+    char byte = 0;
+    bool started = read(ready[0], &byte, 1) == 1;
+    close(ready[0]);
+    close(ready[1]);
+
+    ScanResponse scan;
+    if (started) {
+        scan = scanner->scan_memory(name, std::to_string(buffer[10]), ValueType::INT32);
+    }
+    kill(child, SIGKILL);
+    waitpid(child, nullptr, 0);
+    if (!scan.success || scan.count == 0) {
+        GTEST_SKIP() << "Cannot scan a child process: " << scan.message;
+    }
+
+    FilterResponse filter = scanner->filter_addresses(std::vector<uint64_t>(), std::to_string(buffer[10]), ValueType::INT32, true);
+    EXPECT_FALSE(filter.success);
+    EXPECT_NE(filter.message.find("exited"), std::string::npos);
+
+    ScanResponse compare = scanner->compare_scan(CompareOp::UNCHANGED);
+    EXPECT_FALSE(compare.success);
+    EXPECT_NE(compare.message.find("exited"), std::string::npos);
+    EXPECT_EQ(scanner->info().count, scan.count);
+}
+
+TEST_F(MemoryScannerTest, ScanStaysInAddressWindow) {
+    std::string name;
+    std::ifstream comm("/proc/self/comm");
+    std::getline(comm, name);
+
+    std::vector<int64_t> buffer(4096, 0);
+    buffer[100] = 0x5A5A1234ABCD4321;
+    uint64_t start = reinterpret_cast<uintptr_t>(buffer.data());
+
+    ScanOptions options;
+    options.regions.start = start;
+    options.regions.end = start + buffer.size() * sizeof(int64_t);
+    ScanResponse resp = scanner->scan_memory(name, std::to_string(buffer[100]), ValueType::INT64, options);
+    ASSERT_TRUE(resp.success);
+    if (scanner->info().process_id != static_cast<DWORD>(getpid())) {
+        GTEST_SKIP() << "Another process is called " << name;
+    }
+    ASSERT_EQ(resp.count, 1);
+    AddressesResponse page = scanner->get_addresses(10, 0, std::string(), true);
+    ASSERT_EQ(page.raw_addresses.size(), 1);
+    EXPECT_EQ(page.raw_addresses[0], reinterpret_cast<uintptr_t>(&buffer[100]));
+
+    options.regions.end = reinterpret_cast<uintptr_t>(&buffer[100]);
+    resp = scanner->scan_memory(name, std::to_string(buffer[100]), ValueType::INT64, options);
+    ASSERT_TRUE(resp.success);
+    EXPECT_EQ(resp.count, 0);
+    EXPECT_LE(resp.stats.bytes_scanned, 100 * sizeof(int64_t));
+}
+
+TEST_F(MemoryScannerTest, FilterRejectsSnapshotSessions) {
+    std::string name;
+    std::ifstream comm("/proc/self/comm");
+    std::getline(comm, name);
+
+    std::vector<int32_t> buffer(1024, 7);
+    ScanOptions options;
+    options.regions.start = reinterpret_cast<uintptr_t>(buffer.data());
+    options.regions.end = options.regions.start + buffer.size() * sizeof(int32_t);
+    ScanResponse scan = scanner->scan_unknown(name, ValueType::INT32, options);
+    ASSERT_TRUE(scan.success);
+    uint64_t generation = scanner->info().generation;
+
+    FilterResponse resp = scanner->filter_addresses(std::vector<uint64_t>(), "7", ValueType::INT32, true);
+    EXPECT_FALSE(resp.success);
+    EXPECT_NE(resp.message.find("compare_scan"), std::string::npos);
+    EXPECT_TRUE(scanner->info().snapshot);
+    EXPECT_EQ(scanner->info().generation, generation);
+    EXPECT_TRUE(scanner->get_addresses(10, 0, scan.cursor).success);
+}
+
+TEST_F(MemoryScannerTest, PatternScanKeepsFirstMatchesPerSignature) {
+    std::string name;
+    std::ifstream comm("/proc/self/comm");
+    std::getline(comm, name);
+
+    std::vector<uint8_t> buffer(64 * 1024, 0);
+    for (size_t i = 0; i < 50; ++i) {
+        buffer[i * 1000 + 3] = 0xC3;
+        buffer[i * 1000 + 4] = static_cast<uint8_t>(i);
+    }
+    buffer[60000] = 0xE8;
+    uintptr_t start = reinterpret_cast<uintptr_t>(buffer.data());
+
+    ScanOptions options;
+    options.regions.start = start;
+    options.regions.end = start + buffer.size();
+    PatternScanResponse resp = scanner->scan_pattern(name, {"C3 ??", "E8"}, options);
+    ASSERT_TRUE(resp.success);
+    if (scanner->info().process_id != static_cast<DWORD>(getpid())) {
+        GTEST_SKIP() << "Another process is called " << name;
+    }
+
+    ASSERT_EQ(resp.counts.size(), 2);
+    EXPECT_EQ(resp.counts[0], 50);
+    EXPECT_EQ(resp.counts[1], 1);
+    EXPECT_EQ(resp.count, 51);
+    ASSERT_EQ(resp.matches.size(), PATTERN_MATCHES_KEPT + 1);
+    for (size_t i = 0; i < PATTERN_MATCHES_KEPT; ++i) {
+        EXPECT_EQ(resp.matches[i].address, start + i * 1000 + 3);
+        char bytes[8];
+        std::snprintf(bytes, sizeof(bytes), "C3 %02zX", i);
+        EXPECT_EQ(resp.matches[i].bytes, bytes);
+    }
+    EXPECT_EQ(resp.matches.back().address, start + 60000);
+
+    AddressesResponse page = scanner->get_addresses(100, 0, resp.cursor, true);
+    ASSERT_TRUE(page.success);
+    EXPECT_EQ(page.total, 51);
+}
+
+TEST_F(MemoryScannerTest, FilterKeepsStringsEndingAtUnreadableMemory) {
+    std::string name;
+    std::ifstream comm("/proc/self/comm");
+    std::getline(comm, name);
+
+    // The needle ends where the readable page does; its UTF-16 form would not fit.
+    const size_t page = 4096;
+    void* mapping = mmap(nullptr, 2 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(mapping, MAP_FAILED);
+    uint8_t* bytes = static_cast<uint8_t*>(mapping);
+    ASSERT_EQ(mprotect(bytes + page, page, PROT_NONE), 0);
+    std::string needle = "mcp-tail-" + std::to_string(getpid());
+    std::memcpy(bytes + page - needle.size(), needle.data(), needle.size());
+    uintptr_t planted = reinterpret_cast<uintptr_t>(bytes + page - needle.size());
+
+    auto holds_planted = [&] {
+        for (const auto& address : scanner->get_addresses(1000).addresses) {
+            if (std::stoull(address, nullptr, 16) == planted) {
+                return true;
+            }
+        }
+        return false;
+    };
+    ScanResponse scan = scanner->scan_memory(name, needle, ValueType::STRING);
+    bool found = scan.success && holds_planted();
+    FilterResponse filter = scanner->filter_addresses(std::vector<std::string>(), needle, ValueType::STRING, true);
+    bool kept = holds_planted();
+    munmap(mapping, 2 * page);
+    if (!found) {
+        GTEST_SKIP() << "Cannot scan this process: " << scan.message;
+    }
+    EXPECT_TRUE(filter.success);
+    EXPECT_TRUE(kept);
+}
+
+TEST_F(MemoryScannerTest, FilterWithAnEmptyListKeepsNothing) {
+    std::string name;
+    std::ifstream comm("/proc/self/comm");
+    std::getline(comm, name);
+
+    std::vector<int32_t> buffer(1024, 0);
+    buffer[10] = 0x6A6B6C6D;
+    std::string value = std::to_string(buffer[10]);
+    ScanResponse scan = scanner->scan_memory(name, value, ValueType::INT32);
+    if (!scan.success || scan.count == 0) {
+        GTEST_SKIP() << "Cannot scan this process: " << scan.message;
+    }
+
+    FilterResponse all = scanner->filter_addresses(std::vector<std::string>(), value, ValueType::INT32, true);
+    EXPECT_GE(all.count, 1);
+    FilterResponse none = scanner->filter_addresses(std::vector<std::string>(), value, ValueType::INT32);
+    EXPECT_TRUE(none.success);
+    EXPECT_EQ(none.count, 0);
+}
+#endif
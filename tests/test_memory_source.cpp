@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "memory/memory_source.h"
+#include <cstring>
+#include <memory>
+
+#ifdef __linux__
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace MemoryMCP;
+
+class MemorySourceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        source = create_memory_source();
+    }
+
+    std::unique_ptr<MemorySource> source;
+};
+
+TEST_F(MemorySourceTest, FindNonExistentProcess) {
+    if (!source) {
+        GTEST_SKIP() << "No memory source on this platform";
+    }
+    EXPECT_EQ(source->find_process_by_name("non_existent_process.exe"), 0);
+}
+
+TEST_F(MemorySourceTest, ClosedSourceReadsNothing) {
+    if (!source) {
+        GTEST_SKIP() << "No memory source on this platform";
+    }
+    char buffer[16];
+    EXPECT_FALSE(source->is_open());
+    EXPECT_EQ(source->read(reinterpret_cast<uintptr_t>(buffer), buffer, sizeof(buffer)), 0);
+    EXPECT_TRUE(source->enumerate_regions().empty());
+}
+
+#ifdef __linux__
+TEST_F(MemorySourceTest, EnumerateOwnRegions) {
+    ASSERT_TRUE(source->open(static_cast<DWORD>(getpid())));
+
+    std::vector<uint8_t> heap(4096, 0xAB);
+    uintptr_t address = reinterpret_cast<uintptr_t>(heap.data());
+
+    bool found = false;
+    for (const MemoryRegion& region : source->enumerate_regions()) {
+        if (address >= region.base && address < region.base + region.size) {
+            EXPECT_TRUE(region.protection & PROTECTION_READ);
+            EXPECT_TRUE(region.protection & PROTECTION_WRITE);
+            found = true;
+        }
+    }
+    EXPECT_TRUE(found);
+}
+
+TEST_F(MemorySourceTest, ReadOwnMemory) {
+    ASSERT_TRUE(source->open(static_cast<DWORD>(getpid())));
+
+    const char text[] = "memory source read test";
+    char buffer[sizeof(text)] = {};
+
+    EXPECT_EQ(source->read(reinterpret_cast<uintptr_t>(text), buffer, sizeof(text)), sizeof(text));
+    EXPECT_EQ(std::memcmp(text, buffer, sizeof(text)), 0);
+}
+
+TEST_F(MemorySourceTest, ReadBatchSkipsUnreadableEntries) {
+    ASSERT_TRUE(source->open(static_cast<DWORD>(getpid())));
+
+    std::vector<uint32_t> first(256, 0x11111111);
+    std::vector<uint32_t> second(256, 0x22222222);
+    std::vector<uint32_t> out_first(256), out_bad(256), out_second(256);
+
+    std::vector<ReadRequest> batch = {
+        {reinterpret_cast<uintptr_t>(first.data()), out_first.data(), 1024, 0},
+        {static_cast<uintptr_t>(16), out_bad.data(), 1024, 0},
+        {reinterpret_cast<uintptr_t>(second.data()), out_second.data(), 1024, 0}
+    };
+
+    EXPECT_EQ(source->read_batch(batch), 2048);
+    EXPECT_EQ(batch[0].bytes_read, 1024);
+    EXPECT_EQ(batch[1].bytes_read, 0);
+    EXPECT_EQ(batch[2].bytes_read, 1024);
+    EXPECT_EQ(out_first, first);
+    EXPECT_EQ(out_second, second);
+}
+
+TEST_F(MemorySourceTest, NotAliveAfterExit) {
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        pause();
+        _exit(0);
+    }
+
+    ASSERT_TRUE(source->open(static_cast<DWORD>(child)));
+    EXPECT_TRUE(source->is_alive());
+
+    kill(child, SIGKILL);
+    waitpid(child, nullptr, 0);
+    EXPECT_FALSE(source->is_alive());
+
+    source->close();
+    EXPECT_FALSE(source->is_alive());
+}
+#endif
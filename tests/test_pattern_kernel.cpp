@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "memory/pattern_kernel.h"
+#include "memory/simd_kernels.h"
+#include <cstring>
+#include <random>
+
+using namespace MemoryMCP;
+
+class PatternKernelTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::mt19937 rng(7);
+        buffer.resize(8192);
+        for (auto& byte : buffer) {
+            byte = static_cast<uint8_t>(rng());
+        }
+    }
+
+    void plant(size_t offset, std::initializer_list<uint8_t> bytes) {
+        std::copy(bytes.begin(), bytes.end(), buffer.begin() + offset);
+    }
+
+    std::vector<PatternHit> scan(const PatternKernel& kernel) {
+        std::vector<PatternHit> hits;
+        kernel.scan(buffer.data(), buffer.size(), buffer.size(), hits);
+        return hits;
+    }
+
+    std::vector<uint8_t> buffer;
+};
+
+TEST_F(PatternKernelTest, ParsePattern) {
+    BytePattern pattern = parse_pattern("48 8B 05 ?? ?? ? 4? ?5");
+    std::vector<uint8_t> value = {0x48, 0x8B, 0x05, 0x00, 0x00, 0x00, 0x40, 0x05};
+    std::vector<uint8_t> mask = {0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0xF0, 0x0F};
+    EXPECT_EQ(pattern.value, value);
+    EXPECT_EQ(pattern.mask, mask);
+    // 0x05 is rarer than the REX prefix and the mov opcode.
+    EXPECT_EQ(pattern.anchor, 2u);
+
+    BytePattern compact = parse_pattern("488b05????");
+    EXPECT_EQ(compact.value.size(), 5u);
+    EXPECT_EQ(compact.mask[3], 0x00);
+
+    EXPECT_THROW(parse_pattern(""), std::invalid_argument);
+    EXPECT_THROW(parse_pattern("?? ??"), std::invalid_argument);
+    EXPECT_THROW(parse_pattern("4G"), std::invalid_argument);
+    EXPECT_THROW(parse_pattern("488"), std::invalid_argument);
+}
+
+TEST_F(PatternKernelTest, FindsWildcardMatches) {
+    plant(100, {0x48, 0x8B, 0x05, 0x11, 0x22, 0x33, 0x44, 0x48, 0x85, 0xC0});
+    plant(5000, {0x48, 0x8B, 0x05, 0xAA, 0xBB, 0xCC, 0xDD, 0x48, 0x85, 0xC0});
+    plant(6000, {0x48, 0x8B, 0x05, 0xAA, 0xBB, 0xCC, 0xDD, 0x48, 0x85, 0xC1});
+
+    PatternKernel kernel({parse_pattern("48 8B 05 ?? ?? ?? ?? 48 85 C0")});
+    std::vector<PatternHit> hits = scan(kernel);
+    ASSERT_EQ(hits.size(), 2u);
+    EXPECT_EQ(hits[0].offset, 100u);
+    EXPECT_EQ(hits[1].offset, 5000u);
+
+    PatternKernel nibbles({parse_pattern("48 8B 05 ?? ?? ?? ?? 48 85 C?")});
+    EXPECT_EQ(scan(nibbles).size(), 3u);
+}
+
+TEST_F(PatternKernelTest, ManySignaturesMatchIndividualScans) {
+    std::vector<BytePattern> patterns;
+    std::mt19937 rng(11);
+    for (size_t n = 0; n < 200; ++n) {
+        // Short random signatures with wildcards, some planted at a few offsets.
+        std::string text;
+        std::vector<uint8_t> bytes;
+        for (size_t k = 0; k < 3 + n % 6; ++k) {
+            uint8_t byte = static_cast<uint8_t>(rng());
+            bytes.push_back(byte);
+            text += (k % 3 == 1) ? "?? " : format_bytes(&byte, 1) + " ";
+        }
+        patterns.push_back(parse_pattern(text));
+        if (n % 4 == 0) {
+            std::copy(bytes.begin(), bytes.end(), buffer.begin() + (n * 37) % (buffer.size() - 16));
+        }
+    }
+    patterns.push_back(parse_pattern("00"));
+
+    PatternKernel combined(patterns);
+    std::vector<PatternHit> hits = scan(combined);
+
+    std::vector<PatternHit> expected;
+    for (size_t n = 0; n < patterns.size(); ++n) {
+        PatternKernel single({patterns[n]});
+        for (PatternHit hit : scan(single)) {
+            expected.push_back({hit.offset, n});
+        }
+    }
+    std::sort(expected.begin(), expected.end(), [](const PatternHit& a, const PatternHit& b) {
+        return a.offset != b.offset ? a.offset < b.offset : a.signature < b.signature;
+    });
+
+    ASSERT_EQ(hits.size(), expected.size());
+    for (size_t i = 0; i < hits.size(); ++i) {
+        EXPECT_EQ(hits[i].offset, expected[i].offset);
+        EXPECT_EQ(hits[i].signature, expected[i].signature);
+    }
+}
+
+TEST_F(PatternKernelTest, RespectsScanLimitAndBufferEnd) {
+    plant(0, {0xDE, 0xAD});
+    plant(50, {0xDE, 0xAD});
+    plant(buffer.size() - 1, {0xDE});
+
+    PatternKernel kernel({parse_pattern("?? DE AD"), parse_pattern("DE AD")});
+    std::vector<PatternHit> hits;
+    kernel.scan(buffer.data(), buffer.size(), 50, hits);
+    // "?? DE AD" at 49 starts before 50; "DE AD" at 50 does not.
+    ASSERT_EQ(hits.size(), 2u);
+    EXPECT_EQ(hits[0].offset, 0u);
+    EXPECT_EQ(hits[0].signature, 1u);
+    EXPECT_EQ(hits[1].offset, 49u);
+    EXPECT_EQ(hits[1].signature, 0u);
+}
+
+TEST_F(PatternKernelTest, ClassifierMatchesScalar) {
+    simd::ByteClasses classes{};
+    // Twelve high nibbles force shared buckets.
+    for (uint8_t b : {0x05, 0x17, 0x29, 0x3B, 0x4D, 0x5F, 0x61, 0x73, 0x85, 0x97, 0xA9, 0xBB}) {
+        uint8_t bit = static_cast<uint8_t>(1u << ((b >> 4) % 8));
+        classes.high[b >> 4] |= bit;
+        classes.low[b & 15] |= bit;
+    }
+
+    std::vector<uintptr_t> expected;
+    simd::kernels_for(simd::IsaLevel::SCALAR).find_classified(buffer.data(), buffer.size() - 3, 0x400, classes, expected);
+    ASSERT_FALSE(expected.empty());
+
+    for (auto level : {simd::IsaLevel::SSE2, simd::IsaLevel::AVX2, simd::IsaLevel::AVX512}) {
+        if (level > simd::detect_isa()) {
+            continue;
+        }
+        std::vector<uintptr_t> hits;
+        simd::kernels_for(level).find_classified(buffer.data(), buffer.size() - 3, 0x400, classes, hits);
+        EXPECT_EQ(hits, expected) << simd::isa_name(level);
+    }
+}
+
+TEST_F(PatternKernelTest, FormatBytes) {
+    uint8_t bytes[] = {0x48, 0x0F, 0xC0};
+    EXPECT_EQ(format_bytes(bytes, 3), "48 0F C0");
+}
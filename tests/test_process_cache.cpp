@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include "memory/process_cache.h"
+#include "fake_memory_source.h"
+#include <memory>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+using namespace MemoryMCP;
+
+namespace {
+
+// The processes the fake sources see, and how often the cache asked about them.
+struct FakeSystem {
+    std::map<DWORD, std::string> processes;
+    std::map<DWORD, bool> alive;
+    size_t sources_created = 0;
+    size_t index_updates = 0;
+    size_t names_read = 0;
+};
+
+class SystemMemorySource : public FakeMemorySource {
+public:
+    explicit SystemMemorySource(FakeSystem& system) : system_(system) {}
+
+    bool open(DWORD process_id) override {
+        process_id_ = process_id;
+        return system_.processes.count(process_id) != 0;
+    }
+    bool is_alive() const override { return system_.alive[process_id_]; }
+
+    bool update_process_index(std::map<DWORD, std::string>& index) override {
+        system_.index_updates++;
+        std::map<DWORD, std::string> running;
+        for (const auto& process : system_.processes) {
+            auto known = index.find(process.first);
+            if (known == index.end()) {
+                system_.names_read++;
+            }
+            running.emplace(process.first, known != index.end() ? known->second : process.second);
+        }
+        index.swap(running);
+        return true;
+    }
+    bool process_matches(DWORD process_id, const std::string& process_name) override {
+        auto it = system_.processes.find(process_id);
+        return it != system_.processes.end() && it->second == process_name;
+    }
+
+private:
+    FakeSystem& system_;
+    DWORD process_id_ = 0;
+};
+
+} // namespace
+
+class ProcessCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (DWORD pid = 100; pid < 110; ++pid) {
+            system.processes[pid] = "idle";
+            system.alive[pid] = true;
+        }
+        system.processes[200] = "target";
+        system.alive[200] = true;
+    }
+
+    ProcessCache::Factory factory() {
+        return [this]() -> std::unique_ptr<MemorySource> {
+            system.sources_created++;
+            return std::make_unique<SystemMemorySource>(system);
+        };
+    }
+
+    FakeSystem system;
+};
+
+TEST_F(ProcessCacheTest, ReusesLiveSource) {
+    ProcessCache cache(factory());
+    size_t created = system.sources_created;
+
+    std::shared_ptr<MemorySource> first = cache.attach(200);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(cache.attach(200), first);
+    EXPECT_EQ(system.sources_created, created + 1);
+    EXPECT_EQ(cache.attached_count(), 1);
+}
+
+TEST_F(ProcessCacheTest, ReattachesAfterExit) {
+    ProcessCache cache(factory());
+    std::shared_ptr<MemorySource> first = cache.attach(200);
+    ASSERT_NE(first, nullptr);
+
+    system.alive[200] = false;
+    std::shared_ptr<MemorySource> second = cache.attach(200);
+    ASSERT_NE(second, nullptr);
+    EXPECT_NE(second, first);
+}
+
+TEST_F(ProcessCacheTest, RegionMapFollowsAttachment) {
+    ProcessCache cache(factory());
+    std::shared_ptr<RegionMap> map = cache.region_map(200);
+    ASSERT_NE(map, nullptr);
+    EXPECT_EQ(cache.region_map(200), map);
+    EXPECT_EQ(cache.attached_count(), 1);
+
+    system.alive[200] = false;
+    std::shared_ptr<RegionMap> next = cache.region_map(200);
+    ASSERT_NE(next, nullptr);
+    EXPECT_NE(next, map);
+    EXPECT_EQ(cache.region_map(999), nullptr);
+}
+
+TEST_F(ProcessCacheTest, AttachUnknownPidFails) {
+    ProcessCache cache(factory());
+    EXPECT_EQ(cache.attach(999), nullptr);
+    EXPECT_EQ(cache.attached_count(), 0);
+}
+
+TEST_F(ProcessCacheTest, ResolveUpdatesIndexOnlyOnMiss) {
+    ProcessCache cache(factory());
+    EXPECT_EQ(cache.resolve("target"), 200);
+    EXPECT_EQ(cache.resolve("target"), 200);
+    EXPECT_EQ(system.index_updates, 1);
+    EXPECT_EQ(system.names_read, 11);
+
+    // A new process costs one update that names only it.
+    system.processes[300] = "other";
+    EXPECT_EQ(cache.resolve("other"), 300);
+    EXPECT_EQ(system.index_updates, 2);
+    EXPECT_EQ(system.names_read, 12);
+}
+
+TEST_F(ProcessCacheTest, ResolveDropsExitedProcess) {
+    ProcessCache cache(factory());
+    ASSERT_EQ(cache.resolve("target"), 200);
+
+    system.processes.erase(200);
+    EXPECT_EQ(cache.resolve("target"), 0);
+
+    system.processes[201] = "target";
+    EXPECT_EQ(cache.resolve("target"), 201);
+}
+
+TEST_F(ProcessCacheTest, ResolveSeesReusedPid) {
+    ProcessCache cache(factory());
+    ASSERT_EQ(cache.resolve("idle"), 100);
+
+    // PID 105 is reused by "target" without the index noticing.
+    system.processes.erase(200);
+    system.processes[105] = "target";
+    EXPECT_EQ(cache.resolve("target"), 105);
+}
+
+TEST_F(ProcessCacheTest, EvictsLeastRecentlyUsed) {
+    for (DWORD pid = 400; pid < 420; ++pid) {
+        system.processes[pid] = "worker";
+        system.alive[pid] = true;
+    }
+    ProcessCache cache(factory());
+    std::shared_ptr<MemorySource> kept = cache.attach(400);
+    for (DWORD pid = 401; pid < 420; ++pid) {
+        cache.attach(pid);
+        cache.attach(400);
+    }
+    EXPECT_EQ(cache.attached_count(), 16);
+
+    size_t created = system.sources_created;
+    EXPECT_EQ(cache.attach(400), kept);
+    EXPECT_EQ(system.sources_created, created);
+}
+
+TEST_F(ProcessCacheTest, NoSourceOnPlatform) {
+    ProcessCache cache([]() { return std::unique_ptr<MemorySource>(); });
+    EXPECT_FALSE(cache.available());
+    EXPECT_EQ(cache.resolve("target"), 0);
+    EXPECT_EQ(cache.attach(200), nullptr);
+}
+
+#ifdef __linux__
+TEST(ProcessCacheLinuxTest, AttachesOwnProcess) {
+    ProcessCache cache;
+    DWORD self = static_cast<DWORD>(getpid());
+    std::shared_ptr<MemorySource> source = cache.attach(self);
+    ASSERT_NE(source, nullptr);
+    EXPECT_TRUE(source->is_alive());
+    EXPECT_EQ(cache.attach(self), source);
+
+    std::map<DWORD, std::string> index;
+    ASSERT_TRUE(source->update_process_index(index));
+    ASSERT_TRUE(index.count(self));
+    EXPECT_TRUE(source->process_matches(self, index[self]));
+    EXPECT_NE(cache.resolve(index[self]), 0);
+}
+#endif
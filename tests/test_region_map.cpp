@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include "memory/region_map.h"
+#include "memory/memory_source.h"
+#include "fake_memory_source.h"
+#include <memory>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <climits>
+#endif
+
+using namespace MemoryMCP;
+
+TEST(RegionMapTest, EmptyBeforeRefresh) {
+    auto source = std::make_shared<FakeMemorySource>();
+    source->blocks.emplace_back(64, 0);
+    RegionMap map(source);
+    EXPECT_TRUE(map.current()->empty());
+    EXPECT_EQ(map.version(), 0);
+}
+
+TEST(RegionMapTest, UnchangedLayoutKeepsList) {
+    auto source = std::make_shared<FakeMemorySource>();
+    source->blocks.emplace_back(64, 0);
+    RegionMap map(source);
+
+    std::shared_ptr<const RegionMap::Regions> first = map.refresh();
+    ASSERT_EQ(first->size(), 1);
+    EXPECT_EQ(map.refresh(), first);
+    EXPECT_EQ(map.current(), first);
+    EXPECT_EQ(map.version(), 1);
+    EXPECT_EQ(source->region_updates, 2);
+}
+
+TEST(RegionMapTest, ChangedLayoutPublishesNewList) {
+    auto source = std::make_shared<FakeMemorySource>();
+    source->blocks.reserve(2);
+    source->blocks.emplace_back(64, 0);
+    RegionMap map(source);
+    std::shared_ptr<const RegionMap::Regions> first = map.refresh();
+
+    source->blocks.emplace_back(128, 0);
+    std::shared_ptr<const RegionMap::Regions> second = map.refresh();
+    EXPECT_NE(second, first);
+    EXPECT_EQ(second->size(), 2);
+    EXPECT_EQ(map.version(), 2);
+
+    // Holders of the old list keep it unchanged.
+    EXPECT_EQ(first->size(), 1);
+}
+
+namespace {
+
+std::vector<MemoryRegion> sample_regions() {
+    return {
+        {0x10000, 0x1000, PROTECTION_READ | PROTECTION_EXECUTE, RegionType::IMAGE, "Game.exe"},
+        {0x11000, 0x2000, PROTECTION_READ | PROTECTION_WRITE, RegionType::IMAGE, "Game.exe"},
+        {0x20000, 0x100000, PROTECTION_READ | PROTECTION_WRITE, RegionType::PRIVATE, ""},
+        {0x200000, 0x4000, PROTECTION_READ, RegionType::MAPPED, "fonts.dat"},
+        {0x300000, 0x1000, PROTECTION_WRITE, RegionType::PRIVATE, ""},
+        {0x400000, 0x1000, PROTECTION_READ | PROTECTION_WRITE, RegionType::IMAGE, "engine.dll"}
+    };
+}
+
+std::vector<uintptr_t> bases(const std::vector<MemoryRegion>& regions) {
+    std::vector<uintptr_t> out;
+    for (const MemoryRegion& region : regions) {
+        out.push_back(region.base);
+    }
+    return out;
+}
+
+} // namespace
+
+TEST(SelectRegionsTest, DefaultSelectsReadable) {
+    EXPECT_EQ(bases(select_regions(sample_regions(), RegionFilter())),
+              (std::vector<uintptr_t>{0x10000, 0x11000, 0x20000, 0x200000, 0x400000}));
+}
+
+TEST(SelectRegionsTest, ProtectionAndType) {
+    RegionFilter filter;
+    filter.writable = true;
+    EXPECT_EQ(bases(select_regions(sample_regions(), filter)), (std::vector<uintptr_t>{0x11000, 0x20000, 0x400000}));
+
+    filter.skip_image = true;
+    EXPECT_EQ(bases(select_regions(sample_regions(), filter)), (std::vector<uintptr_t>{0x20000}));
+
+    filter = RegionFilter();
+    filter.executable = true;
+    EXPECT_EQ(bases(select_regions(sample_regions(), filter)), (std::vector<uintptr_t>{0x10000}));
+
+    filter = RegionFilter();
+    filter.skip_mapped = true;
+    EXPECT_EQ(select_regions(sample_regions(), filter).size(), 4);
+}
+
+TEST(SelectRegionsTest, ModulesMatchInAnyCase) {
+    RegionFilter filter;
+    filter.modules = {"game.exe", "fonts.dat"};
+    EXPECT_EQ(bases(select_regions(sample_regions(), filter)), (std::vector<uintptr_t>{0x10000, 0x11000, 0x200000}));
+}
+
+TEST(SelectRegionsTest, SizeBounds) {
+    RegionFilter filter;
+    filter.min_size = 0x2000;
+    filter.max_size = 0x4000;
+    EXPECT_EQ(bases(select_regions(sample_regions(), filter)), (std::vector<uintptr_t>{0x11000, 0x200000}));
+}
+
+TEST(SelectRegionsTest, AddressWindowClips) {
+    RegionFilter filter;
+    filter.start = 0x11800;
+    filter.end = 0x30000;
+    std::vector<MemoryRegion> selected = select_regions(sample_regions(), filter);
+    ASSERT_EQ(selected.size(), 2);
+    EXPECT_EQ(selected[0].base, 0x11800);
+    EXPECT_EQ(selected[0].size, 0x1800);
+    EXPECT_EQ(selected[0].module, "Game.exe");
+    EXPECT_EQ(selected[1].base, 0x20000);
+    EXPECT_EQ(selected[1].size, 0x10000);
+}
+
+#ifdef __linux__
+TEST(RegionMapLinuxTest, ClassifiesOwnRegions) {
+    std::shared_ptr<MemorySource> source = create_memory_source();
+    ASSERT_TRUE(source->open(static_cast<DWORD>(getpid())));
+
+    char path[PATH_MAX];
+    ssize_t length = readlink("/proc/self/exe", path, sizeof(path) - 1);
+    ASSERT_GT(length, 0);
+    std::string exe(path, static_cast<size_t>(length));
+    exe = exe.substr(exe.find_last_of('/') + 1);
+
+    std::vector<uint8_t> heap(1 << 20, 0xCD);
+    uintptr_t code = reinterpret_cast<uintptr_t>(&create_memory_source);
+    uintptr_t data = reinterpret_cast<uintptr_t>(heap.data());
+
+    RegionMap map(source);
+    bool found_code = false;
+    bool found_data = false;
+    for (const MemoryRegion& region : *map.refresh()) {
+        if (code >= region.base && code < region.base + region.size) {
+            EXPECT_EQ(region.type, RegionType::IMAGE);
+            EXPECT_EQ(region.module, exe);
+            EXPECT_TRUE(region.protection & PROTECTION_EXECUTE);
+            found_code = true;
+        }
+        if (data >= region.base && data < region.base + region.size) {
+            EXPECT_EQ(region.type, RegionType::PRIVATE);
+            EXPECT_TRUE(region.module.empty());
+            found_data = true;
+        }
+    }
+    EXPECT_TRUE(found_code);
+    EXPECT_TRUE(found_data);
+}
+#endif
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include "server/result_encoding.h"
+
+using namespace MemoryMCP;
+
+namespace {
+
+AddressesResponse numeric_page() {
+    AddressesResponse page;
+    page.raw_addresses = {0x1000, 0x7FFE12345678ull};
+    page.values = {"1", "2"};
+    page.count = 2;
+    page.total = 5;
+    page.offset = 1;
+    page.next_cursor = "3:3";
+    page.message = "Retrieved 2 of 5 addresses";
+    page.success = true;
+    return page;
+}
+
+} // namespace
+
+TEST(ResultEncodingTest, ParsesNamesAndNegotiates) {
+    ResultEncoding encoding;
+    EXPECT_TRUE(parse_result_encoding("msgpack", encoding));
+    EXPECT_EQ(encoding, ResultEncoding::MSGPACK);
+    EXPECT_FALSE(parse_result_encoding("xml", encoding));
+
+    EXPECT_EQ(negotiate_result_encoding(""), ResultEncoding::JSON);
+    EXPECT_EQ(negotiate_result_encoding("*/*"), ResultEncoding::JSON);
+    EXPECT_EQ(negotiate_result_encoding("Application/CBOR"), ResultEncoding::CBOR);
+    EXPECT_EQ(negotiate_result_encoding("text/html, application/x-msgpack;q=0.9, application/json"), ResultEncoding::MSGPACK);
+    EXPECT_EQ(negotiate_result_encoding("application/octet-stream"), ResultEncoding::RAW);
+    EXPECT_STREQ(result_encoding_content_type(ResultEncoding::RAW), "application/octet-stream");
+}
+
+TEST(ResultEncodingTest, CborAndMsgpackCarryNumbers) {
+    AddressesResponse page = numeric_page();
+
+    std::string cbor = encode_addresses(page, ResultEncoding::CBOR);
+    json decoded = json::from_cbor(cbor);
+    EXPECT_EQ(decoded["addresses"][1].get<uint64_t>(), 0x7FFE12345678ull);
+    EXPECT_EQ(decoded["values"][0], "1");
+    EXPECT_EQ(decoded["total"], 5);
+    EXPECT_EQ(decoded["next_cursor"], "3:3");
+
+    std::string msgpack = encode_addresses(page, ResultEncoding::MSGPACK);
+    EXPECT_EQ(json::from_msgpack(msgpack), decoded);
+}
+
+TEST(ResultEncodingTest, RawIsPackedLittleEndian) {
+    std::string raw = encode_addresses(numeric_page(), ResultEncoding::RAW);
+    ASSERT_EQ(raw.size(), 16);
+    EXPECT_EQ(static_cast<uint8_t>(raw[0]), 0x00);
+    EXPECT_EQ(static_cast<uint8_t>(raw[1]), 0x10);
+    EXPECT_EQ(static_cast<uint8_t>(raw[8]), 0x78);
+    EXPECT_EQ(static_cast<uint8_t>(raw[13]), 0x7F);
+    EXPECT_EQ(static_cast<uint8_t>(raw[15]), 0x00);
+}
+
+TEST(ResultEncodingTest, Base64) {
+    EXPECT_EQ(base64_encode(""), "");
+    EXPECT_EQ(base64_encode("f"), "Zg==");
+    EXPECT_EQ(base64_encode("fo"), "Zm8=");
+    EXPECT_EQ(base64_encode("foo"), "Zm9v");
+    EXPECT_EQ(base64_encode("foobar"), "Zm9vYmFy");
+    EXPECT_EQ(base64_encode(std::string("\xFF\x00", 2)), "/wA=");
+
+    EXPECT_EQ(base64_decode("Zm9vYmFy"), "foobar");
+    EXPECT_EQ(base64_decode("Zm8="), "fo");
+    EXPECT_EQ(base64_decode("Zg"), "f");
+    EXPECT_EQ(base64_decode("/wA="), std::string("\xFF\x00", 2));
+    EXPECT_THROW(base64_decode("Zm 9v"), std::invalid_argument);
+}
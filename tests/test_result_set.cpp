@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include "memory/result_set.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace MemoryMCP;
+
+static std::vector<uint8_t> int_bytes(int32_t value) {
+    std::vector<uint8_t> bytes(sizeof(value));
+    std::memcpy(bytes.data(), &value, sizeof(value));
+    return bytes;
+}
+
+TEST(ResultSetTest, StoresAddressesAndValues) {
+    ResultSet set(ValueType::INT32, 4);
+    for (int32_t i = 0; i < 10; ++i) {
+        set.append(0x1000 + i * 8, int_bytes(i * 3).data());
+    }
+
+    EXPECT_EQ(set.size(), 10);
+    EXPECT_EQ(set.value_type(), ValueType::INT32);
+    EXPECT_FALSE(set.delta_encoded());
+    EXPECT_EQ(set.address(4), 0x1020);
+
+    int32_t value;
+    std::memcpy(&value, set.value(4), sizeof(value));
+    EXPECT_EQ(value, 12);
+
+    EXPECT_EQ(set.find(0x1048), 9);
+    EXPECT_EQ(set.find(0x1004), ResultSet::npos);
+    EXPECT_EQ(set.find(0x2000), ResultSet::npos);
+}
+
+TEST(ResultSetTest, DeltaEncodingKeepsAddresses) {
+    ResultSet plain(ValueType::INT64, 8, 1 << 30);
+    ResultSet delta(ValueType::INT64, 8, 16);
+
+    // Three clusters more than 4 GiB apart force separate segments.
+    std::vector<uint64_t> addresses;
+    for (uint64_t base : {0x10000ull, 0x7f0000000000ull, 0x7fff00000000ull}) {
+        for (uint64_t i = 0; i < 20; ++i) {
+            addresses.push_back(base + i * 0x1000);
+        }
+    }
+    for (size_t i = 0; i < addresses.size(); ++i) {
+        uint64_t value = i;
+        plain.append(addresses[i], reinterpret_cast<const uint8_t*>(&value));
+        delta.append(addresses[i], reinterpret_cast<const uint8_t*>(&value));
+    }
+
+    EXPECT_TRUE(delta.delta_encoded());
+    EXPECT_FALSE(plain.delta_encoded());
+    EXPECT_LT(delta.memory_usage(), plain.memory_usage() + 64 * sizeof(uint64_t));
+
+    for (size_t i = 0; i < addresses.size(); ++i) {
+        EXPECT_EQ(delta.address(i), addresses[i]);
+        EXPECT_EQ(delta.find(addresses[i]), i);
+    }
+    EXPECT_EQ(delta.find(0x7f0000000008ull), ResultSet::npos);
+    EXPECT_EQ(delta.find(0x8000), ResultSet::npos);
+
+    std::vector<uint64_t> walked;
+    delta.for_each(5, 45, [&](size_t index, uint64_t address, const uint8_t* value) {
+        uint64_t stored;
+        std::memcpy(&stored, value, sizeof(stored));
+        EXPECT_EQ(stored, index);
+        walked.push_back(address);
+    });
+    EXPECT_EQ(walked, std::vector<uint64_t>(addresses.begin() + 5, addresses.begin() + 45));
+}
+
+TEST(ResultSetTest, StringSetsStoreNoValues) {
+    ResultSet set(ValueType::STRING, 0);
+    set.append(0x10, nullptr);
+    set.append(0x20, nullptr);
+
+    EXPECT_EQ(set.size(), 2);
+    EXPECT_EQ(set.address(1), 0x20);
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(set.find(0x10), ResultSet::npos);
+}
+
+TEST(ResultSetTest, SelectMatchesFind) {
+    for (size_t threshold : {size_t(1) << 30, size_t(100)}) {
+        ResultSet set(ValueType::INT32, 4, threshold);
+        for (uint32_t i = 0; i < 5000; ++i) {
+            // The second half lies more than 4 GiB higher, in its own segment.
+            uint64_t address = 0x10000 + uint64_t(i) * 12 + (i >= 2500 ? 0x200000000ull : 0);
+            set.append(address, reinterpret_cast<const uint8_t*>(&i));
+        }
+
+        std::vector<uint64_t> wanted;
+        for (uint64_t a = 0x10000; a < 0x10000 + 5000 * 12; a += 36) {
+            wanted.push_back(a);
+            wanted.push_back(a + 1);
+            wanted.push_back(a + 0x200000000ull);
+        }
+        std::sort(wanted.begin(), wanted.end());
+
+        ResultSet selected = set.select(wanted);
+        size_t expected = 0;
+        for (uint64_t a : wanted) {
+            expected += set.find(a) != ResultSet::npos;
+        }
+        ASSERT_GT(expected, 0);
+        ASSERT_EQ(selected.size(), expected);
+        selected.for_each([&](size_t index, uint64_t address, const uint8_t* value) {
+            size_t original = set.find(address);
+            ASSERT_NE(original, ResultSet::npos);
+            EXPECT_EQ(std::memcmp(value, set.value(original), 4), 0);
+            if (index > 0) {
+                EXPECT_LT(selected.address(index - 1), address);
+            }
+        });
+    }
+}
+
+TEST(ResultSetTest, ParseAddress) {
+    uint64_t address;
+    EXPECT_TRUE(parse_address("0x7FFE1000", address));
+    EXPECT_EQ(address, 0x7FFE1000ull);
+    EXPECT_TRUE(parse_address("deadbeef", address));
+    EXPECT_EQ(address, 0xDEADBEEFull);
+    EXPECT_FALSE(parse_address("0x", address));
+    EXPECT_FALSE(parse_address("", address));
+    EXPECT_FALSE(parse_address("0x12zz", address));
+}
+
+TEST(ResultSetTest, FormatAddress) {
+    EXPECT_EQ(format_address(0), "0x0");
+    EXPECT_EQ(format_address(0xF), "0xF");
+    EXPECT_EQ(format_address(0x10), "0x10");
+    EXPECT_EQ(format_address(0x7FFE1000), "0x7FFE1000");
+    EXPECT_EQ(format_address(0xFFFFFFFFFFFFFFFFull), "0xFFFFFFFFFFFFFFFF");
+
+    // Round-trips through parse_address.
+    for (uint64_t value : {1ull, 0xABCull, 0x1234567890ABCDEFull, 0x100000000ull}) {
+        uint64_t parsed = 0;
+        EXPECT_TRUE(parse_address(format_address(value), parsed));
+        EXPECT_EQ(parsed, value);
+    }
+}
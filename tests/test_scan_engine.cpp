@@ -0,0 +1,298 @@
+#include <gtest/gtest.h>
+#include "memory/scan_engine.h"
+#include "memory/streaming_reader.h"
+#include "memory/thread_pool.h"
+#include "fake_memory_source.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+using namespace MemoryMCP;
+
+static void find_needle(uintptr_t address, const uint8_t* data, size_t bytes_read, size_t scan_limit,
+                        std::vector<uintptr_t>& out) {
+    static const char needle[] = "NEEDLE";
+    const size_t length = sizeof(needle) - 1;
+    for (size_t i = 0; i < scan_limit && i + length <= bytes_read; ++i) {
+        if (std::memcmp(data + i, needle, length) == 0) {
+            out.push_back(address + i);
+        }
+    }
+}
+
+TEST(ThreadPoolTest, ParallelForRunsEveryIndexOnce) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> hits(1000);
+
+    pool.parallel_for(hits.size(), [&](size_t index, size_t worker) {
+        EXPECT_LT(worker, pool.size());
+        hits[index]++;
+    });
+
+    for (auto& hit : hits) {
+        EXPECT_EQ(hit.load(), 1);
+    }
+}
+
+TEST(ThreadPoolTest, ParallelForRethrows) {
+    ThreadPool pool(2);
+    EXPECT_THROW(pool.parallel_for(10, [](size_t index, size_t) {
+        if (index == 7) throw std::runtime_error("boom");
+    }), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, ParallelForLimitsWorkers) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> hits(200);
+    std::atomic<int> running{0};
+    std::atomic<int> peak{0};
+
+    pool.parallel_for(hits.size(), [&](size_t index, size_t) {
+        int now = ++running;
+        for (int seen = peak; now > seen && !peak.compare_exchange_weak(seen, now);) {
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+        hits[index]++;
+        --running;
+    }, 2);
+
+    EXPECT_LE(peak.load(), 2);
+    for (auto& hit : hits) {
+        EXPECT_EQ(hit.load(), 1);
+    }
+}
+
+TEST(ScanEngineTest, SplitRegionsCarriesOverlap) {
+    std::vector<MemoryRegion> regions = {{0x1000, 10000, PROTECTION_READ}};
+    std::vector<ScanChunk> chunks = ScanEngine::split_regions(regions, 4096, 5);
+
+    ASSERT_EQ(chunks.size(), 3);
+    EXPECT_EQ(chunks[0].address, 0x1000);
+    EXPECT_EQ(chunks[0].size, 4096);
+    EXPECT_EQ(chunks[0].overlap, 5);
+    EXPECT_EQ(chunks[2].size, 10000 - 2 * 4096);
+    EXPECT_EQ(chunks[2].overlap, 0);
+}
+
+TEST(ScanEngineTest, ResultsIndependentOfThreadCount) {
+    FakeMemorySource source;
+    for (size_t b = 0; b < 8; ++b) {
+        std::vector<uint8_t> block(64 * 1024 + b * 123, 'x');
+        for (size_t offset = b * 7; offset + 6 <= block.size(); offset += 4093) {
+            std::memcpy(block.data() + offset, "NEEDLE", 6);
+        }
+        source.blocks.push_back(std::move(block));
+    }
+    // Straddles the boundary between the first two 4 KiB chunks.
+    std::memcpy(source.blocks[0].data() + 4093, "NEEDLE", 6);
+
+    std::vector<MemoryRegion> regions = source.enumerate_regions();
+
+    ScanOptions single;
+    single.thread_count = 1;
+    single.chunk_size = 4096;
+    ScanEngine reference_engine(source, single);
+    std::vector<uintptr_t> reference = reference_engine.run(regions, 5, find_needle);
+    ASSERT_FALSE(reference.empty());
+
+    bool straddling_found = false;
+    for (const auto& addr : reference) {
+        straddling_found |= addr == reinterpret_cast<uintptr_t>(source.blocks[0].data()) + 4093;
+    }
+    EXPECT_TRUE(straddling_found);
+
+    for (size_t threads : {2, 4, 8}) {
+        ScanOptions options = single;
+        options.thread_count = threads;
+        ScanEngine engine(source, options);
+        std::vector<uintptr_t> results = engine.run(regions, 5, find_needle);
+
+        ASSERT_EQ(results.size(), reference.size());
+        for (size_t i = 0; i < results.size(); ++i) {
+            EXPECT_EQ(results[i], reference[i]);
+        }
+        EXPECT_EQ(engine.stats().thread_count, (std::min)(threads, ThreadPool::default_thread_count()));
+    }
+}
+
+TEST(ScanEngineTest, CapturesValuesFromTheScannedChunk) {
+    FakeMemorySource source;
+    source.blocks.push_back(std::vector<uint8_t>(3000, 'x'));
+    source.blocks.push_back(std::vector<uint8_t>(200000, 'x'));
+    for (auto& block : source.blocks) {
+        for (size_t offset = 17; offset + 8 <= block.size(); offset += 2999) {
+            std::memcpy(block.data() + offset, "NEEDLE", 6);
+            block[offset + 6] = static_cast<uint8_t>(offset);
+            block[offset + 7] = static_cast<uint8_t>(offset >> 8);
+        }
+    }
+
+    // Small regions go through batched reads, the large one is streamed.
+    for (size_t threads : {1, 4}) {
+        ScanOptions options;
+        options.thread_count = threads;
+        options.chunk_size = 4096;
+        ScanEngine engine(source, options);
+        std::vector<uintptr_t> hits = engine.run(source.enumerate_regions(), 7,
+            [](uintptr_t address, const uint8_t* data, size_t bytes_read, size_t scan_limit, std::vector<uintptr_t>& out) {
+                // NEEDLE plus two tag bytes, so every captured value differs.
+                find_needle(address, data, bytes_read >= 2 ? bytes_read - 2 : 0, scan_limit, out);
+            }, 8);
+
+        ASSERT_FALSE(hits.empty());
+        ASSERT_EQ(engine.values().size(), hits.size() * 8);
+        for (size_t i = 0; i < hits.size(); ++i) {
+            EXPECT_EQ(std::memcmp(engine.values().data() + i * 8, reinterpret_cast<const void*>(hits[i]), 8), 0);
+        }
+    }
+}
+
+TEST(StreamingReaderTest, CarriesOverlapAcrossChunks) {
+    FakeMemorySource source;
+    std::vector<uint8_t> block(10000, 'x');
+    for (size_t offset : {0, 1021, 2046, 5000, 9994}) {
+        std::memcpy(block.data() + offset, "NEEDLE", 6);
+    }
+    source.blocks.push_back(std::move(block));
+    uintptr_t base = reinterpret_cast<uintptr_t>(source.blocks[0].data());
+
+    StreamingReader reader(source, 1024, 5);
+    std::vector<uintptr_t> hits;
+    size_t chunks = 0;
+    size_t readable = reader.stream(base, 10000, base + 10000,
+        [&](uintptr_t address, const uint8_t* data, size_t bytes_read, size_t scan_limit) {
+            EXPECT_LE(bytes_read, 1024 + 5);
+            find_needle(address, data, bytes_read, scan_limit, hits);
+            chunks++;
+        });
+
+    EXPECT_EQ(readable, 10000);
+    EXPECT_GE(chunks, 10);
+    std::vector<uintptr_t> expected = {base, base + 1021, base + 2046, base + 5000, base + 9994};
+    EXPECT_EQ(hits, expected);
+}
+
+TEST(StreamingReaderTest, StopsAtSliceEndButReadsOverlap) {
+    FakeMemorySource source;
+    std::vector<uint8_t> block(4096, 'x');
+    std::memcpy(block.data() + 2046, "NEEDLE", 6);
+    std::memcpy(block.data() + 2052, "NEEDLE", 6);
+    source.blocks.push_back(std::move(block));
+    uintptr_t base = reinterpret_cast<uintptr_t>(source.blocks[0].data());
+
+    // The first match starts inside the slice and ends past it; the second starts after it.
+    StreamingReader reader(source, 512, 5);
+    std::vector<uintptr_t> hits;
+    reader.stream(base, 2048, base + 4096,
+        [&](uintptr_t address, const uint8_t* data, size_t bytes_read, size_t scan_limit) {
+            find_needle(address, data, bytes_read, scan_limit, hits);
+        });
+
+    ASSERT_EQ(hits.size(), 1);
+    EXPECT_EQ(hits[0], base + 2046);
+}
+
+TEST(StreamingReaderTest, SkipsUnreadablePagesInsideStripe) {
+    FakeMemorySource source;
+    source.blocks.push_back(std::vector<uint8_t>(40000, 'x'));
+    uintptr_t base = reinterpret_cast<uintptr_t>(source.blocks[0].data());
+    source.hole_begin = (base + 10000 + 4095) / 4096 * 4096;
+    source.hole_end = source.hole_begin + 2 * 4096;
+
+    size_t before = source.hole_begin - base - 6;
+    size_t inside = source.hole_begin - base + 100;
+    size_t after = source.hole_end - base;
+    for (size_t offset : {size_t(10), before, inside, after, size_t(40000 - 6)}) {
+        std::memcpy(source.blocks[0].data() + offset, "NEEDLE", 6);
+    }
+
+    StreamingReader reader(source, 1024, 5);
+    std::vector<uintptr_t> hits;
+    size_t readable = reader.stream(base, 40000, base + 40000,
+        [&](uintptr_t address, const uint8_t* data, size_t bytes_read, size_t scan_limit) {
+            find_needle(address, data, bytes_read, scan_limit, hits);
+        });
+
+    EXPECT_EQ(readable, 40000 - 2 * 4096);
+    std::vector<uintptr_t> expected = {base + 10, base + before, base + after, base + 40000 - 6};
+    EXPECT_EQ(hits, expected);
+    EXPECT_EQ(std::count(hits.begin(), hits.end(), base + inside), 0);
+}
+
+TEST(ScanEngineTest, StreamsLargeRegionsWithoutTruncation) {
+    FakeMemorySource source;
+    std::vector<uint8_t> block(3 * 1024 * 1024 + 17, 'x');
+    const size_t stripe = 4096 * SCAN_STRIPE_CHUNKS;
+    std::vector<size_t> offsets = {10, 4093, stripe - 3, 2 * 1024 * 1024 + 1, block.size() - 6};
+    for (size_t offset : offsets) {
+        std::memcpy(block.data() + offset, "NEEDLE", 6);
+    }
+    source.blocks.push_back(std::move(block));
+    uintptr_t base = reinterpret_cast<uintptr_t>(source.blocks[0].data());
+
+    ScanOptions options;
+    options.thread_count = 4;
+    options.chunk_size = 4096;
+    ScanEngine engine(source, options);
+    std::vector<uintptr_t> results = engine.run(source.enumerate_regions(), 5, find_needle);
+
+    ASSERT_EQ(results.size(), offsets.size());
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        EXPECT_EQ(results[i], base + offsets[i]);
+    }
+    EXPECT_EQ(engine.stats().bytes_scanned, source.blocks[0].size());
+}
+
+TEST(ScanEngineTest, ReportsProgress) {
+    FakeMemorySource source;
+    source.blocks.push_back(std::vector<uint8_t>(1024 * 1024, 'x'));
+    for (size_t b = 0; b < 5; ++b) {
+        source.blocks.push_back(std::vector<uint8_t>(3000 + b, 'x'));
+        std::memcpy(source.blocks.back().data() + 100, "NEEDLE", 6);
+    }
+    std::memcpy(source.blocks[0].data() + 500000, "NEEDLE", 6);
+
+    ScanProgress progress;
+    ScanOptions options;
+    options.thread_count = 4;
+    options.chunk_size = 4096;
+    options.progress = &progress;
+
+    ScanEngine engine(source, options);
+    std::vector<uintptr_t> results = engine.run(source.enumerate_regions(), 5, find_needle);
+
+    EXPECT_EQ(results.size(), 6);
+    EXPECT_EQ(progress.hits.load(), 6);
+    EXPECT_EQ(progress.regions_total.load(), 6);
+    EXPECT_EQ(progress.regions_done.load(), 6);
+    EXPECT_EQ(progress.bytes_total.load(), 1024 * 1024 + 5 * 3000 + 10);
+    EXPECT_EQ(progress.bytes_scanned.load(), progress.bytes_total.load());
+}
+
+TEST(ScanEngineTest, CancelStopsAtNextChunk) {
+    FakeMemorySource source;
+    source.blocks.push_back(std::vector<uint8_t>(1024 * 1024, 'x'));
+    for (size_t b = 0; b < 20; ++b) {
+        source.blocks.push_back(std::vector<uint8_t>(4096, 'x'));
+    }
+
+    ScanProgress progress;
+    ScanOptions options;
+    options.thread_count = 1;
+    options.chunk_size = 4096;
+    options.progress = &progress;
+
+    size_t calls = 0;
+    ScanEngine engine(source, options);
+    engine.run(source.enumerate_regions(), 0,
+        [&](uintptr_t, const uint8_t*, size_t, size_t, std::vector<uintptr_t>&) {
+            calls++;
+            progress.cancelled = true;
+        });
+
+    EXPECT_EQ(calls, 1);
+    EXPECT_LT(progress.bytes_scanned.load(), progress.bytes_total.load());
+    EXPECT_LT(progress.regions_done.load(), progress.regions_total.load());
+}
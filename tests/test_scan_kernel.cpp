@@ -0,0 +1,325 @@
+#include <gtest/gtest.h>
+#include "memory/scan_kernel.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+using namespace MemoryMCP;
+
+class ScanKernelTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        buffer.assign(1024, 0xCC);
+    }
+
+    template <typename T>
+    void plant(size_t offset, T value) {
+        std::memcpy(buffer.data() + offset, &value, sizeof(value));
+    }
+
+    // Tests every byte offset instead of the natural stride.
+    static ScanCondition byte_stride() {
+        ScanCondition condition;
+        condition.alignment = 1;
+        return condition;
+    }
+
+    std::vector<uintptr_t> run(const CompiledKernel& kernel) {
+        std::vector<uintptr_t> hits;
+        kernel.scanner(0x10000, buffer.data(), buffer.size(), buffer.size(), hits);
+        return hits;
+    }
+
+    std::vector<uint8_t> buffer;
+};
+
+TEST_F(ScanKernelTest, ParseValue) {
+    int32_t i32 = 0;
+    EXPECT_TRUE(parse_value("-12345", i32));
+    EXPECT_EQ(i32, -12345);
+    EXPECT_TRUE(parse_value("0x7fffffff", i32));
+    EXPECT_EQ(i32, 0x7fffffff);
+    EXPECT_FALSE(parse_value("12abc", i32));
+    EXPECT_FALSE(parse_value("99999999999", i32));
+    EXPECT_FALSE(parse_value("", i32));
+
+    int64_t i64 = 0;
+    EXPECT_TRUE(parse_value("-9000000000", i64));
+    EXPECT_EQ(i64, -9000000000LL);
+
+    double f64 = 0;
+    EXPECT_TRUE(parse_value("3.25", f64));
+    EXPECT_DOUBLE_EQ(f64, 3.25);
+    EXPECT_FALSE(parse_value("3.25x", f64));
+}
+
+TEST_F(ScanKernelTest, Int32MatchesEncodedValue) {
+    plant<int32_t>(3, 1337);
+    plant<int32_t>(512, 1337);
+
+    // The ASCII digits must not match, only the encoded number.
+    std::memcpy(buffer.data() + 700, "1337", 4);
+
+    std::vector<uintptr_t> hits = run(compile_kernel("1337", ValueType::INT32, byte_stride()));
+    std::vector<uintptr_t> expected = {0x10000 + 3, 0x10000 + 512};
+    EXPECT_EQ(hits, expected);
+}
+
+TEST_F(ScanKernelTest, Int64AndDouble) {
+    plant<int64_t>(40, -42);
+    plant<double>(100, 2.5);
+
+    std::vector<uintptr_t> int_hits = run(compile_kernel("-42", ValueType::INT64, byte_stride()));
+    ASSERT_EQ(int_hits.size(), 1);
+    EXPECT_EQ(int_hits[0], 0x10000 + 40);
+
+    std::vector<uintptr_t> double_hits = run(compile_kernel("2.5", ValueType::FLOAT64, byte_stride()));
+    ASSERT_EQ(double_hits.size(), 1);
+    EXPECT_EQ(double_hits[0], 0x10000 + 100);
+}
+
+TEST_F(ScanKernelTest, FloatScan) {
+    plant<float>(9, 0.125f);
+    std::vector<uintptr_t> hits = run(compile_kernel("0.125", ValueType::FLOAT, byte_stride()));
+    ASSERT_EQ(hits.size(), 1);
+    EXPECT_EQ(hits[0], 0x10000 + 9);
+}
+
+TEST_F(ScanKernelTest, AlignedKernelSkipsUnalignedMatches) {
+    plant<int32_t>(6, 77);
+    plant<int32_t>(16, 77);
+
+    ScanKernel<int32_t, BitwiseEqual<int32_t>, 4> kernel(BitwiseEqual<int32_t>{77});
+    std::vector<uintptr_t> hits;
+    kernel(0x10000, buffer.data(), buffer.size(), buffer.size(), hits);
+
+    ASSERT_EQ(hits.size(), 1);
+    EXPECT_EQ(hits[0], 0x10000 + 16);
+}
+
+TEST_F(ScanKernelTest, NaturalAlignmentIsDefault) {
+    plant<int32_t>(1, 1337);
+    plant<int32_t>(6, 1337);
+    plant<int32_t>(512, 1337);
+
+    CompiledKernel natural = compile_kernel("1337", ValueType::INT32);
+    EXPECT_EQ(natural.alignment, 4);
+    std::vector<uintptr_t> expected = {0x10000 + 512};
+    EXPECT_EQ(run(natural), expected);
+
+    ScanCondition condition;
+    condition.alignment = 2;
+    CompiledKernel halfword = compile_kernel("1337", ValueType::INT32, condition);
+    EXPECT_EQ(halfword.alignment, 2);
+    expected = {0x10000 + 6, 0x10000 + 512};
+    EXPECT_EQ(run(halfword), expected);
+}
+
+TEST_F(ScanKernelTest, WideAlignments) {
+    plant<int32_t>(12, 7);
+    plant<int32_t>(16, 7);
+    plant<double>(40, 2.5);
+    plant<double>(100, 2.5);
+
+    ScanCondition condition;
+    condition.alignment = 8;
+    std::vector<uintptr_t> expected = {0x10000 + 16};
+    EXPECT_EQ(run(compile_kernel("7", ValueType::INT32, condition)), expected);
+
+    CompiledKernel natural = compile_kernel("2.5", ValueType::FLOAT64);
+    EXPECT_EQ(natural.alignment, 8);
+    expected = {0x10000 + 40};
+    EXPECT_EQ(run(natural), expected);
+
+    // Ranges stride the same way: ne hits every natural slot but the planted one.
+    condition.predicate = ScanPredicate::NOT_EQUAL;
+    condition.alignment = 0;
+    std::vector<uintptr_t> not_equal = run(compile_kernel("2.5", ValueType::FLOAT64, condition));
+    EXPECT_EQ(not_equal.size(), buffer.size() / 8 - 1);
+    EXPECT_TRUE(std::all_of(not_equal.begin(), not_equal.end(), [](uintptr_t address) { return address % 8 == 0; }));
+
+    condition.alignment = 3;
+    EXPECT_THROW(compile_kernel("7", ValueType::INT32, condition), std::invalid_argument);
+    condition.predicate = ScanPredicate::EQUAL;
+    condition.alignment = 4;
+    EXPECT_THROW(compile_kernel("abc", ValueType::STRING, condition), std::invalid_argument);
+    EXPECT_EQ(compile_kernel("abc", ValueType::STRING).alignment, 1);
+}
+
+TEST_F(ScanKernelTest, StringKernelFindsNarrowAndWide) {
+    std::memcpy(buffer.data() + 10, "abc", 3);
+    std::memcpy(buffer.data() + 200, u"abc", 6);
+
+    std::vector<uintptr_t> hits = run(compile_kernel("abc", ValueType::STRING));
+    std::vector<uintptr_t> expected = {0x10000 + 10, 0x10000 + 200};
+    EXPECT_EQ(hits, expected);
+}
+
+TEST_F(ScanKernelTest, StringKernelEncodings) {
+    // "h\u00e9llo \U0001F600" in UTF-8, UTF-16LE (with a surrogate pair) and UTF-32LE.
+    const std::string text = "h\xC3\xA9llo \xF0\x9F\x98\x80";
+    std::memcpy(buffer.data() + 5, text.data(), text.size());
+    std::memcpy(buffer.data() + 300, u"h\u00e9llo \U0001F600", 2 * 8);
+    std::memcpy(buffer.data() + 600, U"h\u00e9llo \U0001F600", 4 * 7);
+
+    std::vector<uintptr_t> expected = {0x10000 + 5, 0x10000 + 300};
+    EXPECT_EQ(run(compile_kernel(text, ValueType::STRING)), expected);
+
+    ScanCondition condition;
+    condition.encodings = {StringEncoding::UTF32LE, StringEncoding::UTF8, StringEncoding::UTF16LE};
+    expected = {0x10000 + 5, 0x10000 + 300, 0x10000 + 600};
+    EXPECT_EQ(run(compile_kernel(text, ValueType::STRING, condition)), expected);
+
+    condition.encodings = {StringEncoding::UTF32LE};
+    expected = {0x10000 + 600};
+    EXPECT_EQ(run(compile_kernel(text, ValueType::STRING, condition)), expected);
+
+    EXPECT_THROW(compile_kernel("\xC3", ValueType::STRING), std::invalid_argument);
+    EXPECT_THROW(compile_kernel("\xC0\x80", ValueType::STRING), std::invalid_argument);
+    condition.encodings.clear();
+    EXPECT_THROW(compile_kernel("abc", ValueType::STRING, condition), std::invalid_argument);
+}
+
+TEST_F(ScanKernelTest, StringKernelIgnoreCase) {
+    std::memcpy(buffer.data() + 20, "PlAyEr_1", 8);
+    std::memcpy(buffer.data() + 400, u"PLAYER_1", 16);
+    // '_' | 0x20 is DEL, so punctuation must not be folded.
+    std::memcpy(buffer.data() + 700, "player\x7F" "1", 8);
+
+    std::vector<uintptr_t> exact = run(compile_kernel("player_1", ValueType::STRING));
+    EXPECT_TRUE(exact.empty());
+
+    ScanCondition condition;
+    condition.ignore_case = true;
+    std::vector<uintptr_t> expected = {0x10000 + 20, 0x10000 + 400};
+    EXPECT_EQ(run(compile_kernel("player_1", ValueType::STRING, condition)), expected);
+}
+
+TEST_F(ScanKernelTest, StringKernelReportsSharedOffsetOnce) {
+    std::fill(buffer.begin(), buffer.end(), 0);
+    buffer[50] = 'x';
+
+    // "x" in UTF-8 and "x\0" in UTF-16LE both start at 50.
+    std::vector<uintptr_t> expected = {0x10000 + 50};
+    EXPECT_EQ(run(compile_kernel("x", ValueType::STRING)), expected);
+}
+
+TEST_F(ScanKernelTest, InvalidValueThrows) {
+    EXPECT_THROW(compile_kernel("not a number", ValueType::INT32), std::invalid_argument);
+    EXPECT_THROW(compile_kernel("", ValueType::STRING), std::invalid_argument);
+}
+
+TEST_F(ScanKernelTest, CompareValues) {
+    EXPECT_TRUE((compare_values<CompareOp::CHANGED, int32_t>(1, 2, 0)));
+    EXPECT_FALSE((compare_values<CompareOp::CHANGED, int32_t>(2, 2, 0)));
+    EXPECT_TRUE((compare_values<CompareOp::UNCHANGED, double>(1.5, 1.5, 0)));
+    EXPECT_TRUE((compare_values<CompareOp::INCREASED, float>(1.0f, 1.5f, 0)));
+    EXPECT_TRUE((compare_values<CompareOp::DECREASED, int64_t>(-1, -2, 0)));
+    EXPECT_TRUE((compare_values<CompareOp::INCREASED_BY, int32_t>(10, 15, 5)));
+    EXPECT_TRUE((compare_values<CompareOp::DECREASED_BY, int32_t>(10, 7, 3)));
+    // Integer steps wrap like the target's arithmetic.
+    EXPECT_TRUE((compare_values<CompareOp::INCREASED_BY, int32_t>(INT32_MAX, INT32_MIN, 1)));
+
+    ValueComparator comparator = compile_comparator(CompareOp::DECREASED_BY, "0.5", ValueType::FLOAT64);
+    double previous = 2.0;
+    double current = 1.5;
+    EXPECT_TRUE(comparator(reinterpret_cast<const uint8_t*>(&previous), reinterpret_cast<const uint8_t*>(&current)));
+    EXPECT_THROW(compile_comparator(CompareOp::INCREASED_BY, "x", ValueType::INT32), std::invalid_argument);
+    EXPECT_THROW(compile_comparator(CompareOp::CHANGED, "", ValueType::STRING), std::invalid_argument);
+}
+
+TEST_F(ScanKernelTest, RelationalPredicates) {
+    plant<int32_t>(8, -5);
+    plant<int32_t>(100, 10);
+    plant<int32_t>(200, 20);
+
+    ScanCondition condition = byte_stride();
+    condition.predicate = ScanPredicate::BETWEEN;
+    condition.upper = "20";
+    std::vector<uintptr_t> expected = {0x10000 + 100, 0x10000 + 200};
+    EXPECT_EQ(run(compile_kernel("10", ValueType::INT32, condition)), expected);
+
+    condition.predicate = ScanPredicate::LESS;
+    std::vector<uintptr_t> less = run(compile_kernel("10", ValueType::INT32, condition));
+    EXPECT_NE(std::find(less.begin(), less.end(), 0x10000 + 8), less.end());
+    EXPECT_EQ(std::find(less.begin(), less.end(), 0x10000 + 100), less.end());
+
+    condition.predicate = ScanPredicate::GREATER;
+    std::vector<uintptr_t> greater = run(compile_kernel("10", ValueType::INT32, condition));
+    EXPECT_NE(std::find(greater.begin(), greater.end(), 0x10000 + 200), greater.end());
+    EXPECT_EQ(std::find(greater.begin(), greater.end(), 0x10000 + 100), greater.end());
+
+    // 0xCCCCCCCC fills the rest, so ne matches everywhere but the planted values' own offsets.
+    condition.predicate = ScanPredicate::NOT_EQUAL;
+    std::vector<uintptr_t> not_equal = run(compile_kernel("10", ValueType::INT32, condition));
+    EXPECT_EQ(std::find(not_equal.begin(), not_equal.end(), 0x10000 + 100), not_equal.end());
+    EXPECT_EQ(not_equal.size(), buffer.size() - 3 - 1);
+}
+
+TEST_F(ScanKernelTest, ConditionRangeEdges) {
+    ScanCondition condition;
+    condition.predicate = ScanPredicate::LESS;
+    InRange<int32_t> below_min = condition_range<int32_t>("-2147483648", ValueType::INT32, condition);
+    EXPECT_GT(below_min.lo, below_min.hi);
+
+    condition.predicate = ScanPredicate::GREATER;
+    InRange<double> above = condition_range<double>("1.5", ValueType::FLOAT64, condition);
+    EXPECT_GT(above.lo, 1.5);
+    EXPECT_EQ(above.hi, std::numeric_limits<double>::infinity());
+
+    condition.predicate = ScanPredicate::EPSILON;
+    condition.epsilon = 0.25;
+    InRange<double> near = condition_range<double>("2", ValueType::FLOAT64, condition);
+    EXPECT_DOUBLE_EQ(near.lo, 1.75);
+    EXPECT_DOUBLE_EQ(near.hi, 2.25);
+
+    condition.predicate = ScanPredicate::ROUNDED;
+    condition.digits = 1;
+    InRange<double> rounded = condition_range<double>("2.5", ValueType::FLOAT64, condition);
+    for (double x : {2.451, 2.5, 2.549}) {
+        EXPECT_TRUE(rounded(reinterpret_cast<const uint8_t*>(&x))) << x;
+    }
+    for (double x : {2.449, 2.551, 2.6}) {
+        EXPECT_FALSE(rounded(reinterpret_cast<const uint8_t*>(&x))) << x;
+    }
+}
+
+TEST_F(ScanKernelTest, FloatToleranceScan) {
+    plant<float>(16, 99.98f);
+    plant<float>(64, 100.3f);
+
+    ScanCondition condition;
+    condition.predicate = ScanPredicate::EPSILON;
+    condition.epsilon = 0.05;
+    std::vector<uintptr_t> expected = {0x10000 + 16};
+    EXPECT_EQ(run(compile_kernel("100", ValueType::FLOAT, condition)), expected);
+
+    condition.predicate = ScanPredicate::ROUNDED;
+    condition.digits = 0;
+    expected = {0x10000 + 16, 0x10000 + 64};
+    EXPECT_EQ(run(compile_kernel("100", ValueType::FLOAT, condition)), expected);
+}
+
+TEST_F(ScanKernelTest, InvalidConditionsThrow) {
+    ScanCondition condition;
+    condition.predicate = ScanPredicate::BETWEEN;
+    EXPECT_THROW(compile_kernel("10", ValueType::INT32, condition), std::invalid_argument);
+    condition.upper = "5";
+    EXPECT_THROW(compile_kernel("10", ValueType::INT32, condition), std::invalid_argument);
+
+    condition.predicate = ScanPredicate::EPSILON;
+    EXPECT_THROW(compile_kernel("10", ValueType::INT32, condition), std::invalid_argument);
+    EXPECT_THROW(compile_kernel("nan", ValueType::FLOAT, condition), std::invalid_argument);
+    condition.epsilon = -1.0;
+    EXPECT_THROW(compile_kernel("10", ValueType::FLOAT, condition), std::invalid_argument);
+
+    condition.predicate = ScanPredicate::GREATER;
+    EXPECT_THROW(compile_kernel("text", ValueType::STRING, condition), std::invalid_argument);
+}
+
+TEST_F(ScanKernelTest, FormatValue) {
+    int32_t i = -42;
+    double d = 2.5;
+    EXPECT_EQ(format_value(reinterpret_cast<const uint8_t*>(&i), ValueType::INT32), "-42");
+    EXPECT_EQ(format_value(reinterpret_cast<const uint8_t*>(&d), ValueType::FLOAT64), "2.5");
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include "memory/scan_sessions.h"
+#include <atomic>
+#include <thread>
+
+using namespace MemoryMCP;
+
+TEST(ScanSessionsTest, CreatesOnFirstUse) {
+    ScanSessions sessions;
+    std::shared_ptr<MemoryScanner> first = sessions.get("game-1");
+    EXPECT_EQ(sessions.get("game-1"), first);
+    EXPECT_NE(sessions.get("game-2"), first);
+    EXPECT_EQ(sessions.get(""), sessions.get(ScanSessions::DEFAULT_SESSION));
+
+    std::vector<SessionInfo> infos = sessions.list();
+    ASSERT_EQ(infos.size(), 3);
+    EXPECT_EQ(infos[0].name, "default");
+    EXPECT_EQ(infos[1].name, "game-1");
+    EXPECT_EQ(infos[1].count, 0);
+    EXPECT_FALSE(infos[1].snapshot);
+}
+
+TEST(ScanSessionsTest, RejectsBadNamesAndTooManySessions) {
+    ScanSessions sessions;
+    EXPECT_THROW(sessions.get("a b"), std::invalid_argument);
+    EXPECT_THROW(sessions.get("../x/y"), std::invalid_argument);
+    EXPECT_THROW(sessions.get(std::string(ScanSessions::MAX_NAME_LENGTH + 1, 'a')), std::invalid_argument);
+
+    for (size_t i = 0; i < ScanSessions::MAX_SESSIONS; ++i) {
+        sessions.get("s" + std::to_string(i));
+    }
+    EXPECT_THROW(sessions.get("one-more"), std::invalid_argument);
+    EXPECT_TRUE(sessions.close("s0"));
+    EXPECT_NO_THROW(sessions.get("one-more"));
+}
+
+TEST(ScanSessionsTest, CloseKeepsHeldSessionsAlive) {
+    ScanSessions sessions;
+    std::shared_ptr<MemoryScanner> held = sessions.get("work");
+    EXPECT_TRUE(sessions.close("work"));
+    EXPECT_FALSE(sessions.close("work"));
+
+    // The caller's reference still works; the name now opens a fresh session.
+    EXPECT_TRUE(held->get_addresses().success);
+    EXPECT_NE(sessions.get("work"), held);
+}
+
+TEST(ScanSessionsTest, SessionsKeepSeparateResults) {
+    ScanSessions sessions;
+    std::shared_ptr<MemoryScanner> a = sessions.get("a");
+    std::shared_ptr<MemoryScanner> b = sessions.get("b");
+
+    // Resetting a replaces only a's results, so only a's cursors go stale.
+    a->reset();
+    EXPECT_FALSE(a->get_addresses(10, 0, "0:0").success);
+    EXPECT_TRUE(b->get_addresses(10, 0, "0:0").success);
+    EXPECT_EQ(a->info().generation, 1);
+    EXPECT_EQ(b->info().generation, 0);
+}
+
+TEST(ScanSessionsTest, ReadersRunAlongsideWriters) {
+    ScanSessions sessions;
+    std::shared_ptr<MemoryScanner> scanner = sessions.get("busy");
+
+    std::atomic<bool> stop{false};
+    std::thread writer([&] {
+        while (!stop) {
+            scanner->reset();
+            scanner->filter_addresses(std::vector<uint64_t>{0x1000}, "1", ValueType::INT32, false);
+        }
+    });
+    for (int i = 0; i < 2000; ++i) {
+        AddressesResponse page = scanner->get_addresses(10);
+        EXPECT_TRUE(page.success);
+        EXPECT_EQ(page.count, 0);
+    }
+    stop = true;
+    writer.join();
+}
@@ -0,0 +1,240 @@
+#include <gtest/gtest.h>
+#include "memory/simd_kernels.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <random>
+
+using namespace MemoryMCP;
+
+class SimdKernelsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::mt19937 rng(42);
+        buffer.resize(4096 + 13);
+        for (auto& byte : buffer) {
+            byte = static_cast<uint8_t>(rng());
+        }
+    }
+
+    std::vector<simd::IsaLevel> supported_levels() {
+        std::vector<simd::IsaLevel> levels;
+        for (auto level : {simd::IsaLevel::SCALAR, simd::IsaLevel::SSE2, simd::IsaLevel::AVX2, simd::IsaLevel::AVX512}) {
+            if (level <= simd::detect_isa()) {
+                levels.push_back(level);
+            }
+        }
+        return levels;
+    }
+
+    template <typename T>
+    void plant(size_t offset, T value) {
+        std::memcpy(buffer.data() + offset, &value, sizeof(value));
+    }
+
+    std::vector<uint8_t> buffer;
+};
+
+TEST_F(SimdKernelsTest, FindEqual32AllOffsets) {
+    const uint32_t target = 0xDEADBEEF;
+    std::vector<size_t> offsets = {0, 1, 2, 3, 17, 63, 64, 1001, 4090, 4096 + 13 - 4};
+    for (size_t offset : offsets) {
+        plant(offset, target);
+    }
+    size_t limit = buffer.size() - sizeof(target) + 1;
+
+    for (auto level : supported_levels()) {
+        std::vector<uintptr_t> hits;
+        simd::kernels_for(level).find_equal_32(buffer.data(), limit, 0x1000, target, hits);
+
+        // Overlapping plants can destroy earlier ones, so compare with a byte-wise reference.
+        std::vector<uintptr_t> expected;
+        for (size_t i = 0; i < limit; ++i) {
+            uint32_t current;
+            std::memcpy(&current, buffer.data() + i, sizeof(current));
+            if (current == target) expected.push_back(0x1000 + i);
+        }
+        EXPECT_EQ(hits, expected) << simd::isa_name(level);
+        EXPECT_FALSE(hits.empty());
+    }
+}
+
+TEST_F(SimdKernelsTest, FindEqual64AllOffsets) {
+    const uint64_t target = 0x0123456789ABCDEFull;
+    for (size_t offset : {0, 9, 31, 40, 100, 2047, 4096 + 13 - 8}) {
+        plant(offset, target);
+    }
+    size_t limit = buffer.size() - sizeof(target) + 1;
+
+    for (auto level : supported_levels()) {
+        std::vector<uintptr_t> hits;
+        simd::kernels_for(level).find_equal_64(buffer.data(), limit, 0, target, hits);
+
+        std::vector<uintptr_t> expected = {0, 9, 31, 40, 100, 2047, 4096 + 13 - 8};
+        EXPECT_EQ(hits, expected) << simd::isa_name(level);
+    }
+}
+
+TEST_F(SimdKernelsTest, RespectsLimit) {
+    const uint32_t target = 0x7F7F7F7F;
+    plant(100, target);
+    plant(200, target);
+
+    for (auto level : supported_levels()) {
+        std::vector<uintptr_t> hits;
+        simd::kernels_for(level).find_equal_32(buffer.data(), 200, 0, target, hits);
+        ASSERT_EQ(hits.size(), 1) << simd::isa_name(level);
+        EXPECT_EQ(hits[0], 100);
+    }
+}
+
+TEST_F(SimdKernelsTest, FloatBitPatterns) {
+    const float target = 3.5f;
+    uint32_t bits;
+    std::memcpy(&bits, &target, sizeof(bits));
+    plant(77, target);
+
+    std::vector<uintptr_t> hits;
+    simd::active_kernels().find_equal_32(buffer.data(), buffer.size() - 3, 0, bits, hits);
+    ASSERT_FALSE(hits.empty());
+    EXPECT_EQ(hits[0], 77);
+}
+
+TEST_F(SimdKernelsTest, FindRangeMatchesScalar) {
+    const size_t limit = buffer.size() - 7;
+    const auto& scalar = simd::kernels_for(simd::IsaLevel::SCALAR);
+    plant(33, std::numeric_limits<double>::quiet_NaN());
+    plant(301, std::numeric_limits<float>::quiet_NaN());
+
+    for (auto level : supported_levels()) {
+        const auto& kernels = simd::kernels_for(level);
+        for (bool negate : {false, true}) {
+            std::vector<uintptr_t> hits, expected;
+            kernels.find_range_i32(buffer.data(), limit, 0, -1000000, 50000000, negate, hits);
+            scalar.find_range_i32(buffer.data(), limit, 0, -1000000, 50000000, negate, expected);
+            EXPECT_EQ(hits, expected) << simd::isa_name(level) << " i32";
+            EXPECT_FALSE(hits.empty());
+
+            hits.clear(), expected.clear();
+            kernels.find_range_i64(buffer.data(), limit, 0, INT64_MIN / 3, INT64_MAX / 5, negate, hits);
+            scalar.find_range_i64(buffer.data(), limit, 0, INT64_MIN / 3, INT64_MAX / 5, negate, expected);
+            EXPECT_EQ(hits, expected) << simd::isa_name(level) << " i64";
+            EXPECT_FALSE(hits.empty());
+
+            hits.clear(), expected.clear();
+            kernels.find_range_f32(buffer.data(), limit, 0, -1.0f, 1e6f, negate, hits);
+            scalar.find_range_f32(buffer.data(), limit, 0, -1.0f, 1e6f, negate, expected);
+            EXPECT_EQ(hits, expected) << simd::isa_name(level) << " f32";
+
+            hits.clear(), expected.clear();
+            kernels.find_range_f64(buffer.data(), limit, 0, -1e100, 1e100, negate, hits);
+            scalar.find_range_f64(buffer.data(), limit, 0, -1e100, 1e100, negate, expected);
+            EXPECT_EQ(hits, expected) << simd::isa_name(level) << " f64";
+        }
+    }
+}
+
+TEST_F(SimdKernelsTest, AlignedKernelsMatchScalar) {
+    const size_t limit = buffer.size() - 7;
+    const auto& scalar = simd::kernels_for(simd::IsaLevel::SCALAR);
+    const uint32_t target32 = 0xDEADBEEF;
+    const uint64_t target64 = 0x0123456789ABCDEFull;
+    for (size_t offset : {0, 6, 12, 64, 1001, 2048}) {
+        plant(offset, target32);
+    }
+    for (size_t offset : {24, 101, 3005}) {
+        plant(offset, target64);
+    }
+
+    // An odd base moves the aligned lanes off the buffer's own alignment.
+    for (uintptr_t base : {uintptr_t(0x1000), uintptr_t(0x1003)}) {
+        std::vector<uintptr_t> expected32, expected64;
+        for (size_t i = 0; i < limit; ++i) {
+            if ((base + i) % 4 == 0 && std::memcmp(buffer.data() + i, &target32, 4) == 0) expected32.push_back(base + i);
+            if ((base + i) % 8 == 0 && std::memcmp(buffer.data() + i, &target64, 8) == 0) expected64.push_back(base + i);
+        }
+        ASSERT_FALSE(expected32.empty());
+        ASSERT_FALSE(expected64.empty());
+
+        for (auto level : supported_levels()) {
+            const auto& kernels = simd::kernels_for(level);
+            std::vector<uintptr_t> hits, expected;
+            kernels.find_equal_32_aligned(buffer.data(), limit, base, target32, hits);
+            EXPECT_EQ(hits, expected32) << simd::isa_name(level);
+
+            hits.clear();
+            kernels.find_equal_64_aligned(buffer.data(), limit, base, target64, hits);
+            EXPECT_EQ(hits, expected64) << simd::isa_name(level);
+
+            for (bool negate : {false, true}) {
+                hits.clear(), expected.clear();
+                kernels.find_range_i32_aligned(buffer.data(), limit, base, -1000000, 50000000, negate, hits);
+                scalar.find_range_i32(buffer.data(), limit, base, -1000000, 50000000, negate, expected);
+                expected.erase(std::remove_if(expected.begin(), expected.end(), [](uintptr_t a) { return a % 4 != 0; }),
+                               expected.end());
+                EXPECT_EQ(hits, expected) << simd::isa_name(level) << " i32";
+
+                hits.clear(), expected.clear();
+                kernels.find_range_i64_aligned(buffer.data(), limit, base, INT64_MIN / 3, INT64_MAX / 5, negate, hits);
+                scalar.find_range_i64(buffer.data(), limit, base, INT64_MIN / 3, INT64_MAX / 5, negate, expected);
+                expected.erase(std::remove_if(expected.begin(), expected.end(), [](uintptr_t a) { return a % 8 != 0; }),
+                               expected.end());
+                EXPECT_EQ(hits, expected) << simd::isa_name(level) << " i64";
+
+                hits.clear(), expected.clear();
+                kernels.find_range_f32_aligned(buffer.data(), limit, base, -1.0f, 1e6f, negate, hits);
+                scalar.find_range_f32(buffer.data(), limit, base, -1.0f, 1e6f, negate, expected);
+                expected.erase(std::remove_if(expected.begin(), expected.end(), [](uintptr_t a) { return a % 4 != 0; }),
+                               expected.end());
+                EXPECT_EQ(hits, expected) << simd::isa_name(level) << " f32";
+
+                hits.clear(), expected.clear();
+                kernels.find_range_f64_aligned(buffer.data(), limit, base, -1e100, 1e100, negate, hits);
+                scalar.find_range_f64(buffer.data(), limit, base, -1e100, 1e100, negate, expected);
+                expected.erase(std::remove_if(expected.begin(), expected.end(), [](uintptr_t a) { return a % 8 != 0; }),
+                               expected.end());
+                EXPECT_EQ(hits, expected) << simd::isa_name(level) << " f64";
+            }
+        }
+    }
+}
+
+TEST_F(SimdKernelsTest, FindRangeNaNIsNeverInside) {
+    std::fill(buffer.begin(), buffer.end(), 0);
+    plant(100, std::numeric_limits<float>::quiet_NaN());
+    const float inf = std::numeric_limits<float>::infinity();
+    size_t limit = 200;
+
+    for (auto level : supported_levels()) {
+        std::vector<uintptr_t> inside, outside;
+        simd::kernels_for(level).find_range_f32(buffer.data(), limit, 0, -inf, inf, false, inside);
+        simd::kernels_for(level).find_range_f32(buffer.data(), limit, 0, -inf, inf, true, outside);
+        EXPECT_EQ(std::count(inside.begin(), inside.end(), 100u), 0) << simd::isa_name(level);
+        EXPECT_EQ(std::count(outside.begin(), outside.end(), 100u), 1) << simd::isa_name(level);
+        EXPECT_EQ(inside.size() + outside.size(), limit);
+    }
+}
+
+TEST_F(SimdKernelsTest, FindAnchorsMatchesScalar) {
+    // A low-entropy buffer so that both anchors match often.
+    for (auto& byte : buffer) {
+        byte = static_cast<uint8_t>('a' + byte % 3);
+    }
+    std::vector<simd::NeedleAnchors> needles = {
+        {'a', 0, 'b', 0, 1, buffer.size() - 1},
+        {'a' | 0x20, 0x20, 'c', 0, 6, buffer.size() - 100},
+        {'b', 0, 'b', 0, 0, 1000},
+        {'c', 0, 'a', 0, 63, buffer.size() - 63},
+    };
+
+    std::vector<uint64_t> expected;
+    simd::kernels_for(simd::IsaLevel::SCALAR).find_anchors(buffer.data(), needles.data(), needles.size(), expected);
+    ASSERT_FALSE(expected.empty());
+    EXPECT_TRUE(std::is_sorted(expected.begin(), expected.end()));
+
+    for (auto level : supported_levels()) {
+        std::vector<uint64_t> hits;
+        simd::kernels_for(level).find_anchors(buffer.data(), needles.data(), needles.size(), hits);
+        EXPECT_EQ(hits, expected) << simd::isa_name(level);
+    }
+}
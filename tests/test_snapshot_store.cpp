@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include "memory/snapshot_store.h"
+#include "memory/page_hash.h"
+#include "fake_memory_source.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace MemoryMCP;
+
+class SnapshotStoreTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::vector<uint8_t> block(64 * 1024);
+        for (size_t i = 0; i < block.size() / 4; ++i) {
+            int32_t value = static_cast<int32_t>(i);
+            std::memcpy(block.data() + i * 4, &value, 4);
+        }
+        source.blocks.push_back(std::move(block));
+        source.blocks.push_back(std::vector<uint8_t>(4096 + 12, 0));
+        options.thread_count = 4;
+        options.chunk_size = 4096;
+    }
+
+    int32_t& slot(size_t block, size_t index) {
+        return *reinterpret_cast<int32_t*>(source.blocks[block].data() + index * 4);
+    }
+
+    uint64_t address(size_t block, size_t index) {
+        return reinterpret_cast<uintptr_t>(source.blocks[block].data()) + index * 4;
+    }
+
+    FakeMemorySource source;
+    ScanOptions options;
+};
+
+TEST_F(SnapshotStoreTest, MappedFileIsZeroFilled) {
+    MappedFile file = MappedFile::create_temporary(1 << 20);
+    ASSERT_NE(file.data(), nullptr);
+    EXPECT_EQ(file.size(), 1u << 20);
+    EXPECT_EQ(file.data()[12345], 0);
+    file.data()[12345] = 7;
+
+    MappedFile moved = std::move(file);
+    EXPECT_EQ(moved.data()[12345], 7);
+    EXPECT_EQ(file.data(), nullptr);
+}
+
+TEST_F(SnapshotStoreTest, CaptureMarksEveryAlignedSlot) {
+    SnapshotStore snapshot(ValueType::INT32, source.enumerate_regions());
+    snapshot.capture(source, options);
+
+    EXPECT_EQ(snapshot.candidate_count(), (64 * 1024 + 4096 + 12) / 4);
+    EXPECT_EQ(snapshot.regions().size(), 2);
+}
+
+TEST_F(SnapshotStoreTest, CompareNarrowsCandidates) {
+    SnapshotStore snapshot(ValueType::INT32, source.enumerate_regions());
+    snapshot.capture(source, options);
+
+    slot(0, 10) += 5;
+    slot(0, 5000) -= 3;
+    slot(0, 16383) += 1;
+    slot(1, 1026) = 99;
+
+    snapshot.compare(source, options, CompareOp::CHANGED, "");
+    EXPECT_EQ(snapshot.candidate_count(), 4);
+
+    slot(0, 10) += 5;
+    slot(0, 5000) += 5;
+    slot(1, 1026) += 2;
+    snapshot.compare(source, options, CompareOp::INCREASED_BY, "5");
+
+    ResultSet results = snapshot.materialize();
+    ASSERT_EQ(results.size(), 2);
+    std::vector<uint64_t> expected = {address(0, 10), address(0, 5000)};
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(results.address(0), expected[0]);
+    EXPECT_EQ(results.address(1), expected[1]);
+
+    int32_t value;
+    std::memcpy(&value, results.value(results.find(address(0, 10))), 4);
+    EXPECT_EQ(value, 20);
+}
+
+TEST_F(SnapshotStoreTest, UnchangedAndDecreased) {
+    SnapshotStore snapshot(ValueType::INT32, source.enumerate_regions());
+    snapshot.capture(source, options);
+
+    slot(0, 7) -= 1;
+    slot(0, 8) += 1;
+    snapshot.compare(source, options, CompareOp::UNCHANGED, "");
+    EXPECT_EQ(snapshot.candidate_count(), (64 * 1024 + 4096 + 12) / 4 - 2);
+
+    slot(0, 9) -= 100;
+    snapshot.compare(source, options, CompareOp::DECREASED, "");
+    ASSERT_EQ(snapshot.candidate_count(), 1);
+
+    std::vector<uint64_t> seen;
+    snapshot.for_each_candidate(10, [&](uint64_t address, const uint8_t*) { seen.push_back(address); });
+    EXPECT_EQ(seen, std::vector<uint64_t>{address(0, 9)});
+}
+
+TEST_F(SnapshotStoreTest, ForEachCandidateFromOffset) {
+    SnapshotStore snapshot(ValueType::INT32, source.enumerate_regions());
+    snapshot.capture(source, options);
+    slot(0, 100) += 1;
+    slot(0, 7000) += 1;
+    slot(1, 3) += 1;
+    slot(1, 1000) += 1;
+    snapshot.compare(source, options, CompareOp::CHANGED, "");
+
+    std::vector<uint64_t> all;
+    snapshot.for_each_candidate(10, [&](uint64_t address, const uint8_t*) { all.push_back(address); });
+    ASSERT_EQ(all.size(), 4);
+
+    for (size_t offset = 0; offset <= all.size(); ++offset) {
+        std::vector<uint64_t> page;
+        snapshot.for_each_candidate(offset, 2, [&](uint64_t address, const uint8_t*) { page.push_back(address); });
+        std::vector<uint64_t> expected(all.begin() + offset, all.begin() + (std::min)(offset + 2, all.size()));
+        EXPECT_EQ(page, expected) << "offset " << offset;
+    }
+}
+
+TEST_F(SnapshotStoreTest, RejectsStringsAndBadOperands) {
+    EXPECT_THROW(SnapshotStore(ValueType::STRING, source.enumerate_regions()), std::invalid_argument);
+
+    SnapshotStore snapshot(ValueType::INT32, source.enumerate_regions());
+    snapshot.capture(source, options);
+    EXPECT_THROW(snapshot.compare(source, options, CompareOp::INCREASED_BY, "abc"), std::invalid_argument);
+}
+
+TEST_F(SnapshotStoreTest, PageHashDetectsSingleByteChanges) {
+    std::vector<uint8_t> page(SNAPSHOT_PAGE_SIZE, 0);
+    uint64_t zero = hash_page(page.data(), page.size());
+    EXPECT_NE(zero, 0u);
+    EXPECT_EQ(zero, hash_page(page.data(), page.size()));
+
+    for (size_t i : {0, 1, 31, 32, 2047, 4095}) {
+        page[i] = 1;
+        EXPECT_NE(hash_page(page.data(), page.size()), zero) << i;
+        page[i] = 0;
+    }
+}
+
+TEST_F(SnapshotStoreTest, UnchangedPagesAreNotDiffed) {
+    SnapshotStore snapshot(ValueType::INT32, source.enumerate_regions());
+    snapshot.capture(source, options);
+
+    // One page of the 64 KiB block changes; its other 15 pages and the full
+    // page of the second block hash the same. The trailing partial page has
+    // no hash and is always diffed.
+    slot(0, 3000) += 1;
+    ScanStats stats = snapshot.compare(source, options, CompareOp::UNCHANGED, "");
+    EXPECT_EQ(stats.pages_compared, 2);
+    EXPECT_EQ(stats.pages_unchanged, 16);
+    EXPECT_EQ(snapshot.candidate_count(), (64 * 1024 + 4096 + 12) / 4 - 1);
+
+    slot(1, 0) += 1;
+    stats = snapshot.compare(source, options, CompareOp::CHANGED, "");
+    EXPECT_EQ(snapshot.candidate_count(), 1);
+    EXPECT_EQ(stats.pages_unchanged, 16);
+
+    // The first block has no candidates left and is not read at all; the
+    // partial page of the second block has none either.
+    stats = snapshot.compare(source, options, CompareOp::CHANGED, "");
+    EXPECT_EQ(stats.pages_skipped, 1);
+    EXPECT_EQ(stats.pages_compared + stats.pages_unchanged, 1);
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "server/tool_registry.h"
+
+using namespace MemoryMCP;
+
+namespace {
+
+json request(const json& id, const std::string& method, const json& params = json::object()) {
+    return {{"jsonrpc", "2.0"}, {"id", id}, {"method", method}, {"params", params}};
+}
+
+} // namespace
+
+TEST(ToolRegistryTest, FindsEveryListedTool) {
+    ScanSessions sessions;
+    ToolRegistry registry(sessions);
+
+    json tools = json::parse(registry.tools_list_result())["tools"];
+    ASSERT_EQ(tools.size(), 9);
+    for (const json& tool : tools) {
+        std::string name = tool["name"];
+        const ToolRegistry::Tool* entry = ToolRegistry::find(name);
+        ASSERT_NE(entry, nullptr) << name;
+        EXPECT_EQ(entry->name, name);
+        EXPECT_EQ(entry->replaces_results, name != "get_addresses" && name != "list_sessions") << name;
+        EXPECT_EQ(tool["inputSchema"]["properties"].contains("session"), name != "list_sessions") << name;
+    }
+
+    EXPECT_EQ(ToolRegistry::find(""), nullptr);
+    EXPECT_EQ(ToolRegistry::find("scan_memor"), nullptr);
+    EXPECT_EQ(ToolRegistry::find("scan_memoryy"), nullptr);
+    EXPECT_EQ(ToolRegistry::find("no_such_tool"), nullptr);
+}
+
+TEST(ToolRegistryTest, AnswersWithPreSerializedResults) {
+    ScanSessions sessions;
+    ToolRegistry registry(sessions);
+
+    json init = json::parse(registry.answer(request(1, "initialize")));
+    EXPECT_EQ(init["jsonrpc"], "2.0");
+    EXPECT_EQ(init["id"], 1);
+    EXPECT_EQ(init["result"]["protocolVersion"], "2024-11-05");
+    EXPECT_EQ(init["result"]["serverInfo"]["name"], "memory-mcp-server");
+
+    json list = json::parse(registry.answer(request("a\"b", "tools/list")));
+    EXPECT_EQ(list["id"], "a\"b");
+    EXPECT_EQ(list["result"], json::parse(registry.tools_list_result()));
+
+    json unknown = json::parse(registry.answer(request(2, "no/such/method")));
+    EXPECT_EQ(unknown["error"]["code"], -32601);
+}
+
+TEST(ToolRegistryTest, CallsTools) {
+    ScanSessions sessions;
+    ToolRegistry registry(sessions);
+
+    json reset = json::parse(registry.call(request(3, "tools/call", {{"name", "reset_memory_scanner"}})));
+    EXPECT_EQ(reset["id"], 3);
+    EXPECT_FALSE(reset["result"]["isError"]);
+
+    // Arguments may be omitted when every one has a default.
+    json page = json::parse(registry.answer(request(4, "tools/call", {{"name", "get_addresses"}})));
+    EXPECT_EQ(page["result"]["content"][0]["type"], "text");
+
+    json cbor = json::parse(registry.call(request(8, "tools/call", {{"name", "get_addresses"}, {"arguments", {{"encoding", "cbor"}}}})));
+    ASSERT_EQ(cbor["result"]["content"].size(), 2);
+    EXPECT_EQ(cbor["result"]["content"][1]["resource"]["mimeType"], "application/cbor");
+    EXPECT_FALSE(cbor["result"]["content"][1]["resource"]["blob"].get<std::string>().empty());
+
+    json bad = json::parse(registry.call(request(9, "tools/call", {{"name", "get_addresses"}, {"arguments", {{"encoding", "xml"}}}})));
+    EXPECT_TRUE(bad["result"]["isError"]);
+
+    json unknown = json::parse(registry.call(request(5, "tools/call", {{"name", "no_such_tool"}})));
+    EXPECT_EQ(unknown["error"]["code"], -32601);
+
+    // Without addresses or addresses_packed every stored result is re-checked.
+    json filtered = json::parse(registry.call(request(10, "tools/call", {{"name", "filter_addresses"},
+        {"arguments", {{"new_value", "1"}, {"value_type", "int32"}}}})));
+    EXPECT_FALSE(filtered["result"]["isError"]);
+    filtered = json::parse(registry.call(request(11, "tools/call", {{"name", "filter_addresses"},
+        {"arguments", {{"addresses", json::array()}, {"new_value", "1"}, {"value_type", "int32"}}}})));
+    EXPECT_NE(filtered["result"]["content"][0]["text"].get<std::string>().find("Remaining: 0"), std::string::npos);
+    EXPECT_ANY_THROW(registry.call(request(12, "tools/call", {{"name", "filter_addresses"},
+        {"arguments", {{"addresses", "0x1"}, {"new_value", "1"}, {"value_type", "int32"}}}})));
+
+    EXPECT_ANY_THROW(registry.call(request(6, "tools/call", {{"name", "scan_memory"}, {"arguments", json::object()}})));
+    EXPECT_ANY_THROW(registry.call(request(7, "tools/call")));
+}
+
+TEST(ToolRegistryTest, ToolsWorkOnNamedSessions) {
+    ScanSessions sessions;
+    ToolRegistry registry(sessions);
+
+    json reset = json::parse(registry.call(request(1, "tools/call", {{"name", "reset_memory_scanner"}, {"arguments", {{"session", "alpha"}}}})));
+    EXPECT_FALSE(reset["result"]["isError"]);
+    registry.call(request(2, "tools/call", {{"name", "get_addresses"}}));
+
+    json list = json::parse(registry.call(request(3, "tools/call", {{"name", "list_sessions"}})));
+    std::string text = list["result"]["content"][0]["text"];
+    EXPECT_NE(text.find("alpha:"), std::string::npos);
+    EXPECT_NE(text.find("default:"), std::string::npos);
+
+    json closed = json::parse(registry.call(request(4, "tools/call", {{"name", "close_session"}, {"arguments", {{"session", "alpha"}}}})));
+    EXPECT_FALSE(closed["result"]["isError"]);
+    closed = json::parse(registry.call(request(5, "tools/call", {{"name", "close_session"}, {"arguments", {{"session", "alpha"}}}})));
+    EXPECT_TRUE(closed["result"]["isError"]);
+
+    EXPECT_ANY_THROW(registry.call(request(6, "tools/call", {{"name", "get_addresses"}, {"arguments", {{"session", "no spaces"}}}})));
+}
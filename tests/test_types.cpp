@@ -81,7 +81,59 @@ TEST_F(TypesTest, ValueTypeConversion) {
 }
 
 TEST_F(TypesTest, Constants) {
-    EXPECT_EQ(MAX_REGIONS, 1000);
-    EXPECT_EQ(MAX_REGION_SIZE, 1024 * 1024);
     EXPECT_EQ(BUFFER_SIZE, 4096);
 }
+
+TEST_F(TypesTest, RegionFilterFromJson) {
+    RegionFilter filter = region_filter_from_json(json{{"process_name", "game"}});
+    EXPECT_FALSE(filter.writable);
+    EXPECT_TRUE(filter.modules.empty());
+    EXPECT_EQ(filter.start, 0);
+    EXPECT_EQ(filter.end, UINT64_MAX);
+
+    filter = region_filter_from_json(json::parse(R"({"regions": {"writable": true, "skip_image": true,
+        "modules": ["game.exe"], "start": "0x10000", "end": 1048576, "min_size": 4096}})"));
+    EXPECT_TRUE(filter.writable);
+    EXPECT_TRUE(filter.skip_image);
+    EXPECT_FALSE(filter.executable);
+    EXPECT_EQ(filter.modules, std::vector<std::string>{"game.exe"});
+    EXPECT_EQ(filter.start, 0x10000);
+    EXPECT_EQ(filter.end, 0x100000);
+    EXPECT_EQ(filter.min_size, 4096);
+    EXPECT_EQ(filter.max_size, 0);
+
+    EXPECT_THROW(region_filter_from_json(json::parse(R"({"regions": {"start": "0x20", "end": "0x10"}})")), std::invalid_argument);
+    EXPECT_THROW(region_filter_from_json(json::parse(R"({"regions": {"start": "zz"}})")), std::invalid_argument);
+    EXPECT_THROW(region_filter_from_json(json::parse(R"({"regions": {"start": -1}})")), std::invalid_argument);
+    EXPECT_THROW(region_filter_from_json(json::parse(R"({"regions": true})")), std::invalid_argument);
+}
+
+TEST_F(TypesTest, ScanConditionPredicateDefaults) {
+    json j = {{"process_name", "game"}, {"value", "100"}, {"value_type", "int32"}};
+    ScanCondition condition = scan_condition_from_json(j);
+    EXPECT_EQ(condition.predicate, ScanPredicate::EQUAL);
+    EXPECT_TRUE(condition.upper.empty());
+
+    j["predicate"] = "between";
+    j["upper"] = "200";
+    condition = scan_condition_from_json(j);
+    EXPECT_EQ(condition.predicate, ScanPredicate::BETWEEN);
+    EXPECT_EQ(condition.upper, "200");
+
+    j["predicate"] = "lte";
+    EXPECT_THROW(scan_condition_from_json(j), std::invalid_argument);
+}
+
+TEST_F(TypesTest, ScanConditionAlignment) {
+    json j = {{"value", "100"}};
+    EXPECT_EQ(scan_condition_from_json(j).alignment, 0);
+    j["alignment"] = "natural";
+    EXPECT_EQ(scan_condition_from_json(j).alignment, 0);
+    j["alignment"] = 2;
+    EXPECT_EQ(scan_condition_from_json(j).alignment, 2);
+
+    for (json bad : {json(3), json(16), json(-4), json("4"), json(true)}) {
+        j["alignment"] = bad;
+        EXPECT_THROW(scan_condition_from_json(j), std::invalid_argument) << bad.dump();
+    }
+}